@@ -0,0 +1,178 @@
+/**
+ * Small helpers shared by the benchmark programs: a wall clock timer and
+ * synthetic graph generators. Every generator is deterministic for a given
+ * seed so that runs can be compared with each other.
+ */
+#ifndef DRAGON_BENCHMARKS_BENCHMARK_HPP
+#define DRAGON_BENCHMARKS_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+namespace bench {
+
+class Timer {
+public:
+  using ClockType = std::chrono::steady_clock;
+
+  Timer() : m_start(ClockType::now()) {}
+
+  void reset() { m_start = ClockType::now(); }
+
+  /// Returns seconds elapsed since construction or the last `reset()`.
+  double seconds() const {
+    return std::chrono::duration<double>(ClockType::now() - m_start).count();
+  }
+
+private:
+  ClockType::time_point m_start;
+};
+
+/**
+ * Runs `fn` `repetitions` times and returns the fastest run in seconds.
+ */
+template <typename FunctionT>
+double measure(FunctionT fn, unsigned repetitions = 3) {
+  double best = std::numeric_limits<double>::max();
+  for (auto i = 0U; i < repetitions; ++i) {
+    Timer timer;
+    fn();
+    best = std::min(best, timer.seconds());
+  }
+  return best;
+}
+
+template <typename EdgeValueT> struct Edge {
+  std::size_t from;
+  std::size_t to;
+  EdgeValueT weight;
+};
+
+template <typename EdgeValueT>
+using EdgeList = std::vector<Edge<EdgeValueT>>;
+
+/**
+ * Returns `num_of_edges` directed edges with uniformly random endpoints and
+ * weights in `[1, max_weight]`.
+ */
+template <typename EdgeValueT = int>
+EdgeList<EdgeValueT> random_graph(std::size_t sz, std::size_t num_of_edges,
+                                  EdgeValueT max_weight = 100,
+                                  std::uint32_t seed = 42) {
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<std::size_t> node(0, sz - 1);
+  std::uniform_int_distribution<long long> weight(
+      1, static_cast<long long>(max_weight));
+  EdgeList<EdgeValueT> edges;
+  edges.reserve(num_of_edges);
+  for (std::size_t i = 0; i < num_of_edges; ++i) {
+    edges.push_back(
+        {node(rng), node(rng), static_cast<EdgeValueT>(weight(rng))});
+  }
+  return edges;
+}
+
+/**
+ * Road-like graph: a `rows` x `cols` grid where every node is linked in both
+ * directions to its right and lower neighbours, with weights in
+ * `[1, max_weight]`. Large diameter, bounded degree.
+ */
+template <typename EdgeValueT = int>
+EdgeList<EdgeValueT> grid_graph(std::size_t rows, std::size_t cols,
+                                EdgeValueT max_weight = 100,
+                                std::uint32_t seed = 42) {
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<long long> weight(
+      1, static_cast<long long>(max_weight));
+  EdgeList<EdgeValueT> edges;
+  edges.reserve(4 * rows * cols);
+  auto link = [&](std::size_t u, std::size_t v) {
+    auto w = static_cast<EdgeValueT>(weight(rng));
+    edges.push_back({u, v, w});
+    edges.push_back({v, u, w});
+  };
+  for (std::size_t r = 0; r < rows; ++r) {
+    for (std::size_t c = 0; c < cols; ++c) {
+      std::size_t u = r * cols + c;
+      if (c + 1 < cols)
+        link(u, u + 1);
+      if (r + 1 < rows)
+        link(u, u + cols);
+    }
+  }
+  return edges;
+}
+
+/**
+ * Power-law graph generated with the R-MAT recursive matrix model on
+ * `2^scale` nodes with `edge_factor * 2^scale` directed edges and weights in
+ * `[1, max_weight]`. Small diameter, heavily skewed degrees.
+ */
+template <typename EdgeValueT = int>
+EdgeList<EdgeValueT> rmat_graph(unsigned scale, std::size_t edge_factor = 16,
+                                EdgeValueT max_weight = 100,
+                                std::uint32_t seed = 42) {
+  const double a = 0.57, b = 0.19, c = 0.19;
+  const std::size_t sz = std::size_t(1) << scale;
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> coin(0.0, 1.0);
+  std::uniform_int_distribution<long long> weight(
+      1, static_cast<long long>(max_weight));
+  EdgeList<EdgeValueT> edges;
+  edges.reserve(edge_factor * sz);
+  for (std::size_t i = 0; i < edge_factor * sz; ++i) {
+    std::size_t u = 0, v = 0;
+    for (unsigned bit = 0; bit < scale; ++bit) {
+      double p = coin(rng);
+      u <<= 1;
+      v <<= 1;
+      if (p < a) {
+      } else if (p < a + b) {
+        v |= 1;
+      } else if (p < a + b + c) {
+        u |= 1;
+      } else {
+        u |= 1;
+        v |= 1;
+      }
+    }
+    edges.push_back({u, v, static_cast<EdgeValueT>(weight(rng))});
+  }
+  return edges;
+}
+
+/// Builds a map-backed `dragon::Graph` from an edge list.
+template <typename EdgeValueT>
+Graph<int, EdgeValueT> make_graph(std::size_t sz,
+                                  const EdgeList<EdgeValueT>& edges) {
+  Graph<int, EdgeValueT> graph(sz);
+  for (const auto& edge : edges) {
+    graph.add_directed_edge(edge.from, edge.to, edge.weight);
+  }
+  return graph;
+}
+
+/// Builds a `dragon::CSRGraph` from an edge list.
+template <typename EdgeValueT>
+CSRGraph<int, EdgeValueT> make_csr_graph(std::size_t sz,
+                                         const EdgeList<EdgeValueT>& edges) {
+  using CSRGraphType = CSRGraph<int, EdgeValueT>;
+  std::vector<typename CSRGraphType::Edge> csr_edges;
+  csr_edges.reserve(edges.size());
+  for (const auto& edge : edges) {
+    csr_edges.push_back({edge.from, edge.to, edge.weight});
+  }
+  return CSRGraphType(sz, csr_edges);
+}
+
+} // namespace bench
+} // namespace dragon
+
+#endif
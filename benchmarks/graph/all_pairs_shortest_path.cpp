@@ -0,0 +1,64 @@
+/**
+ * `dragon::johnson` over 1..N threads against one `spfa` run per source, on
+ * a road-like grid graph and on a random graph, both with negative edge
+ * weights and no negative cycle.
+ *
+ * usage: benchmark-all_pairs_shortest_path [max_threads] [grid_side] [nodes]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include "benchmark.hpp"
+#include "dragon/graph/all_pairs_shortest_path.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+void compare(const std::string& name, std::size_t sz,
+             dragon::bench::EdgeList<long long> edges,
+             std::size_t max_threads) {
+  // Shifting weights by node potentials adds negative edges but keeps every
+  // cycle non-negative.
+  std::mt19937_64 rng(7);
+  std::vector<long long> height(sz);
+  for (auto& h : height) {
+    h = static_cast<long long>(rng() % 200);
+  }
+  for (auto& edge : edges) {
+    edge.weight += height[edge.to] - height[edge.from];
+  }
+  auto graph = dragon::bench::make_csr_graph(sz, edges);
+  std::printf("%s: nodes: %zu, edges: %zu\n", name.c_str(), graph.size(),
+              graph.num_edges());
+
+  std::vector<long long> expected(sz * sz), distances;
+  double sequential = dragon::bench::measure(
+      [&] {
+        std::vector<long long> dist;
+        for (std::size_t u_i = 0; u_i < sz; ++u_i) {
+          dragon::spfa(graph, dist, u_i);
+          std::copy(dist.begin(), dist.end(), expected.begin() + u_i * sz);
+        }
+      },
+      1);
+  std::printf("  spfa per source %8.3f s\n", sequential);
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    dragon::ThreadPool pool(threads);
+    double seconds = dragon::bench::measure(
+        [&] { dragon::johnson(graph, distances, pool); }, 1);
+    std::printf("  johnson x%-3zu    %8.3f s  speedup %5.2f%s\n", threads,
+                seconds, sequential / seconds,
+                distances == expected ? "" : "  (MISMATCH)");
+  }
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10)
+                                     : dragon::ThreadPool::default_size();
+  std::size_t side = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 50;
+  std::size_t sz = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 2500;
+
+  compare("road-like grid", side * side,
+          dragon::bench::grid_graph<long long>(side, side), max_threads);
+  compare("random", sz, dragon::bench::random_graph<long long>(sz, 8 * sz),
+          max_threads);
+}
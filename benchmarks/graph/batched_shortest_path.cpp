@@ -0,0 +1,67 @@
+/**
+ * Scaling of `dragon::batched_djikstra` over 1..N threads against a loop of
+ * `djikstra` calls, one per source, on a road-like grid graph and on an R-MAT
+ * power-law graph.
+ *
+ * usage: benchmark-batched_shortest_path [max_threads] [num_of_sources]
+ *        [grid_side] [rmat_scale]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "benchmark.hpp"
+#include "dragon/graph/batched_shortest_path.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+template <typename GraphT>
+void scale(const std::string& name, const GraphT& graph,
+           std::size_t num_of_sources, std::size_t max_threads) {
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  std::printf("%s: nodes: %zu, edges: %zu, sources: %zu\n", name.c_str(),
+              graph.size(), graph.num_edges(), num_of_sources);
+  std::vector<std::size_t> sources(num_of_sources);
+  for (std::size_t i = 0; i < num_of_sources; ++i) {
+    sources[i] = i * graph.size() / num_of_sources;
+  }
+  std::vector<EdgeValueType> expected(num_of_sources * graph.size());
+  std::vector<EdgeValueType> matrix(expected.size());
+  double sequential = dragon::bench::measure(
+      [&] {
+        for (std::size_t i = 0; i < num_of_sources; ++i) {
+          auto dist = dragon::djikstra(graph, sources[i]);
+          std::copy(dist.begin(), dist.end(),
+                    expected.begin() + i * graph.size());
+        }
+      },
+      1);
+  std::printf("  djikstra loop        %8.3f s\n", sequential);
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    dragon::ThreadPool pool(threads);
+    double seconds = dragon::bench::measure(
+        [&] {
+          dragon::batched_djikstra(graph, sources, matrix.data(), pool);
+        },
+        1);
+    std::printf("  batched_djikstra x%-3zu %8.3f s  speedup %5.2f%s\n",
+                threads, seconds, sequential / seconds,
+                matrix == expected ? "" : "  (MISMATCH)");
+  }
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10)
+                                     : dragon::ThreadPool::default_size();
+  std::size_t num_of_sources =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 256;
+  std::size_t side = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 300;
+  unsigned rmat_scale =
+      argc > 4 ? static_cast<unsigned>(std::strtoul(argv[4], nullptr, 10)) : 16;
+
+  auto road = dragon::bench::make_csr_graph(
+      side * side, dragon::bench::grid_graph<int>(side, side));
+  scale("road-like grid", road, num_of_sources, max_threads);
+
+  auto power_law = dragon::bench::make_csr_graph(
+      std::size_t(1) << rmat_scale, dragon::bench::rmat_graph<int>(rmat_scale));
+  scale("power-law R-MAT", power_law, num_of_sources, max_threads);
+}
@@ -0,0 +1,92 @@
+/**
+ * Direction optimizing `dragon::BreadthFirstSearch` over 1..N threads on an
+ * R-MAT power-law graph, against a serial top-down queue BFS and against
+ * `djikstra` with unit weights.
+ *
+ * usage: benchmark-bfs [max_threads] [rmat_scale] [num_of_sources]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include "benchmark.hpp"
+#include "dragon/graph/bfs.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+using GraphType = dragon::CSRGraph<int, int>;
+
+std::vector<std::size_t> queue_bfs(const GraphType& graph,
+                                   std::size_t source) {
+  const auto npos = GraphType::npos;
+  std::vector<std::size_t> depth(graph.size(), npos);
+  std::queue<std::size_t> queue;
+  depth[source] = 0;
+  queue.push(source);
+  while (!queue.empty()) {
+    auto u_i = queue.front();
+    queue.pop();
+    for (auto edge : graph[u_i].edges) {
+      if (depth[edge.first] == npos) {
+        depth[edge.first] = depth[u_i] + 1;
+        queue.push(edge.first);
+      }
+    }
+  }
+  return depth;
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10)
+                                     : dragon::ThreadPool::default_size();
+  unsigned rmat_scale =
+      argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 20;
+  std::size_t num_of_sources =
+      argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 8;
+
+  // Unit weights, both directions: BFS results match `djikstra` hop counts.
+  auto edges = dragon::bench::rmat_graph<int>(rmat_scale, 16, 1);
+  const std::size_t sz = std::size_t(1) << rmat_scale;
+  for (std::size_t i = 0, m = edges.size(); i < m; ++i) {
+    edges.push_back({edges[i].to, edges[i].from, 1});
+  }
+  auto graph = dragon::bench::make_csr_graph(sz, edges);
+  std::printf("power-law R-MAT: nodes: %zu, edges: %zu, sources: %zu\n", sz,
+              graph.num_edges(), num_of_sources);
+
+  // Low R-MAT indices have the most edges and lie in the giant component.
+  std::vector<std::size_t> sources;
+  for (std::size_t i = 0; i < num_of_sources; ++i) {
+    sources.push_back(i);
+  }
+
+  std::vector<std::vector<std::size_t>> expected(num_of_sources);
+  double serial = dragon::bench::measure([&] {
+    for (std::size_t i = 0; i < num_of_sources; ++i) {
+      expected[i] = queue_bfs(graph, sources[i]);
+    }
+  });
+  std::printf("  queue bfs           %8.3f s\n", serial);
+  double unit = dragon::bench::measure(
+      [&] {
+        for (auto source : sources) {
+          dragon::djikstra(graph, source);
+        }
+      },
+      1);
+  std::printf("  unit djikstra       %8.3f s\n", unit);
+
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    dragon::ThreadPool pool(threads);
+    dragon::BreadthFirstSearch<GraphType> search(graph, pool);
+    bool match = true;
+    double seconds = dragon::bench::measure([&] {
+      for (std::size_t i = 0; i < num_of_sources; ++i) {
+        search.run(sources[i]);
+        for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+          match = match && search.depth(v_i) == expected[i][v_i];
+        }
+      }
+    });
+    std::printf("  direction opt. x%-3zu %8.3f s  speedup %5.2f%s\n", threads,
+                seconds, serial / seconds, match ? "" : "  (MISMATCH)");
+  }
+}
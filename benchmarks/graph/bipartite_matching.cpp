@@ -0,0 +1,54 @@
+/**
+ * `hopcroft_karp` against maximum flow on the equivalent unit capacity
+ * network (`FlowNetwork::dinic` and `FlowNetwork::push_relabel`), on random
+ * bipartite graphs with the same number of nodes on each side.
+ *
+ * usage: benchmark-bipartite_matching [nodes_per_side] [edges_per_node]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+#include "benchmark.hpp"
+#include "dragon/graph/bipartite_matching.hpp"
+#include "dragon/graph/max_flow.hpp"
+
+int main(int argc, char* argv[]) {
+  std::size_t sz = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::size_t degree = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 3;
+  std::mt19937_64 rng(42);
+  std::vector<std::pair<std::size_t, std::size_t>> edges;
+  edges.reserve(sz * degree);
+  for (std::size_t l = 0; l < sz; ++l) {
+    for (std::size_t k = 0; k < degree; ++k) {
+      edges.emplace_back(l, rng() % sz);
+    }
+  }
+  std::printf("nodes per side: %zu, edges: %zu\n", sz, edges.size());
+
+  std::vector<std::size_t> left_mate, right_mate;
+  std::size_t matched = 0;
+  double hopcroft_karp = dragon::bench::measure([&] {
+    matched = dragon::hopcroft_karp(sz, sz, edges, left_mate, right_mate);
+  });
+  std::printf("  hopcroft_karp %8.3f s  matched %zu\n", hopcroft_karp,
+              matched);
+
+  const std::size_t source = 2 * sz, sink = 2 * sz + 1;
+  dragon::FlowNetwork<int> network(2 * sz + 2);
+  for (const auto& edge : edges) {
+    network.add_edge(edge.first, sz + edge.second, 1);
+  }
+  for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+    network.add_edge(source, v_i, 1);
+    network.add_edge(sz + v_i, sink, 1);
+  }
+  int value = 0;
+  double dinic =
+      dragon::bench::measure([&] { value = network.dinic(source, sink); });
+  std::printf("  dinic         %8.3f s  matched %d\n", dinic, value);
+  double push_relabel = dragon::bench::measure(
+      [&] { value = network.push_relabel(source, sink); });
+  std::printf("  push_relabel  %8.3f s  matched %d\n", push_relabel, value);
+}
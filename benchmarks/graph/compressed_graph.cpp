@@ -0,0 +1,101 @@
+/**
+ * Compares the varint compressed `dragon::CompressedGraph` against
+ * `dragon::CSRGraph` on an undirected R-MAT power-law graph, with random
+ * labels and after a breadth first relabeling: bytes per edge, decode
+ * throughput of a scan over every edge, `dragon::bfs` and `dragon::djikstra`.
+ *
+ * usage: benchmark-compressed_graph [rmat_scale] [edge_factor]
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "benchmark.hpp"
+#include "dragon/graph/bfs.hpp"
+#include "dragon/graph/compressed_graph.hpp"
+#include "dragon/graph/reordering.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+template <typename GraphT> long long sum_of_edges(const GraphT& graph) {
+  long long sum = 0;
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      sum += edge.first + edge.second;
+    }
+  }
+  return sum;
+}
+
+template <typename GraphT>
+void run(const char* name, const GraphT& graph, std::size_t source,
+         double bytes, long long expected_sum,
+         const std::vector<int>& expected_dist) {
+  const double num = static_cast<double>(graph.num_edges());
+  long long sum = 0;
+  double scan = dragon::bench::measure([&] { sum = sum_of_edges(graph); });
+  std::vector<std::size_t> parent;
+  double bfs = dragon::bench::measure(
+      [&] { dragon::bfs(graph, parent, source); }, 1);
+  std::vector<int> dist;
+  double sssp = dragon::bench::measure(
+      [&] { dist = dragon::djikstra(graph, source); }, 1);
+  if (sum != expected_sum || dist != expected_dist) {
+    std::printf("mismatch for %s\n", name);
+    std::exit(1);
+  }
+  std::printf("%-22s %6.2f B/edge  scan %7.1f Medges/s %6.2f GB/s  "
+              "bfs %6.3f s  djikstra %6.3f s\n",
+              name, bytes / num, num / scan / 1e6, bytes / scan / 1e9, bfs,
+              sssp);
+}
+
+int main(int argc, char* argv[]) {
+  unsigned scale =
+      argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 20;
+  std::size_t edge_factor =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+  const std::size_t sz = std::size_t(1) << scale;
+
+  auto edges = dragon::bench::rmat_graph<int>(scale, edge_factor);
+  std::vector<std::size_t> label(sz);
+  for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+    label[v_i] = v_i;
+  }
+  std::shuffle(label.begin(), label.end(), std::mt19937(7));
+  const std::size_t num_of_edges = edges.size();
+  for (std::size_t i = 0; i < num_of_edges; ++i) {
+    auto edge = edges[i];
+    edge.from = label[edge.from];
+    edge.to = label[edge.to];
+    edges[i] = edge;
+    std::swap(edge.from, edge.to);
+    edges.push_back(edge);
+  }
+  auto shuffled = dragon::bench::make_csr_graph(sz, edges);
+  std::vector<std::size_t> new_index, old_index;
+  auto ordered =
+      dragon::reorder(shuffled, dragon::VertexOrder::bfs, new_index, old_index);
+  std::printf("nodes: %zu, edges: %zu\n", sz, shuffled.num_edges());
+
+  for (const auto* graph : {&shuffled, &ordered}) {
+    dragon::bench::Timer timer;
+    dragon::CompressedGraph<int, int> compressed(*graph);
+    double build = timer.seconds();
+    std::printf("%s labels, compressed in %.3f s\n",
+                graph == &shuffled ? "random" : "bfs", build);
+
+    const double csr_bytes =
+        graph->offsets().size() * sizeof(std::size_t) +
+        graph->num_edges() * (sizeof(std::size_t) + sizeof(int));
+    const double compressed_bytes =
+        compressed.num_bytes() + (sz + 1) * sizeof(std::size_t);
+    // Searches start from the R-MAT hub, node 0 before relabeling.
+    const std::size_t source =
+        graph == &shuffled ? label[0] : new_index[label[0]];
+    long long sum = sum_of_edges(*graph);
+    auto dist = dragon::djikstra(*graph, source);
+    run("  CSRGraph", *graph, source, csr_bytes, sum, dist);
+    run("  CompressedGraph", compressed, source, compressed_bytes, sum, dist);
+  }
+}
@@ -0,0 +1,64 @@
+/**
+ * `dragon::connected_components` over 1..N threads on an undirected R-MAT
+ * power-law graph and a road-like grid, against joining every edge in a
+ * `DisjointSetUnion`.
+ *
+ * usage: benchmark-connected_components [max_threads] [rmat_scale]
+ *        [grid_side]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "benchmark.hpp"
+#include "dragon/ds/disjoint_set_union.hpp"
+#include "dragon/graph/connected_components.hpp"
+
+template <typename GraphT>
+void scale(const std::string& name, const GraphT& graph,
+           std::size_t max_threads) {
+  const std::size_t sz = graph.size();
+  std::printf("%s: nodes: %zu, edges: %zu\n", name.c_str(), sz,
+              graph.num_edges());
+  double serial = dragon::bench::measure(
+      [&] {
+        dragon::DisjointSetUnion<std::size_t> dsu;
+        for (std::size_t u_i = 0; u_i < sz; ++u_i) {
+          dsu.make_set(u_i);
+        }
+        for (std::size_t u_i = 0; u_i < sz; ++u_i) {
+          for (auto edge : graph[u_i].edges) {
+            dsu.join(u_i, edge.first);
+          }
+        }
+      },
+      1);
+  std::printf("  DisjointSetUnion          %8.3f s\n", serial);
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    dragon::ThreadPool pool(threads);
+    std::vector<std::size_t> component, sizes;
+    double seconds = dragon::bench::measure(
+        [&] { component = dragon::connected_components(graph, sizes, pool); });
+    std::printf("  connected_components x%-3zu %8.3f s  speedup %5.2f  "
+                "components %zu\n",
+                threads, seconds, serial / seconds, sizes.size());
+  }
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10)
+                                     : dragon::ThreadPool::default_size();
+  unsigned rmat_scale =
+      argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 20;
+  std::size_t side = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1000;
+
+  auto edges = dragon::bench::rmat_graph<int>(rmat_scale, 8, 1);
+  for (std::size_t i = 0, m = edges.size(); i < m; ++i) {
+    edges.push_back({edges[i].to, edges[i].from, 1});
+  }
+  scale("power-law R-MAT",
+        dragon::bench::make_csr_graph(std::size_t(1) << rmat_scale, edges),
+        max_threads);
+  auto road = dragon::bench::make_csr_graph(
+      side * side, dragon::bench::grid_graph<int>(side, side));
+  scale("road-like grid", road, max_threads);
+}
@@ -0,0 +1,75 @@
+/**
+ * Contraction hierarchies on a road-like grid graph: preprocessing time,
+ * number of shortcuts and query latency, against bidirectional Dijkstra.
+ *
+ * usage: benchmark-contraction_hierarchies [grid_side] [num_of_queries]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include "benchmark.hpp"
+#include "dragon/graph/contraction_hierarchies.hpp"
+#include "dragon/graph/point_to_point.hpp"
+
+int main(int argc, char* argv[]) {
+  std::size_t side = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 300;
+  std::size_t num_of_queries =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+
+  auto graph = dragon::bench::make_csr_graph(
+      side * side, dragon::bench::grid_graph<int>(side, side));
+  std::printf("nodes: %zu, edges: %zu\n", graph.size(), graph.num_edges());
+
+  dragon::bench::Timer timer;
+  dragon::ContractionHierarchy<int> ch(graph);
+  std::printf("preprocessing: %.3f s, shortcuts: %zu (%.2f per edge)\n",
+              timer.seconds(), ch.num_of_shortcuts(),
+              static_cast<double>(ch.num_of_shortcuts()) / graph.num_edges());
+
+  std::mt19937 rng(1);
+  std::vector<std::pair<std::size_t, std::size_t>> queries(num_of_queries);
+  for (auto& q : queries) {
+    q = {rng() % graph.size(), rng() % graph.size()};
+  }
+
+  dragon::PointToPointQuery<decltype(graph)> bidirectional(graph);
+  std::vector<int> expected;
+  std::size_t settled = 0;
+  double seconds = dragon::bench::measure(
+      [&] {
+        for (auto q : queries) {
+          expected.push_back(
+              bidirectional.bidirectional_djikstra(q.first, q.second));
+          settled += bidirectional.num_of_settled();
+        }
+      },
+      1);
+  std::printf("bidirectional djikstra: %9.1f us/query %8zu settled/query\n",
+              1e6 * seconds / queries.size(), settled / queries.size());
+
+  std::size_t mismatches = 0;
+  settled = 0;
+  seconds = dragon::bench::measure(
+      [&] {
+        for (auto i = 0U; i < queries.size(); ++i) {
+          mismatches += ch.query(queries[i].first, queries[i].second) !=
+                        expected[i];
+          settled += ch.num_of_settled();
+        }
+      },
+      1);
+  std::printf("contraction hierarchy:  %9.1f us/query %8zu settled/query%s\n",
+              1e6 * seconds / queries.size(), settled / queries.size(),
+              mismatches ? "  (MISMATCH)" : "");
+
+  seconds = dragon::bench::measure(
+      [&] {
+        for (auto q : queries) {
+          ch.query(q.first, q.second);
+          settled += ch.path().size();
+        }
+      },
+      1);
+  std::printf("query + path unpacking: %9.1f us/query\n",
+              1e6 * seconds / queries.size());
+}
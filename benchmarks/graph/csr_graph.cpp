@@ -0,0 +1,72 @@
+/**
+ * Compares traversal throughput of the map-backed `dragon::Graph` against the
+ * compressed sparse row `dragon::CSRGraph`: a plain scan over every edge, and
+ * full single source shortest path runs.
+ *
+ * usage: benchmark-csr_graph [num_of_nodes] [num_of_edges]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include "benchmark.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+template <typename GraphT> long long sum_of_weights(const GraphT& graph) {
+  long long sum = 0;
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      sum += edge.second;
+    }
+  }
+  return sum;
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t sz = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::size_t num_of_edges =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10 * sz;
+
+  auto edges = dragon::bench::random_graph<int>(sz, num_of_edges);
+
+  dragon::bench::Timer timer;
+  auto graph = dragon::bench::make_graph(sz, edges);
+  double graph_build = timer.seconds();
+  timer.reset();
+  auto csr_graph = dragon::bench::make_csr_graph(sz, edges);
+  double csr_build = timer.seconds();
+  timer.reset();
+  dragon::CSRGraph<int, int> converted(graph);
+  double csr_convert = timer.seconds();
+
+  std::printf("nodes: %zu, edges: %zu\n", sz, csr_graph.num_edges());
+  std::printf("build Graph from edge list:    %8.3f s\n", graph_build);
+  std::printf("build CSRGraph from edge list: %8.3f s\n", csr_build);
+  std::printf("build CSRGraph from Graph:     %8.3f s\n", csr_convert);
+
+  long long graph_sum = 0, csr_sum = 0;
+  double graph_scan = dragon::bench::measure(
+      [&] { graph_sum = sum_of_weights(graph); });
+  double csr_scan = dragon::bench::measure(
+      [&] { csr_sum = sum_of_weights(csr_graph); });
+  if (graph_sum != csr_sum) {
+    std::printf("mismatch between edge scans\n");
+    return 1;
+  }
+  double num = static_cast<double>(csr_graph.num_edges());
+  std::printf("edge scan   Graph: %8.3f s (%7.1f Medges/s)\n", graph_scan,
+              num / graph_scan / 1e6);
+  std::printf("edge scan CSRGraph: %8.3f s (%7.1f Medges/s)\n", csr_scan,
+              num / csr_scan / 1e6);
+
+  std::vector<int> graph_dist, csr_dist;
+  double graph_sssp =
+      dragon::bench::measure([&] { graph_dist = dragon::djikstra(graph); }, 1);
+  double csr_sssp = dragon::bench::measure(
+      [&] { csr_dist = dragon::djikstra(csr_graph); }, 1);
+  if (graph_dist != csr_dist) {
+    std::printf("mismatch between shortest paths\n");
+    return 1;
+  }
+  std::printf("djikstra    Graph: %8.3f s\n", graph_sssp);
+  std::printf("djikstra CSRGraph: %8.3f s\n", csr_sssp);
+}
@@ -0,0 +1,57 @@
+/**
+ * `dragon::dag_shortest_paths` against `djikstra` and `spfa` on a random
+ * DAG, and the serial against the level synchronous topological sort.
+ *
+ * usage: benchmark-dag_shortest_path [nodes] [degree] [max_threads]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include "benchmark.hpp"
+#include "dragon/graph/dag_shortest_path.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+int main(int argc, char* argv[]) {
+  std::size_t sz = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::size_t degree = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+  std::size_t max_threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10)
+                                     : dragon::ThreadPool::default_size();
+
+  // Pointing every random edge from its smaller to its larger end keeps the
+  // graph acyclic; a chain from node 0 makes every node reachable.
+  auto edges = dragon::bench::random_graph<long long>(sz, degree * sz);
+  for (auto& edge : edges) {
+    if (edge.to < edge.from)
+      std::swap(edge.from, edge.to);
+  }
+  for (std::size_t i = 0; i + 1 < sz; ++i) {
+    edges.push_back({i, i + 1, 100});
+  }
+  auto graph = dragon::bench::make_csr_graph(sz, edges);
+  std::printf("random DAG: nodes: %zu, edges: %zu\n", sz, graph.num_edges());
+
+  std::vector<long long> expected, dist;
+  std::vector<std::size_t> parent;
+  double djikstra_seconds =
+      dragon::bench::measure([&] { expected = dragon::djikstra(graph); });
+  std::printf("  djikstra               %8.3f s\n", djikstra_seconds);
+  double spfa_seconds =
+      dragon::bench::measure([&] { dragon::spfa(graph, dist); });
+  std::printf("  spfa                   %8.3f s\n", spfa_seconds);
+  double dag_seconds = dragon::bench::measure(
+      [&] { dragon::dag_shortest_paths(graph, dist, parent); });
+  std::printf("  dag_shortest_paths     %8.3f s  speedup %5.2f%s\n",
+              dag_seconds, djikstra_seconds / dag_seconds,
+              dist == expected ? "" : "  (MISMATCH)");
+
+  std::vector<std::size_t> order, levels;
+  double serial =
+      dragon::bench::measure([&] { dragon::topological_sort(graph, order); });
+  std::printf("  topological_sort       %8.3f s\n", serial);
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    dragon::ThreadPool pool(threads);
+    double seconds = dragon::bench::measure(
+        [&] { dragon::topological_sort(graph, order, levels, pool); });
+    std::printf("  level topological x%-3zu %8.3f s  levels %zu\n", threads,
+                seconds, levels.size() - 1);
+  }
+}
@@ -0,0 +1,47 @@
+/**
+ * Scaling of `dragon::delta_stepping` over 1..N threads on a road-like grid
+ * graph and on an R-MAT power-law graph, against sequential `djikstra`.
+ *
+ * usage: benchmark-delta_stepping [max_threads] [grid_side] [rmat_scale]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "benchmark.hpp"
+#include "dragon/graph/delta_stepping.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+template <typename GraphT>
+void scale(const std::string& name, const GraphT& graph,
+           typename GraphT::EdgeValueType delta, std::size_t max_threads) {
+  std::printf("%s: nodes: %zu, edges: %zu, delta: %lld\n", name.c_str(),
+              graph.size(), graph.num_edges(), static_cast<long long>(delta));
+  std::vector<typename GraphT::EdgeValueType> expected, dist;
+  double sequential =
+      dragon::bench::measure([&] { expected = dragon::djikstra(graph); });
+  std::printf("  djikstra            %8.3f s\n", sequential);
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    dragon::ThreadPool pool(threads);
+    double seconds = dragon::bench::measure(
+        [&] { dist = dragon::delta_stepping(graph, delta, pool); });
+    std::printf("  delta_stepping x%-3zu %8.3f s  speedup %5.2f%s\n", threads,
+                seconds, sequential / seconds,
+                dist == expected ? "" : "  (MISMATCH)");
+  }
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10)
+                                     : dragon::ThreadPool::default_size();
+  std::size_t side = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+  unsigned rmat_scale =
+      argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10)) : 20;
+
+  auto road = dragon::bench::make_csr_graph(
+      side * side, dragon::bench::grid_graph<int>(side, side));
+  scale("road-like grid", road, 200, max_threads);
+
+  auto power_law = dragon::bench::make_csr_graph(
+      std::size_t(1) << rmat_scale, dragon::bench::rmat_graph<int>(rmat_scale));
+  scale("power-law R-MAT", power_law, 50, max_threads);
+}
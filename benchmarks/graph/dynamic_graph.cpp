@@ -0,0 +1,96 @@
+/**
+ * Update throughput of the map-backed `dragon::Graph` against
+ * `dragon::DynamicGraph` on a stream of random edge insertions and
+ * deletions over an R-MAT power-law graph, one update at a time, then
+ * `dragon::DynamicGraph::apply_updates` on sorted batches for 1, 2, 4, ...
+ * threads.
+ *
+ * usage: benchmark-dynamic_graph [rmat_scale] [num_of_updates] [batch_size]
+ *        [max_threads]
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "benchmark.hpp"
+#include "dragon/graph/dynamic_graph.hpp"
+
+int main(int argc, char* argv[]) {
+  unsigned scale =
+      argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 18;
+  std::size_t num_of_updates =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4000000;
+  std::size_t batch_size =
+      argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 100000;
+  std::size_t max_threads = argc > 4 ? std::strtoull(argv[4], nullptr, 10)
+                                     : dragon::ThreadPool::default_size();
+  const std::size_t sz = std::size_t(1) << scale;
+
+  // Every third update removes an edge inserted earlier in the stream.
+  using Update = dragon::DynamicGraph<int>::EdgeUpdate;
+  auto edges = dragon::bench::rmat_graph<int>(scale, num_of_updates / sz + 1);
+  std::vector<Update> updates;
+  updates.reserve(num_of_updates);
+  std::mt19937_64 rng(5);
+  for (std::size_t i = 0; i < num_of_updates; ++i) {
+    const auto& edge = edges[i % edges.size()];
+    if (i % 3 == 2) {
+      const auto& old = updates[rng() % i];
+      updates.push_back({old.from, old.to, 0, true});
+    } else {
+      updates.push_back({edge.from, edge.to, edge.weight});
+    }
+  }
+  std::printf("nodes: %zu, updates: %zu\n", sz, num_of_updates);
+
+  auto apply = [&](auto& graph) {
+    for (const auto& update : updates) {
+      if (update.remove)
+        graph.remove_directed_edge(update.from, update.to);
+      else
+        graph.add_directed_edge(update.from, update.to, update.weight);
+    }
+  };
+  std::size_t num_of_edges = 0;
+  double graph_time = dragon::bench::measure([&] {
+    dragon::Graph<int> graph(sz);
+    apply(graph);
+  }, 1);
+  double dynamic_time = dragon::bench::measure([&] {
+    dragon::DynamicGraph<int> graph(sz);
+    apply(graph);
+    num_of_edges = graph.num_edges();
+  }, 1);
+  const double num = static_cast<double>(num_of_updates);
+  std::printf("edges after updates: %zu\n", num_of_edges);
+  std::printf("sequential        Graph: %7.3f s (%6.2f Mupdates/s)\n",
+              graph_time, num / graph_time / 1e6);
+  std::printf("sequential DynamicGraph: %7.3f s (%6.2f Mupdates/s)\n",
+              dynamic_time, num / dynamic_time / 1e6);
+
+  // Sorting a batch by source is part of the cost of a batched update.
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    dragon::ThreadPool pool(threads);
+    dragon::DynamicGraph<int> graph(sz);
+    std::vector<Update> batch;
+    double elapsed = dragon::bench::measure([&] {
+      for (std::size_t first = 0; first < num_of_updates;
+           first += batch_size) {
+        const std::size_t last = std::min(first + batch_size, num_of_updates);
+        batch.assign(updates.begin() + first, updates.begin() + last);
+        std::stable_sort(batch.begin(), batch.end(),
+                         [](const Update& a, const Update& b) {
+                           return a.from < b.from;
+                         });
+        graph.apply_updates(batch, pool);
+      }
+    }, 1);
+    if (graph.num_edges() != num_of_edges) {
+      std::printf("mismatch between batched and sequential updates\n");
+      return 1;
+    }
+    std::printf("batched %2zu threads: %7.3f s (%6.2f Mupdates/s)\n",
+                threads, elapsed, num / elapsed / 1e6);
+  }
+}
@@ -0,0 +1,93 @@
+/**
+ * Ingestion of an R-MAT power-law graph from an edge list text file:
+ * `std::ifstream` extraction against `dragon::read_edge_list` over 1..N
+ * threads, in GB/s of text parsed, then building the graphs edge by edge
+ * against `dragon::build_csr_graph` and `dragon::build_graph`.
+ *
+ * usage: benchmark-edge_list [rmat_scale] [edge_factor] [max_threads] [path]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "benchmark.hpp"
+#include "dragon/graph/edge_list.hpp"
+
+int main(int argc, char* argv[]) {
+  unsigned scale =
+      argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 20;
+  std::size_t edge_factor =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+  std::size_t max_threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10)
+                                     : dragon::ThreadPool::default_size();
+  std::string path = argc > 4 ? argv[4] : "benchmark-edge_list.txt";
+  const std::size_t sz = std::size_t(1) << scale;
+
+  double bytes = 0;
+  {
+    auto edges = dragon::bench::rmat_graph<int>(scale, edge_factor);
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (out == nullptr) {
+      std::printf("cannot write %s\n", path.c_str());
+      return 1;
+    }
+    for (const auto& edge : edges) {
+      bytes += std::fprintf(out, "%zu %zu %d\n", edge.from, edge.to,
+                            edge.weight);
+    }
+    std::fclose(out);
+  }
+  const double gigabytes = bytes / 1e9;
+  std::printf("nodes: %zu, text: %.3f GB\n", sz, gigabytes);
+
+  using GraphType = dragon::CSRGraph<int, int>;
+  std::vector<GraphType::Edge> stream_edges;
+  double stream = dragon::bench::measure(
+      [&] {
+        stream_edges.clear();
+        std::ifstream in(path);
+        std::size_t u_i, v_i;
+        int weight;
+        while (in >> u_i >> v_i >> weight) {
+          stream_edges.push_back({u_i, v_i, weight});
+        }
+      },
+      1);
+  std::printf("  ifstream               %8.3f s  %6.3f GB/s  edges %zu\n",
+              stream, gigabytes / stream, stream_edges.size());
+
+  dragon::EdgeList<int> edges;
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    dragon::ThreadPool pool(threads);
+    bool ok = false;
+    double seconds = dragon::bench::measure(
+        [&] { ok = dragon::read_edge_list(path, edges, pool); });
+    std::printf("  read_edge_list x%-4zu   %8.3f s  %6.3f GB/s  edges %zu%s\n",
+                threads, seconds, gigabytes / seconds, edges.size(),
+                ok ? "" : "  (FAILED)");
+  }
+  std::remove(path.c_str());
+
+  dragon::ThreadPool pool(max_threads);
+  double csr = dragon::bench::measure(
+      [&] { GraphType graph(edges.num_of_nodes, stream_edges); }, 1);
+  std::printf("  CSRGraph(sz, edges)    %8.3f s\n", csr);
+  double bulk_csr = dragon::bench::measure(
+      [&] { auto graph = dragon::build_csr_graph<int>(edges, pool); }, 1);
+  std::printf("  build_csr_graph        %8.3f s  speedup %5.2f\n", bulk_csr,
+              csr / bulk_csr);
+  double map = dragon::bench::measure(
+      [&] {
+        dragon::Graph<int, int> graph(edges.num_of_nodes);
+        for (const auto& edge : stream_edges) {
+          graph.add_directed_edge(edge.from, edge.to, edge.weight);
+        }
+      },
+      1);
+  std::printf("  Graph add_directed_edge%8.3f s\n", map);
+  double bulk_map = dragon::bench::measure(
+      [&] { auto graph = dragon::build_graph<int>(edges, pool); }, 1);
+  std::printf("  build_graph            %8.3f s  speedup %5.2f\n", bulk_map,
+              map / bulk_map);
+}
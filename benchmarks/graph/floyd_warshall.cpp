@@ -0,0 +1,76 @@
+/**
+ * Blocked `dragon::FloydWarshall` over 1..N threads against the textbook
+ * triple loop on a dense random graph, for each supported weight type.
+ *
+ * usage: benchmark-floyd_warshall [max_threads] [nodes] [density_percent]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "benchmark.hpp"
+#include "dragon/graph/floyd_warshall.hpp"
+
+template <typename EdgeValueT>
+void compare(const std::string& name, std::size_t sz, std::size_t num_of_edges,
+             std::size_t max_threads) {
+  auto graph = dragon::bench::make_graph(
+      sz, dragon::bench::random_graph<EdgeValueT>(sz, num_of_edges));
+  std::printf("%s: nodes: %zu, edges: %zu\n", name.c_str(), sz, num_of_edges);
+
+  const EdgeValueT inf = std::numeric_limits<EdgeValueT>::max();
+  std::vector<EdgeValueT> expected;
+  double naive = dragon::bench::measure(
+      [&] {
+        expected.assign(sz * sz, inf);
+        for (const auto& u : graph) {
+          expected[u.index() * sz + u.index()] = 0;
+          for (auto edge : u.edges) {
+            auto& d = expected[u.index() * sz + edge.first];
+            d = std::min(d, edge.second);
+          }
+        }
+        for (std::size_t k = 0; k < sz; ++k) {
+          for (std::size_t i = 0; i < sz; ++i) {
+            EdgeValueT a = expected[i * sz + k];
+            if (a == inf)
+              continue;
+            for (std::size_t j = 0; j < sz; ++j) {
+              EdgeValueT b = expected[k * sz + j];
+              if (b != inf && a + b < expected[i * sz + j])
+                expected[i * sz + j] = a + b;
+            }
+          }
+        }
+      },
+      1);
+  std::printf("  triple loop        %8.3f s\n", naive);
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    dragon::ThreadPool pool(threads);
+    bool match = true;
+    double seconds = dragon::bench::measure(
+        [&] {
+          dragon::FloydWarshall<EdgeValueT> fw(graph, pool);
+          for (std::size_t u_i = 0; u_i < sz; ++u_i) {
+            match = match && std::equal(expected.begin() + u_i * sz,
+                                        expected.begin() + (u_i + 1) * sz,
+                                        fw.row(u_i));
+          }
+        },
+        1);
+    std::printf("  floyd_warshall x%-3zu %8.3f s  speedup %5.2f%s\n", threads,
+                seconds, naive / seconds, match ? "" : "  (MISMATCH)");
+  }
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10)
+                                     : dragon::ThreadPool::default_size();
+  std::size_t sz = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1500;
+  std::size_t density = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 25;
+  std::size_t num_of_edges = sz * sz * density / 100;
+
+  compare<int>("int32", sz, num_of_edges, max_threads);
+  compare<long long>("int64", sz, num_of_edges, max_threads);
+  compare<float>("float", sz, num_of_edges, max_threads);
+  compare<double>("double", sz, num_of_edges, max_threads);
+}
@@ -0,0 +1,67 @@
+/**
+ * Startup time of a large R-MAT power-law graph: building a `dragon::Graph`
+ * edge by edge and a `dragon::CSRGraph` from an edge list, against opening
+ * the same graph saved with `dragon::write_graph_file` as a
+ * `dragon::MappedCSRGraph`. A Dijkstra run on each shows what the first
+ * query costs once the graph is there.
+ *
+ * usage: benchmark-graph_file [rmat_scale] [edge_factor] [path]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "benchmark.hpp"
+#include "dragon/graph/graph_file.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+int main(int argc, char* argv[]) {
+  unsigned scale =
+      argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 20;
+  std::size_t edge_factor =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+  std::string path = argc > 3 ? argv[3] : "benchmark-graph_file.bin";
+  const std::size_t sz = std::size_t(1) << scale;
+  auto edges = dragon::bench::rmat_graph<int>(scale, edge_factor);
+  std::printf("nodes: %zu, edges: %zu\n", sz, edges.size());
+
+  dragon::bench::Timer timer;
+  auto graph = dragon::bench::make_graph(sz, edges);
+  double graph_build = timer.seconds();
+  std::printf("  Graph build            %9.6f s\n", graph_build);
+  timer.reset();
+  auto csr_graph = dragon::bench::make_csr_graph(sz, edges);
+  double csr_build = timer.seconds();
+  std::printf("  CSRGraph build         %9.6f s\n", csr_build);
+  timer.reset();
+  if (!dragon::write_graph_file(path, csr_graph)) {
+    std::printf("cannot write %s\n", path.c_str());
+    return 1;
+  }
+  std::printf("  write_graph_file       %9.6f s\n", timer.seconds());
+
+  timer.reset();
+  dragon::MappedCSRGraph<int, int> mapped;
+  if (!mapped.open(path)) {
+    std::printf("cannot open %s\n", path.c_str());
+    return 1;
+  }
+  double open = timer.seconds();
+  std::printf("  MappedCSRGraph open    %9.6f s  speedup %.0f over Graph, "
+              "%.0f over CSRGraph\n",
+              open, graph_build / open, csr_build / open);
+
+  std::vector<int> expected, dist;
+  timer.reset();
+  expected = dragon::djikstra(graph);
+  std::printf("  djikstra Graph         %9.6f s\n", timer.seconds());
+  timer.reset();
+  dist = dragon::djikstra(csr_graph);
+  std::printf("  djikstra CSRGraph      %9.6f s%s\n", timer.seconds(),
+              dist == expected ? "" : "  (MISMATCH)");
+  timer.reset();
+  dist = dragon::djikstra(mapped);
+  std::printf("  djikstra mapped        %9.6f s%s\n", timer.seconds(),
+              dist == expected ? "" : "  (MISMATCH)");
+  std::remove(path.c_str());
+}
@@ -0,0 +1,63 @@
+/**
+ * `FlowNetwork::dinic` against `FlowNetwork::push_relabel` on layered
+ * networks (wide layers with random links between consecutive ones) and on
+ * random networks.
+ *
+ * usage: benchmark-max_flow [layers] [layer_width] [random_nodes]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include "benchmark.hpp"
+#include "dragon/graph/max_flow.hpp"
+
+void compare(const std::string& name, dragon::FlowNetwork<long long>& network,
+             std::size_t source, std::size_t sink) {
+  std::printf("%s: nodes: %zu, edges: %zu\n", name.c_str(), network.size(),
+              network.num_of_edges());
+  long long dinic_value = 0, push_relabel_value = 0;
+  double dinic = dragon::bench::measure(
+      [&] { dinic_value = network.dinic(source, sink); });
+  std::printf("  dinic        %8.3f s  flow %lld\n", dinic, dinic_value);
+  double push_relabel = dragon::bench::measure(
+      [&] { push_relabel_value = network.push_relabel(source, sink); });
+  std::printf("  push_relabel %8.3f s  flow %lld%s\n", push_relabel,
+              push_relabel_value,
+              push_relabel_value == dinic_value ? "" : "  (MISMATCH)");
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t layers = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20;
+  std::size_t width = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000;
+  std::size_t sz = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 200000;
+  std::mt19937_64 rng(42);
+
+  {
+    // Source, `layers` layers of `width` nodes, sink.
+    const std::size_t source = 0, sink = layers * width + 1;
+    dragon::FlowNetwork<long long> network(sink + 1);
+    for (std::size_t i = 0; i < width; ++i) {
+      network.add_edge(source, 1 + i, 1000);
+      network.add_edge(1 + (layers - 1) * width + i, sink, 1000);
+    }
+    for (std::size_t l = 0; l + 1 < layers; ++l) {
+      for (std::size_t i = 0; i < width; ++i) {
+        std::size_t u_i = 1 + l * width + i;
+        for (int k = 0; k < 4; ++k) {
+          network.add_edge(u_i, 1 + (l + 1) * width + rng() % width,
+                           static_cast<long long>(1 + rng() % 500));
+        }
+      }
+    }
+    compare("layered", network, source, sink);
+  }
+  {
+    auto edges = dragon::bench::random_graph<long long>(sz, 8 * sz, 1000);
+    dragon::FlowNetwork<long long> network(sz);
+    for (const auto& edge : edges) {
+      network.add_edge(edge.from, edge.to, edge.weight);
+    }
+    compare("random", network, 0, sz - 1);
+  }
+}
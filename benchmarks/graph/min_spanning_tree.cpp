@@ -0,0 +1,91 @@
+/**
+ * `dragon::kruskal` against `dragon::flat_kruskal`,
+ * `dragon::filter_kruskal`, the parallel `dragon::boruvka` over 1..N
+ * threads, and `dragon::prim` with a fresh or a reused heap and
+ * `dragon::dense_prim` (on the near complete graph only), on a sparse
+ * random graph, a denser one and a near complete one, all undirected and
+ * connected.
+ *
+ * usage: benchmark-min_spanning_tree [nodes] [sparse_degree] [dense_degree]
+ *        [max_threads]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "benchmark.hpp"
+#include "dragon/graph/min_spanning_tree.hpp"
+
+template <typename TreeT> long long weight(const TreeT& tree) {
+  long long total = 0;
+  for (const auto& node : tree) {
+    for (auto edge : node.edges) {
+      total += edge.second;
+    }
+  }
+  return total / 2;
+}
+
+void compare(const std::string& name, std::size_t sz, std::size_t degree,
+             std::size_t max_threads, bool quadratic = false) {
+  auto edges = dragon::bench::random_graph<int>(sz, sz * degree / 2, 1000000);
+  // A path keeps the graph connected.
+  for (std::size_t v_i = 1; v_i < sz; ++v_i) {
+    edges.push_back({v_i - 1, v_i, 1000000});
+  }
+  dragon::Graph<int, int> graph(sz);
+  for (const auto& edge : edges) {
+    graph.add_undirected_edge(edge.from, edge.to, edge.weight);
+  }
+  std::printf("%s: nodes: %zu, edges: %zu\n", name.c_str(), sz,
+              edges.size());
+
+  long long expected = 0, result = 0;
+  double kruskal = dragon::bench::measure(
+      [&] { expected = weight(dragon::kruskal(graph)); }, 1);
+  std::printf("  kruskal        %8.3f s  weight %lld\n", kruskal, expected);
+  double prim = dragon::bench::measure(
+      [&] { result = weight(dragon::prim(graph)); });
+  std::printf("  prim           %8.3f s  weight %lld  speedup %5.2f%s\n", prim,
+              result, kruskal / prim, result == expected ? "" : " MISMATCH");
+  dragon::IndexedDaryHeap<int> heap;
+  double reused = dragon::bench::measure(
+      [&] { result = weight(dragon::prim(graph, heap)); });
+  std::printf("  prim (reused)  %8.3f s  weight %lld  speedup %5.2f%s\n",
+              reused, result, kruskal / reused,
+              result == expected ? "" : " MISMATCH");
+  if (quadratic) {
+    double dense_prim = dragon::bench::measure(
+        [&] { result = weight(dragon::dense_prim(graph)); });
+    std::printf("  dense_prim     %8.3f s  weight %lld  speedup %5.2f%s\n",
+                dense_prim, result, kruskal / dense_prim,
+                result == expected ? "" : " MISMATCH");
+  }
+  double flat = dragon::bench::measure(
+      [&] { result = weight(dragon::flat_kruskal(graph)); });
+  std::printf("  flat_kruskal   %8.3f s  weight %lld  speedup %5.2f%s\n", flat,
+              result, kruskal / flat, result == expected ? "" : " MISMATCH");
+  double filter = dragon::bench::measure(
+      [&] { result = weight(dragon::filter_kruskal(graph)); });
+  std::printf("  filter_kruskal %8.3f s  weight %lld  speedup %5.2f%s\n",
+              filter, result, kruskal / filter,
+              result == expected ? "" : " MISMATCH");
+  for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+    dragon::ThreadPool pool(threads);
+    double boruvka = dragon::bench::measure(
+        [&] { result = weight(dragon::boruvka(graph, pool)); });
+    std::printf("  boruvka x%-4zu  %8.3f s  weight %lld  speedup %5.2f%s\n",
+                threads, boruvka, result, kruskal / boruvka,
+                result == expected ? "" : " MISMATCH");
+  }
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t sz = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+  std::size_t sparse = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+  std::size_t dense = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 64;
+  std::size_t max_threads = argc > 4 ? std::strtoull(argv[4], nullptr, 10)
+                                     : dragon::ThreadPool::default_size();
+  compare("sparse", sz, sparse, max_threads);
+  compare("dense", sz / 4, dense, max_threads);
+  compare("near complete", sz / 100, sz / 200, max_threads, true);
+}
@@ -0,0 +1,71 @@
+/**
+ * Average latency of random source to target queries on a road-like grid
+ * graph: full `dragon::djikstra` against the reusable `PointToPointQuery`
+ * engine.
+ *
+ * usage: benchmark-point_to_point [grid_side] [num_of_queries]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include "benchmark.hpp"
+#include "dragon/graph/point_to_point.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+int main(int argc, char* argv[]) {
+  std::size_t side = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+  std::size_t num_of_queries =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100;
+
+  auto graph = dragon::bench::make_csr_graph(
+      side * side, dragon::bench::grid_graph<int>(side, side));
+  std::printf("nodes: %zu, edges: %zu\n", graph.size(), graph.num_edges());
+
+  std::mt19937 rng(1);
+  std::vector<std::pair<std::size_t, std::size_t>> queries(num_of_queries);
+  for (auto& q : queries) {
+    q = {rng() % graph.size(), rng() % graph.size()};
+  }
+
+  dragon::PointToPointQuery<decltype(graph)> query(graph);
+  std::vector<int> expected;
+  double full = dragon::bench::measure(
+      [&] {
+        for (auto q : queries)
+          expected.push_back(dragon::djikstra(graph, q.first)[q.second]);
+      },
+      1);
+
+  auto run = [&](const char* name, auto fn) {
+    std::size_t settled = 0, mismatches = 0;
+    double seconds = dragon::bench::measure(
+        [&] {
+          settled = mismatches = 0;
+          for (auto i = 0U; i < queries.size(); ++i) {
+            if (fn(queries[i].first, queries[i].second) != expected[i])
+              ++mismatches;
+            settled += query.num_of_settled();
+          }
+        },
+        1);
+    std::printf("%-24s %10.3f ms/query  %10zu settled/query%s\n", name,
+                1e3 * seconds / queries.size(), settled / queries.size(),
+                mismatches ? "  (MISMATCH)" : "");
+  };
+
+  std::printf("%-24s %10.3f ms/query\n", "djikstra (all targets)",
+              1e3 * full / queries.size());
+  run("djikstra", [&](std::size_t s, std::size_t t) {
+    return query.djikstra(s, t);
+  });
+  run("bidirectional_djikstra", [&](std::size_t s, std::size_t t) {
+    return query.bidirectional_djikstra(s, t);
+  });
+  run("a_star (manhattan)", [&](std::size_t s, std::size_t t) {
+    return query.a_star(s, t, [&](std::size_t v) {
+      long r = static_cast<long>(v / side) - static_cast<long>(t / side);
+      long c = static_cast<long>(v % side) - static_cast<long>(t % side);
+      return static_cast<int>(std::labs(r) + std::labs(c));
+    });
+  });
+}
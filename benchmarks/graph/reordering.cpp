@@ -0,0 +1,71 @@
+/**
+ * `dragon::djikstra` on an undirected R-MAT power-law graph stored as a
+ * `dragon::CSRGraph`, with randomly shuffled node labels, against the same
+ * graph relabeled with each `dragon::VertexOrder`.
+ *
+ * usage: benchmark-reordering [rmat_scale] [edge_factor]
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "benchmark.hpp"
+#include "dragon/graph/reordering.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+int main(int argc, char* argv[]) {
+  unsigned scale =
+      argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 20;
+  std::size_t edge_factor =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+  const std::size_t sz = std::size_t(1) << scale;
+
+  // R-MAT gives its hubs the lowest indices, shuffle them away.
+  std::vector<std::size_t> label(sz);
+  for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+    label[v_i] = v_i;
+  }
+  std::shuffle(label.begin(), label.end(), std::mt19937_64(7));
+  using GraphType = dragon::CSRGraph<int, long long>;
+  std::vector<GraphType::Edge> edges;
+  for (const auto& edge :
+       dragon::bench::rmat_graph<long long>(scale, edge_factor)) {
+    edges.push_back({label[edge.from], label[edge.to], edge.weight});
+    edges.push_back({label[edge.to], label[edge.from], edge.weight});
+  }
+  GraphType graph(sz, edges, label[0]);
+  std::printf("nodes: %zu, edges: %zu\n", sz, graph.num_edges());
+
+  std::vector<long long> expected;
+  double shuffled =
+      dragon::bench::measure([&] { expected = dragon::djikstra(graph); });
+  std::printf("  shuffled               djikstra %7.3f s\n", shuffled);
+
+  const std::pair<std::string, dragon::VertexOrder> orders[] = {
+      {"reverse_cuthill_mckee", dragon::VertexOrder::reverse_cuthill_mckee},
+      {"degree_descending", dragon::VertexOrder::degree_descending},
+      {"bfs", dragon::VertexOrder::bfs},
+      {"dfs", dragon::VertexOrder::dfs}};
+  for (const auto& order : orders) {
+    std::vector<std::size_t> new_index, old_index;
+    GraphType relabeled;
+    double reorder = dragon::bench::measure(
+        [&] {
+          relabeled =
+              dragon::reorder(graph, order.second, new_index, old_index);
+        },
+        1);
+    std::vector<long long> dist;
+    double seconds =
+        dragon::bench::measure([&] { dist = dragon::djikstra(relabeled); });
+    bool match = true;
+    for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+      match = match && dist[new_index[v_i]] == expected[v_i];
+    }
+    std::printf("  %-22s djikstra %7.3f s  speedup %5.2f  reorder %7.3f s%s\n",
+                order.first.c_str(), seconds, shuffled / seconds, reorder,
+                match ? "" : "  (MISMATCH)");
+  }
+}
@@ -0,0 +1,55 @@
+/**
+ * Compares the priority queue policies of `dragon::djikstra`, and the integer
+ * weight algorithms, on a sparse random graph with weights in [1, 100] stored
+ * as a `dragon::CSRGraph`.
+ *
+ * usage: benchmark-shortest_path [num_of_nodes] [num_of_edges]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "benchmark.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+template <typename GraphT, typename FunctionT>
+void run(const std::string& name, const GraphT& graph,
+         const std::vector<typename GraphT::EdgeValueType>& expected,
+         FunctionT fn) {
+  std::vector<typename GraphT::EdgeValueType> dist;
+  double seconds = dragon::bench::measure([&] { dist = fn(graph); });
+  std::printf("%-24s %8.3f s%s\n", name.c_str(), seconds,
+              dist == expected ? "" : "  (MISMATCH)");
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t sz = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::size_t num_of_edges =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4 * sz;
+
+  auto graph = dragon::bench::make_csr_graph(
+      sz, dragon::bench::random_graph<long long>(sz, num_of_edges));
+  std::printf("nodes: %zu, edges: %zu\n", sz, graph.num_edges());
+
+  auto expected = dragon::djikstra(graph, graph.root(), dragon::SetQueue{});
+  run("SetQueue", graph, expected, [](const auto& g) {
+    return dragon::djikstra(g, g.root(), dragon::SetQueue{});
+  });
+  run("DaryHeapQueue<2>", graph, expected, [](const auto& g) {
+    return dragon::djikstra(g, g.root(), dragon::DaryHeapQueue<2>{});
+  });
+  run("DaryHeapQueue<4>", graph, expected, [](const auto& g) {
+    return dragon::djikstra(g, g.root(), dragon::DaryHeapQueue<4>{});
+  });
+  run("DaryHeapQueue<8>", graph, expected, [](const auto& g) {
+    return dragon::djikstra(g, g.root(), dragon::DaryHeapQueue<8>{});
+  });
+  run("LazyBinaryHeapQueue", graph, expected, [](const auto& g) {
+    return dragon::djikstra(g, g.root(), dragon::LazyBinaryHeapQueue{});
+  });
+  run("radix_djikstra", graph, expected,
+      [](const auto& g) { return dragon::radix_djikstra(g); });
+  run("dial_djikstra", graph, expected,
+      [](const auto& g) { return dragon::dial_djikstra(g, 100LL); });
+  run("shortest_paths", graph, expected,
+      [](const auto& g) { return dragon::shortest_paths(g); });
+}
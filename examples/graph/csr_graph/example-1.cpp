@@ -0,0 +1,35 @@
+#include <iostream>
+#include <vector>
+
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+int main() {
+  using CSRGraphType = dragon::CSRGraph<int, int>;
+
+  // Build a frozen graph directly from a list of directed edges.
+  std::vector<CSRGraphType::Edge> edges = {{0, 1, 1}, {0, 3, 2}, {1, 2, 4},
+                                           {2, 3, 8}, {3, 4, 5}, {4, 5, 7},
+                                           {5, 3, 6}};
+  CSRGraphType graph(6, edges);
+
+  std::cout << "Out-edges of node 0: ";
+  for (auto edge : graph[0].edges) {
+    std::cout << edge.first << "(" << edge.second << ") ";
+  }
+  std::cout << "\n";
+
+  // Algorithms written for dragon::Graph accept CSRGraph as well.
+  auto shortest_paths_weight = dragon::djikstra(graph);
+  for (auto i = 0U; i < graph.size(); ++i) {
+    std::cout << "Shortest path of " << graph.root() << "->" << i << ": "
+              << shortest_paths_weight[i] << "\n";
+  }
+
+  // A map-backed graph can be frozen once it has been fully built.
+  dragon::Graph<int, int> mutable_graph(3);
+  mutable_graph.add_undirected_edge(0, 1, 3);
+  mutable_graph.add_undirected_edge(1, 2, 4);
+  CSRGraphType frozen(mutable_graph);
+  std::cout << "Edges in frozen graph: " << frozen.num_edges() << "\n";
+}
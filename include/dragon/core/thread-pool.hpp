@@ -0,0 +1,182 @@
+#ifndef DRAGON_CORE_THREAD_POOL_HPP
+#define DRAGON_CORE_THREAD_POOL_HPP
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace dragon {
+
+/**
+ * `ThreadPool` keeps a fixed set of worker threads alive so that parallel
+ * algorithms can fork and join many times without paying for thread
+ * creation. Work is submitted in a fork-join fashion: `run` executes a task
+ * on every thread of the pool, including the calling thread, and returns
+ * once all of them are done.
+ *
+ * A pool of size 1 has no worker threads and runs everything inline.
+ *
+ * @note Tasks must not throw, and `run`/`parallel_for` must not be called
+ * from inside a task of the same pool.
+ */
+class ThreadPool {
+public:
+  using SizeType = std::size_t;
+
+  /// Returns the number of hardware threads, at least 1.
+  static SizeType default_size() {
+    return std::max<SizeType>(1, std::thread::hardware_concurrency());
+  }
+
+  /**
+   * Creates a pool whose tasks run on `sz` threads: the calling thread and
+   * `sz - 1` workers. The default starts `default_size() - 1` threads.
+   */
+  explicit ThreadPool(SizeType sz = default_size());
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+  ~ThreadPool();
+
+  /// Returns the number of threads tasks run on.
+  SizeType size() const { return m_workers.size() + 1; }
+
+  /**
+   * Calls `task(thread_index)` once on each thread of the pool, with
+   * `thread_index` in `[0, size())`, and blocks until every call returned.
+   * The calling thread gets index 0.
+   */
+  template <typename TaskT> void run(TaskT&& task);
+
+  /**
+   * Calls `fn(i, thread_index)` for every `i` in `[first, last)`, spreading
+   * chunks of `grain` consecutive indices dynamically over the threads of
+   * the pool. A `grain` of 0 picks a chunk size that gives each thread a
+   * few chunks.
+   */
+  template <typename FunctionT>
+  void parallel_for(SizeType first, SizeType last, FunctionT&& fn,
+                    SizeType grain = 0);
+
+private:
+  void worker_loop(SizeType thread_index);
+
+  template <typename TaskT> static void invoke(void* task, SizeType index) {
+    (*static_cast<TaskT*>(task))(index);
+  }
+
+private:
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_start_cv;
+  std::condition_variable m_done_cv;
+  /// Type erased current task, valid while a `run` call is in progress.
+  void* m_task = nullptr;
+  void (*m_invoke)(void*, SizeType) = nullptr;
+  /// Incremented for every `run` call, wakes the workers up.
+  unsigned long long m_generation = 0;
+  /// Number of workers that have not yet finished the current task.
+  SizeType m_pending = 0;
+  bool m_stop = false;
+};
+
+inline ThreadPool::ThreadPool(SizeType sz) {
+  sz = std::max<SizeType>(sz, 1);
+  m_workers.reserve(sz - 1);
+  for (SizeType i = 1; i < sz; ++i) {
+    m_workers.emplace_back([this, i] { worker_loop(i); });
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_start_cv.notify_all();
+  for (auto& worker : m_workers) {
+    worker.join();
+  }
+}
+
+inline void ThreadPool::worker_loop(SizeType thread_index) {
+  unsigned long long seen_generation = 0;
+  while (true) {
+    void* task = nullptr;
+    void (*invoke_task)(void*, SizeType) = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_start_cv.wait(lock, [&] {
+        return m_stop || m_generation != seen_generation;
+      });
+      if (m_stop)
+        return;
+      seen_generation = m_generation;
+      task = m_task;
+      invoke_task = m_invoke;
+    }
+    invoke_task(task, thread_index);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (--m_pending == 0)
+        m_done_cv.notify_one();
+    }
+  }
+}
+
+template <typename TaskT> void ThreadPool::run(TaskT&& task) {
+  using TaskType = std::remove_reference_t<TaskT>;
+  if (m_workers.empty()) {
+    task(0);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_task = const_cast<void*>(static_cast<const void*>(&task));
+    m_invoke = &ThreadPool::invoke<TaskType>;
+    m_pending = m_workers.size();
+    ++m_generation;
+  }
+  m_start_cv.notify_all();
+  task(0);
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done_cv.wait(lock, [&] { return m_pending == 0; });
+}
+
+template <typename FunctionT>
+void ThreadPool::parallel_for(SizeType first, SizeType last, FunctionT&& fn,
+                              SizeType grain) {
+  if (first >= last)
+    return;
+  const SizeType n = last - first;
+  if (grain == 0) {
+    grain = std::max<SizeType>(1, n / (size() * 8));
+  }
+  if (m_workers.empty() || n <= grain) {
+    for (SizeType i = first; i < last; ++i) {
+      fn(i, 0);
+    }
+    return;
+  }
+  std::atomic<SizeType> next(first);
+  run([&](SizeType thread_index) {
+    while (true) {
+      SizeType chunk_first = next.fetch_add(grain, std::memory_order_relaxed);
+      if (chunk_first >= last)
+        break;
+      SizeType chunk_last = std::min(last, chunk_first + grain);
+      for (SizeType i = chunk_first; i < chunk_last; ++i) {
+        fn(i, thread_index);
+      }
+    }
+  });
+}
+
+} // namespace dragon
+
+#endif
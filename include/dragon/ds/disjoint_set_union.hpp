@@ -1,6 +1,7 @@
 #ifndef DRAGON_DS_DISJOINT_SET_UNION_HPP
 #define DRAGON_DS_DISJOINT_SET_UNION_HPP
 #include <map>
+#include <utility>
 #include <vector>
 
 namespace dragon {
@@ -118,6 +119,92 @@ bool DisjointSetUnion<ValueT>::in_same_set(const ValueType& u,
          find_representative(m_identifier[v]);
 }
 
+/**
+ * `IndexedDisjointSetUnion` is a disjoint set union over the integer ids
+ * `[0, size)`. Without the value to index mapping of `DisjointSetUnion`, it
+ * keeps one flat parent array and one flat size array, and finds are
+ * iterative with path halving, so it suits hot loops such as Kruskal's
+ * algorithm.
+ *
+ * @param SizeT type of ids.
+ */
+template <typename SizeT = std::size_t> class IndexedDisjointSetUnion {
+public:
+  using SizeType = SizeT;
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+
+public:
+  /// Creates `size` singleton sets.
+  explicit IndexedDisjointSetUnion(SizeType size = 0) { reset(size); }
+  IndexedDisjointSetUnion(const IndexedDisjointSetUnion&) = default;
+  IndexedDisjointSetUnion(IndexedDisjointSetUnion&&) noexcept = default;
+  IndexedDisjointSetUnion&
+  operator=(const IndexedDisjointSetUnion&) = default;
+  IndexedDisjointSetUnion&
+  operator=(IndexedDisjointSetUnion&&) noexcept = default;
+  ~IndexedDisjointSetUnion() = default;
+
+  /// Makes `size` singleton sets again.
+  void reset(SizeType size) {
+    m_parent.resize(size);
+    for (SizeType u_i = 0; u_i < size; ++u_i) {
+      m_parent[u_i] = u_i;
+    }
+    m_size.assign(size, 1);
+    m_num_of_sets = size;
+  }
+
+  /// Returns the number of ids.
+  SizeType size() const { return m_parent.size(); }
+
+  /// Returns the number of disjoint sets.
+  SizeType num_of_sets() const { return m_num_of_sets; }
+
+  /// Returns the representative of the set that contains `u_i`.
+  SizeType find(SizeType u_i) {
+    while (m_parent[u_i] != u_i) {
+      m_parent[u_i] = m_parent[m_parent[u_i]];
+      u_i = m_parent[u_i];
+    }
+    return u_i;
+  }
+
+  /**
+   * Joins the sets that contain `u_i` and `v_i`, the smaller one below the
+   * larger one.
+   *
+   * @returns false if they already were the same set.
+   */
+  bool join(SizeType u_i, SizeType v_i) {
+    u_i = find(u_i);
+    v_i = find(v_i);
+    if (u_i == v_i)
+      return false;
+    if (m_size[u_i] < m_size[v_i])
+      std::swap(u_i, v_i);
+    m_parent[v_i] = u_i;
+    m_size[u_i] += m_size[v_i];
+    --m_num_of_sets;
+    return true;
+  }
+
+  /// Returns true if `u_i` and `v_i` belong to the same set.
+  bool in_same_set(SizeType u_i, SizeType v_i) {
+    return find(u_i) == find(v_i);
+  }
+
+  /// Returns the number of ids in the set that contains `u_i`.
+  SizeType set_size(SizeType u_i) { return m_size[find(u_i)]; }
+
+private:
+  Sequence<SizeType> m_parent;
+  /// Number of ids below each representative.
+  Sequence<SizeType> m_size;
+  SizeType m_num_of_sets = 0;
+};
+
 } // namespace dragon
 
 #endif
\ No newline at end of file
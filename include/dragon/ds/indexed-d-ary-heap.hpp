@@ -0,0 +1,228 @@
+#ifndef DRAGON_DS_INDEXED_D_ARY_HEAP_HPP
+#define DRAGON_DS_INDEXED_D_ARY_HEAP_HPP
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace dragon {
+
+/**
+ * `IndexedDaryHeap` is a d-ary min-heap over the integer ids `[0, capacity)`,
+ * each id carrying a key. Besides the usual heap operations it can look up,
+ * and decrease, the key of any id in the heap, which makes it suitable as
+ * the priority queue of Dijkstra and Prim like algorithms.
+ *
+ * All storage is allocated up front, so no operation allocates. `push`,
+ * `pop` and `decrease_key` take O(log_d(size)) time; a larger arity makes
+ * the heap shallower at the cost of more comparisons per level.
+ *
+ * @param KeyT type of keys.
+ * @param Arity number of children of each heap node, at least 2.
+ * @param CompareT strict weak ordering of keys, smallest key is on top.
+ */
+template <typename KeyT, std::size_t Arity = 4,
+          typename CompareT = std::less<KeyT>>
+class IndexedDaryHeap {
+  static_assert(Arity >= 2, "dragon::IndexedDaryHeap: Arity must be >= 2");
+
+public:
+  using KeyType = KeyT;
+  using SizeType = std::size_t;
+  using CompareType = CompareT;
+
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+  static constexpr SizeType arity = Arity;
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+  using EntryType = std::pair<KeyType, SizeType>;
+
+public:
+  explicit IndexedDaryHeap(SizeType capacity = 0,
+                           CompareType compare = CompareType())
+      : m_position(capacity, npos), m_compare(compare) {
+    m_heap.reserve(capacity);
+  }
+  IndexedDaryHeap(const IndexedDaryHeap&) = default;
+  IndexedDaryHeap(IndexedDaryHeap&&) noexcept = default;
+  IndexedDaryHeap& operator=(const IndexedDaryHeap&) = default;
+  IndexedDaryHeap& operator=(IndexedDaryHeap&&) noexcept = default;
+  ~IndexedDaryHeap() = default;
+
+  /// Returns the number of ids currently in the heap.
+  SizeType size() const { return m_heap.size(); }
+  bool empty() const { return m_heap.empty(); }
+
+  /// Returns one more than the largest id the heap can hold.
+  SizeType capacity() const { return m_position.size(); }
+
+  /// Removes every id and allows ids in `[0, capacity)`.
+  void reset(SizeType capacity);
+
+  /// Removes every id, in O(size()) time.
+  void clear();
+
+  /// Returns true if `index` is currently in the heap.
+  bool contains(SizeType index) const { return m_position[index] != npos; }
+
+  /// Returns the key of `index`, which must be in the heap.
+  const KeyType& key(SizeType index) const {
+    return m_heap[m_position[index]].first;
+  }
+
+  /// Returns the id with the smallest key.
+  SizeType top() const { return m_heap.front().second; }
+
+  /// Returns the smallest key.
+  const KeyType& top_key() const { return m_heap.front().first; }
+
+  /**
+   * Inserts `index` with key `key`.
+   *
+   * @note `index` must not already be in the heap.
+   */
+  void push(SizeType index, const KeyType& key);
+
+  /**
+   * Lowers the key of `index` to `key`.
+   *
+   * @note `index` must be in the heap and `key` must not compare greater
+   * than its current key.
+   */
+  void decrease_key(SizeType index, const KeyType& key);
+
+  /**
+   * Inserts `index` if absent, otherwise lowers its key if `key` is smaller.
+   *
+   * @returns true if the heap was modified.
+   */
+  bool push_or_decrease(SizeType index, const KeyType& key);
+
+  /// Removes the id with the smallest key.
+  void pop();
+
+private:
+  static SizeType parent(SizeType pos) { return (pos - 1) / Arity; }
+  static SizeType first_child(SizeType pos) { return pos * Arity + 1; }
+
+  void sift_up(SizeType pos);
+  void sift_down(SizeType pos);
+  void place(SizeType pos, EntryType&& entry) {
+    m_position[entry.second] = pos;
+    m_heap[pos] = std::move(entry);
+  }
+
+private:
+  /// Heap ordered (key, id) entries.
+  Sequence<EntryType> m_heap;
+  /// Position of each id inside `m_heap`, `npos` if absent.
+  Sequence<SizeType> m_position;
+  CompareType m_compare;
+};
+
+template <typename KeyT, std::size_t Arity, typename CompareT>
+constexpr typename IndexedDaryHeap<KeyT, Arity, CompareT>::SizeType
+    IndexedDaryHeap<KeyT, Arity, CompareT>::npos;
+template <typename KeyT, std::size_t Arity, typename CompareT>
+constexpr typename IndexedDaryHeap<KeyT, Arity, CompareT>::SizeType
+    IndexedDaryHeap<KeyT, Arity, CompareT>::arity;
+
+template <typename KeyT, std::size_t Arity, typename CompareT>
+void IndexedDaryHeap<KeyT, Arity, CompareT>::reset(SizeType capacity) {
+  m_heap.clear();
+  m_heap.reserve(capacity);
+  m_position.assign(capacity, npos);
+}
+
+template <typename KeyT, std::size_t Arity, typename CompareT>
+void IndexedDaryHeap<KeyT, Arity, CompareT>::clear() {
+  for (const auto& entry : m_heap) {
+    m_position[entry.second] = npos;
+  }
+  m_heap.clear();
+}
+
+template <typename KeyT, std::size_t Arity, typename CompareT>
+void IndexedDaryHeap<KeyT, Arity, CompareT>::push(SizeType index,
+                                                  const KeyType& key) {
+  m_position[index] = m_heap.size();
+  m_heap.emplace_back(key, index);
+  sift_up(m_heap.size() - 1);
+}
+
+template <typename KeyT, std::size_t Arity, typename CompareT>
+void IndexedDaryHeap<KeyT, Arity, CompareT>::decrease_key(SizeType index,
+                                                          const KeyType& key) {
+  SizeType pos = m_position[index];
+  m_heap[pos].first = key;
+  sift_up(pos);
+}
+
+template <typename KeyT, std::size_t Arity, typename CompareT>
+bool IndexedDaryHeap<KeyT, Arity, CompareT>::push_or_decrease(
+    SizeType index, const KeyType& key) {
+  if (!contains(index)) {
+    push(index, key);
+    return true;
+  }
+  if (m_compare(key, this->key(index))) {
+    decrease_key(index, key);
+    return true;
+  }
+  return false;
+}
+
+template <typename KeyT, std::size_t Arity, typename CompareT>
+void IndexedDaryHeap<KeyT, Arity, CompareT>::pop() {
+  m_position[m_heap.front().second] = npos;
+  if (m_heap.size() == 1) {
+    m_heap.pop_back();
+    return;
+  }
+  EntryType last = std::move(m_heap.back());
+  m_heap.pop_back();
+  place(0, std::move(last));
+  sift_down(0);
+}
+
+template <typename KeyT, std::size_t Arity, typename CompareT>
+void IndexedDaryHeap<KeyT, Arity, CompareT>::sift_up(SizeType pos) {
+  EntryType entry = std::move(m_heap[pos]);
+  while (pos > 0) {
+    SizeType parent_pos = parent(pos);
+    if (!m_compare(entry.first, m_heap[parent_pos].first))
+      break;
+    place(pos, std::move(m_heap[parent_pos]));
+    pos = parent_pos;
+  }
+  place(pos, std::move(entry));
+}
+
+template <typename KeyT, std::size_t Arity, typename CompareT>
+void IndexedDaryHeap<KeyT, Arity, CompareT>::sift_down(SizeType pos) {
+  const SizeType sz = m_heap.size();
+  EntryType entry = std::move(m_heap[pos]);
+  while (true) {
+    SizeType child = first_child(pos);
+    if (child >= sz)
+      break;
+    // Find the smallest of at most `Arity` children.
+    SizeType last_child = child + Arity < sz ? child + Arity : sz;
+    SizeType best = child;
+    for (++child; child < last_child; ++child) {
+      if (m_compare(m_heap[child].first, m_heap[best].first))
+        best = child;
+    }
+    if (!m_compare(m_heap[best].first, entry.first))
+      break;
+    place(pos, std::move(m_heap[best]));
+    pos = best;
+  }
+  place(pos, std::move(entry));
+}
+
+} // namespace dragon
+
+#endif
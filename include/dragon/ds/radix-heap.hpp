@@ -0,0 +1,139 @@
+#ifndef DRAGON_DS_RADIX_HEAP_HPP
+#define DRAGON_DS_RADIX_HEAP_HPP
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "dragon/core/constants.hpp"
+#include "dragon/core/utils.hpp"
+
+namespace dragon {
+
+/**
+ * `RadixHeap` is a monotone priority queue for unsigned integer keys: a key
+ * pushed into the heap must not be smaller than the last key popped from it.
+ * This is always the case for the tentative distances of Dijkstra's algorithm
+ * on non-negative weights.
+ *
+ * An element lives in the bucket given by the highest bit in which its key
+ * differs from the last popped key, so each element moves between buckets at
+ * most `bits(KeyT)` times over its lifetime, and a push is O(1).
+ *
+ * @param KeyT unsigned integral type of keys.
+ * @param ValueT type of the values stored alongside keys.
+ */
+template <typename KeyT, typename ValueT> class RadixHeap {
+  static_assert(std::is_integral<KeyT>::value && std::is_unsigned<KeyT>::value,
+                "dragon::RadixHeap: KeyT must be an unsigned integral type");
+
+public:
+  using KeyType = KeyT;
+  using ValueType = ValueT;
+  using SizeType = std::size_t;
+  using EntryType = std::pair<KeyType, ValueType>;
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+  static constexpr SizeType num_of_buckets =
+      sizeof(KeyType) * details::bits_in_byte + 1;
+
+public:
+  RadixHeap() = default;
+  RadixHeap(const RadixHeap&) = default;
+  RadixHeap(RadixHeap&&) noexcept = default;
+  RadixHeap& operator=(const RadixHeap&) = default;
+  RadixHeap& operator=(RadixHeap&&) noexcept = default;
+  ~RadixHeap() = default;
+
+  SizeType size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  /**
+   * Inserts `value` with key `key`.
+   *
+   * @note `key` must not be smaller than the last popped key.
+   */
+  void push(KeyType key, const ValueType& value) {
+    m_buckets[bucket_index(key)].emplace_back(key, value);
+    ++m_size;
+  }
+
+  /// Removes and returns an entry with the smallest key.
+  EntryType pop();
+
+  /// Removes every element and resets the last popped key to zero.
+  void clear();
+
+private:
+  SizeType bucket_index(KeyType key) const {
+    return key == m_last ? 0 : highest_bit(key ^ m_last) + 1;
+  }
+
+  static SizeType highest_bit(KeyType x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return std::numeric_limits<unsigned long long>::digits - 1 -
+           __builtin_clzll(static_cast<unsigned long long>(x));
+#else
+    return static_cast<SizeType>(details::msb_pos(x));
+#endif
+  }
+
+  /// Moves the elements of the first non-empty bucket into lower buckets.
+  void redistribute();
+
+private:
+  std::array<Sequence<EntryType>, num_of_buckets> m_buckets;
+  KeyType m_last = 0;
+  SizeType m_size = 0;
+};
+
+template <typename KeyT, typename ValueT>
+constexpr typename RadixHeap<KeyT, ValueT>::SizeType
+    RadixHeap<KeyT, ValueT>::num_of_buckets;
+
+template <typename KeyT, typename ValueT>
+typename RadixHeap<KeyT, ValueT>::EntryType RadixHeap<KeyT, ValueT>::pop() {
+  if (m_buckets[0].empty()) {
+    redistribute();
+  }
+  EntryType top = std::move(m_buckets[0].back());
+  m_buckets[0].pop_back();
+  --m_size;
+  return top;
+}
+
+template <typename KeyT, typename ValueT>
+void RadixHeap<KeyT, ValueT>::redistribute() {
+  SizeType i = 1;
+  while (m_buckets[i].empty()) {
+    ++i;
+  }
+  auto& bucket = m_buckets[i];
+  KeyType new_last = bucket.front().first;
+  for (const auto& entry : bucket) {
+    if (entry.first < new_last)
+      new_last = entry.first;
+  }
+  m_last = new_last;
+  // Every key of bucket `i` now differs from `m_last` in a bit lower than
+  // `i - 1`, so entries only ever move to lower buckets.
+  for (auto& entry : bucket) {
+    m_buckets[bucket_index(entry.first)].push_back(std::move(entry));
+  }
+  bucket.clear();
+}
+
+template <typename KeyT, typename ValueT>
+void RadixHeap<KeyT, ValueT>::clear() {
+  for (auto& bucket : m_buckets) {
+    bucket.clear();
+  }
+  m_last = 0;
+  m_size = 0;
+}
+
+} // namespace dragon
+
+#endif
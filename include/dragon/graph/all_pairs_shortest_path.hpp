@@ -0,0 +1,119 @@
+#ifndef DRAGON_GRAPH_ALL_PAIRS_SHORTEST_PATH_HPP
+#define DRAGON_GRAPH_ALL_PAIRS_SHORTEST_PATH_HPP
+#include <limits>
+#include <vector>
+#include "dragon/core/thread-pool.hpp"
+#include "dragon/graph/batched_shortest_path.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/graph.hpp"
+#include "dragon/graph/shortest_path.hpp"
+
+namespace dragon {
+
+/**
+ * Johnson's all pairs shortest paths for sparse graphs whose edge weights
+ * may be negative, in O(V E + V (E + V) log V) instead of the O(V^2 E) of
+ * one Bellman-Ford run per source.
+ *
+ * Node potentials `h` are computed once with `spfa` from a virtual source
+ * linked to every node by a zero weight edge. Edge weights are then
+ * reweighted to `w(u, v) + h[u] - h[v]`, which is non-negative, into a CSR
+ * scratch copy of the graph, and one Dijkstra per source runs on it in
+ * parallel with `batched_djikstra`. Each row is mapped back to the original
+ * weights as it is produced.
+ *
+ * @param graph graph whose edge weights may be negative.
+ * @param distances receives the row-major `graph.size()` x `graph.size()`
+ * matrix of shortest path weights: `distances[u * graph.size() + v]` is the
+ * weight from `u` to `v`, `std::numeric_limits<EdgeValueType>::max()` if `v`
+ * is unreachable from `u`. Left empty if a negative cycle is found.
+ * @param negative_cycle receives the nodes of a negative weight cycle in edge
+ * order, or is left empty.
+ * @param pool threads running the Dijkstra passes.
+ * @returns false if the graph has a negative weight cycle.
+ */
+template <typename GraphT>
+bool johnson(const GraphT& graph,
+             std::vector<typename GraphT::EdgeValueType>& distances,
+             std::vector<typename GraphT::SizeType>& negative_cycle,
+             ThreadPool& pool) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  using CSRGraphType = CSRGraph<int, EdgeValueType>;
+  const auto inf_weight = std::numeric_limits<EdgeValueType>::max();
+  const SizeType sz = graph.size();
+  distances.clear();
+  negative_cycle.clear();
+
+  std::vector<typename CSRGraphType::Edge> edges;
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      edges.push_back({u.index(), edge.first, edge.second});
+    }
+  }
+  std::vector<EdgeValueType> potential;
+  {
+    // Node `sz` is the virtual source.
+    auto augmented_edges = edges;
+    for (SizeType v_i = 0; v_i < sz; ++v_i) {
+      augmented_edges.push_back({sz, v_i, EdgeValueType(0)});
+    }
+    CSRGraphType augmented(sz + 1, augmented_edges);
+    if (!spfa(augmented, potential, negative_cycle, sz))
+      return false;
+  }
+
+  for (auto& edge : edges) {
+    edge.weight = edge.weight + potential[edge.from] - potential[edge.to];
+    // Rounding may leave tiny negative weights with floating point types.
+    if (edge.weight < EdgeValueType(0))
+      edge.weight = EdgeValueType(0);
+  }
+  CSRGraphType reweighted(sz, edges);
+  edges = decltype(edges)();
+
+  std::vector<SizeType> sources(sz);
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    sources[u_i] = u_i;
+  }
+  distances.resize(sz * sz);
+  batched_djikstra(
+      reweighted, sources,
+      [&](SizeType u_i, const std::vector<EdgeValueType>& dist, SizeType) {
+        EdgeValueType* row = distances.data() + u_i * sz;
+        for (SizeType v_i = 0; v_i < sz; ++v_i) {
+          row[v_i] = dist[v_i] == inf_weight
+                         ? inf_weight
+                         : dist[v_i] + potential[v_i] - potential[u_i];
+        }
+      },
+      pool);
+  return true;
+}
+
+/**
+ * Same as above, for callers that only need to know whether a negative
+ * cycle exists.
+ */
+template <typename GraphT>
+bool johnson(const GraphT& graph,
+             std::vector<typename GraphT::EdgeValueType>& distances,
+             ThreadPool& pool) {
+  std::vector<typename GraphT::SizeType> negative_cycle;
+  return johnson(graph, distances, negative_cycle, pool);
+}
+
+/**
+ * Same as above, running on a temporary pool with one thread per hardware
+ * thread.
+ */
+template <typename GraphT>
+bool johnson(const GraphT& graph,
+             std::vector<typename GraphT::EdgeValueType>& distances) {
+  ThreadPool pool;
+  return johnson(graph, distances, pool);
+}
+
+} // namespace dragon
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef DRAGON_GRAPH_BATCHED_SHORTEST_PATH_HPP
+#define DRAGON_GRAPH_BATCHED_SHORTEST_PATH_HPP
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "dragon/core/thread-pool.hpp"
+#include "dragon/ds/indexed-d-ary-heap.hpp"
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+namespace details {
+/**
+ * Dijkstra from `source` writing into `dist`, which must hold
+ * `graph.size()` entries all equal to the maximum `EdgeValueType`. Appends
+ * every node whose distance was written to `touched`, so that the caller can
+ * reset `dist` in O(visited). `heap` must be empty and is left empty.
+ */
+template <typename GraphT, typename HeapT>
+void djikstra_into(const GraphT& graph, typename GraphT::SizeType source,
+                   typename GraphT::EdgeValueType* dist, HeapT& heap,
+                   std::vector<typename GraphT::SizeType>& touched) {
+  dist[source] = 0;
+  touched.push_back(source);
+  heap.push(source, 0);
+  while (!heap.empty()) {
+    auto u_i = heap.top();
+    auto d = heap.top_key();
+    heap.pop();
+    for (auto edge : graph[u_i].edges) {
+      auto temp_dist = d + edge.second;
+      auto& cur_dist = dist[edge.first];
+      if (!(temp_dist < cur_dist))
+        continue;
+      if (cur_dist == std::numeric_limits<decltype(temp_dist)>::max())
+        touched.push_back(edge.first);
+      cur_dist = temp_dist;
+      heap.push_or_decrease(edge.first, temp_dist);
+    }
+  }
+}
+
+/// Per thread scratch state of batched shortest path runs.
+template <typename SizeT, typename EdgeValueT> struct DjikstraScratch {
+  explicit DjikstraScratch(SizeT sz)
+      : dist(sz, std::numeric_limits<EdgeValueT>::max()), heap(sz) {}
+  std::vector<EdgeValueT> dist;
+  IndexedDaryHeap<EdgeValueT> heap;
+  std::vector<SizeT> touched;
+
+  /// Restores `dist` to all infinite in O(visited).
+  void reset() {
+    for (auto v_i : touched) {
+      dist[v_i] = std::numeric_limits<EdgeValueT>::max();
+    }
+    touched.clear();
+  }
+};
+} // namespace details
+
+/**
+ * Runs Dijkstra from every node of `sources`, spreading sources over the
+ * threads of `pool`, and writes the results into a row-major matrix:
+ * `distances[i * graph.size() + v]` is the shortest path weight from
+ * `sources[i]` to `v`, `std::numeric_limits<EdgeValueType>::max()` if `v` is
+ * unreachable.
+ *
+ * Every row is written in place, and each thread reuses one heap across all
+ * the sources it handles, so no allocation happens per source.
+ *
+ * @param distances caller provided buffer of
+ * `sources.size() * graph.size()` elements.
+ */
+template <typename GraphT>
+void batched_djikstra(const GraphT& graph,
+                      const std::vector<typename GraphT::SizeType>& sources,
+                      typename GraphT::EdgeValueType* distances,
+                      ThreadPool& pool) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  const SizeType sz = graph.size();
+  std::vector<IndexedDaryHeap<EdgeValueType>> heaps;
+  std::vector<std::vector<SizeType>> touched(pool.size());
+  heaps.reserve(pool.size());
+  for (SizeType i = 0; i < pool.size(); ++i) {
+    heaps.emplace_back(sz);
+  }
+  pool.parallel_for(
+      0, sources.size(),
+      [&](SizeType i, SizeType thread_index) {
+        EdgeValueType* row = distances + i * sz;
+        std::fill(row, row + sz, std::numeric_limits<EdgeValueType>::max());
+        details::djikstra_into(graph, sources[i], row, heaps[thread_index],
+                               touched[thread_index]);
+        touched[thread_index].clear();
+      },
+      1);
+}
+
+/**
+ * Runs Dijkstra from every node of `sources` on the threads of `pool` and
+ * streams the results instead of storing them: for every source,
+ * `callback(i, dist, thread_index)` is called with `i` the position of the
+ * source in `sources` and `dist` a `std::vector<EdgeValueType>` of
+ * shortest path weights, only valid during the call.
+ *
+ * Calls for different sources run concurrently, so `callback` must be
+ * thread safe; `thread_index` in `[0, pool.size())` can be used to index per
+ * thread accumulators. Each thread keeps one distance vector and one heap,
+ * reset in O(visited) between sources.
+ *
+ * @note Like any task of `ThreadPool`, `callback` must not throw.
+ */
+template <typename GraphT, typename CallbackT>
+void batched_djikstra(const GraphT& graph,
+                      const std::vector<typename GraphT::SizeType>& sources,
+                      CallbackT callback, ThreadPool& pool) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  using ScratchType = details::DjikstraScratch<SizeType, EdgeValueType>;
+  std::vector<ScratchType> scratch;
+  scratch.reserve(pool.size());
+  for (SizeType i = 0; i < pool.size(); ++i) {
+    scratch.emplace_back(graph.size());
+  }
+  pool.parallel_for(
+      0, sources.size(),
+      [&](SizeType i, SizeType thread_index) {
+        auto& local = scratch[thread_index];
+        details::djikstra_into(graph, sources[i], local.dist.data(),
+                               local.heap, local.touched);
+        const std::vector<EdgeValueType>& dist = local.dist;
+        callback(i, dist, thread_index);
+        local.reset();
+      },
+      1);
+}
+
+} // namespace dragon
+
+#endif
@@ -0,0 +1,337 @@
+#ifndef DRAGON_GRAPH_BFS_HPP
+#define DRAGON_GRAPH_BFS_HPP
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "dragon/core/thread-pool.hpp"
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+
+/**
+ * Direction optimizing parallel breadth first search (Beamer, Asanovic and
+ * Patterson) for repeated searches on the same graph.
+ *
+ * Each level is expanded either top-down, scanning the out-edges of the
+ * frontier, or bottom-up, letting every unvisited node scan its in-edges
+ * for a parent in the frontier and stop at the first one. Bottom-up steps
+ * win on the few huge middle levels of low diameter graphs, top-down steps
+ * everywhere else. The frontier is a node list for top-down steps and a
+ * bitmap for bottom-up steps. Both kinds of steps run in parallel on a
+ * `ThreadPool`.
+ *
+ * The constructor builds the in-edge lists in flat arrays, used by bottom-up
+ * steps. The graph must outlive the search object and must not change while
+ * it is in use.
+ *
+ * @param GraphT `Graph`, `CSRGraph` or any type with the same read interface.
+ */
+template <typename GraphT> class BreadthFirstSearch {
+public:
+  using SizeType = typename GraphT::SizeType;
+
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+  /// A top-down step switches to bottom-up once the frontier out-edges
+  /// exceed `1 / alpha` of the edges left to check.
+  static constexpr SizeType alpha = 15;
+  /// A bottom-up step switches back to top-down once the frontier shrinks
+  /// below `1 / beta` of the nodes.
+  static constexpr SizeType beta = 18;
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+  using WordType = std::uint64_t;
+  static constexpr SizeType word_bits = 64;
+
+public:
+  BreadthFirstSearch(const GraphT& graph, ThreadPool& pool);
+
+  BreadthFirstSearch(const BreadthFirstSearch&) = delete;
+  BreadthFirstSearch(BreadthFirstSearch&&) = delete;
+  BreadthFirstSearch& operator=(const BreadthFirstSearch&) = delete;
+  BreadthFirstSearch& operator=(BreadthFirstSearch&&) = delete;
+  ~BreadthFirstSearch() = default;
+
+  /**
+   * Searches from `source`, root of the graph by default. Results stay
+   * available through `depth()` and `parent()` until the next call.
+   */
+  void run(SizeType source = npos);
+
+  /// Returns the number of edges from the source to `v_i`, `npos` if `v_i`
+  /// is unreachable.
+  SizeType depth(SizeType v_i) const { return m_depth[v_i]; }
+
+  /// Returns the node `v_i` was discovered from, `npos` for the source and
+  /// unreachable nodes.
+  SizeType parent(SizeType v_i) const {
+    return m_parent[v_i].load(std::memory_order_relaxed);
+  }
+
+  /// Returns the number of nodes reached by the last search.
+  SizeType num_of_reached() const { return m_num_of_reached; }
+
+  /// Returns the number of bottom-up steps of the last search.
+  SizeType num_of_bottom_up_steps() const { return m_num_of_bottom_up_steps; }
+
+private:
+  /// Expands `m_frontier` top-down into a new list, returns the number of
+  /// out-edges of the new frontier.
+  SizeType top_down_step(SizeType level);
+  /// Expands `m_front_bits` bottom-up into `m_next_bits`, returns the number
+  /// of nodes of the new frontier.
+  SizeType bottom_up_step(SizeType level);
+  void list_to_bitmap();
+  void bitmap_to_list();
+  bool test(const Sequence<std::atomic<WordType>>& bits, SizeType v_i) const {
+    return (bits[v_i / word_bits].load(std::memory_order_relaxed) >>
+            (v_i % word_bits)) &
+           1;
+  }
+  /// Claims `v_i` for `u_i`, returns false if it was already visited.
+  bool claim(SizeType v_i, SizeType u_i) {
+    SizeType expected = npos;
+    if (m_parent[v_i].load(std::memory_order_relaxed) != npos)
+      return false;
+    return m_parent[v_i].compare_exchange_strong(expected, u_i,
+                                                 std::memory_order_relaxed);
+  }
+
+private:
+  const GraphT& m_graph;
+  ThreadPool& m_pool;
+  SizeType m_num_of_edges = 0;
+  /// In-edges of node `v` come from `m_in_sources[m_in_offsets[v]...]`.
+  Sequence<SizeType> m_in_offsets;
+  Sequence<SizeType> m_in_sources;
+
+  Sequence<SizeType> m_depth;
+  Sequence<std::atomic<SizeType>> m_parent;
+  Sequence<SizeType> m_frontier;
+  Sequence<Sequence<SizeType>> m_local_frontier;
+  Sequence<std::atomic<WordType>> m_front_bits, m_next_bits;
+  SizeType m_num_of_reached = 0;
+  SizeType m_num_of_bottom_up_steps = 0;
+};
+
+template <typename GraphT>
+constexpr typename BreadthFirstSearch<GraphT>::SizeType
+    BreadthFirstSearch<GraphT>::npos;
+template <typename GraphT>
+constexpr typename BreadthFirstSearch<GraphT>::SizeType
+    BreadthFirstSearch<GraphT>::alpha;
+template <typename GraphT>
+constexpr typename BreadthFirstSearch<GraphT>::SizeType
+    BreadthFirstSearch<GraphT>::beta;
+template <typename GraphT>
+constexpr typename BreadthFirstSearch<GraphT>::SizeType
+    BreadthFirstSearch<GraphT>::word_bits;
+
+template <typename GraphT>
+BreadthFirstSearch<GraphT>::BreadthFirstSearch(const GraphT& graph,
+                                               ThreadPool& pool)
+    : m_graph(graph), m_pool(pool), m_in_offsets(graph.size() + 1, 0),
+      m_depth(graph.size(), npos), m_parent(graph.size()),
+      m_local_frontier(pool.size()),
+      m_front_bits((graph.size() + word_bits - 1) / word_bits),
+      m_next_bits(m_front_bits.size()) {
+  const SizeType sz = graph.size();
+  {
+    Sequence<std::atomic<SizeType>> in_degree(sz);
+    pool.parallel_for(0, sz, [&](SizeType v_i, SizeType) {
+      in_degree[v_i].store(0, std::memory_order_relaxed);
+    });
+    pool.parallel_for(0, sz, [&](SizeType u_i, SizeType) {
+      for (auto edge : graph[u_i].edges) {
+        in_degree[edge.first].fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+    for (SizeType v_i = 0; v_i < sz; ++v_i) {
+      m_in_offsets[v_i + 1] =
+          m_in_offsets[v_i] + in_degree[v_i].load(std::memory_order_relaxed);
+    }
+    m_num_of_edges = m_in_offsets.back();
+    m_in_sources.resize(m_num_of_edges);
+    // Reuse the counters as insertion positions.
+    pool.parallel_for(0, sz, [&](SizeType v_i, SizeType) {
+      in_degree[v_i].store(m_in_offsets[v_i], std::memory_order_relaxed);
+    });
+    pool.parallel_for(0, sz, [&](SizeType u_i, SizeType) {
+      for (auto edge : graph[u_i].edges) {
+        m_in_sources[in_degree[edge.first].fetch_add(
+            1, std::memory_order_relaxed)] = u_i;
+      }
+    });
+  }
+}
+
+template <typename GraphT>
+typename BreadthFirstSearch<GraphT>::SizeType
+BreadthFirstSearch<GraphT>::top_down_step(SizeType level) {
+  Sequence<SizeType> out_degree(m_pool.size(), 0);
+  m_pool.parallel_for(0, m_frontier.size(), [&](SizeType i,
+                                                SizeType thread_index) {
+    SizeType u_i = m_frontier[i];
+    for (auto edge : m_graph[u_i].edges) {
+      SizeType v_i = edge.first;
+      if (claim(v_i, u_i)) {
+        m_depth[v_i] = level + 1;
+        m_local_frontier[thread_index].push_back(v_i);
+        out_degree[thread_index] += m_graph[v_i].edges.size();
+      }
+    }
+  });
+  m_frontier.clear();
+  SizeType scout_count = 0;
+  for (SizeType t = 0; t < m_pool.size(); ++t) {
+    m_frontier.insert(m_frontier.end(), m_local_frontier[t].begin(),
+                      m_local_frontier[t].end());
+    m_local_frontier[t].clear();
+    scout_count += out_degree[t];
+  }
+  return scout_count;
+}
+
+template <typename GraphT>
+typename BreadthFirstSearch<GraphT>::SizeType
+BreadthFirstSearch<GraphT>::bottom_up_step(SizeType level) {
+  const SizeType sz = m_graph.size();
+  Sequence<SizeType> awake(m_pool.size(), 0);
+  // Every task owns whole words of `m_next_bits`.
+  m_pool.parallel_for(0, m_next_bits.size(), [&](SizeType w,
+                                                 SizeType thread_index) {
+    WordType word = 0;
+    SizeType last = std::min(sz, (w + 1) * word_bits);
+    for (SizeType v_i = w * word_bits; v_i < last; ++v_i) {
+      if (m_parent[v_i].load(std::memory_order_relaxed) != npos)
+        continue;
+      for (SizeType e = m_in_offsets[v_i]; e < m_in_offsets[v_i + 1]; ++e) {
+        SizeType u_i = m_in_sources[e];
+        if (test(m_front_bits, u_i)) {
+          m_parent[v_i].store(u_i, std::memory_order_relaxed);
+          m_depth[v_i] = level + 1;
+          word |= WordType(1) << (v_i - w * word_bits);
+          ++awake[thread_index];
+          break;
+        }
+      }
+    }
+    m_next_bits[w].store(word, std::memory_order_relaxed);
+  });
+  m_front_bits.swap(m_next_bits);
+  SizeType awake_count = 0;
+  for (auto count : awake) {
+    awake_count += count;
+  }
+  return awake_count;
+}
+
+template <typename GraphT> void BreadthFirstSearch<GraphT>::list_to_bitmap() {
+  m_pool.parallel_for(0, m_front_bits.size(), [&](SizeType w, SizeType) {
+    m_front_bits[w].store(0, std::memory_order_relaxed);
+  });
+  m_pool.parallel_for(0, m_frontier.size(), [&](SizeType i, SizeType) {
+    SizeType v_i = m_frontier[i];
+    m_front_bits[v_i / word_bits].fetch_or(WordType(1) << (v_i % word_bits),
+                                           std::memory_order_relaxed);
+  });
+}
+
+template <typename GraphT> void BreadthFirstSearch<GraphT>::bitmap_to_list() {
+  m_pool.parallel_for(0, m_front_bits.size(), [&](SizeType w,
+                                                  SizeType thread_index) {
+    WordType word = m_front_bits[w].load(std::memory_order_relaxed);
+    for (SizeType bit = 0; word != 0; ++bit, word >>= 1) {
+      if (word & 1)
+        m_local_frontier[thread_index].push_back(w * word_bits + bit);
+    }
+  });
+  m_frontier.clear();
+  for (auto& local : m_local_frontier) {
+    m_frontier.insert(m_frontier.end(), local.begin(), local.end());
+    local.clear();
+  }
+}
+
+template <typename GraphT>
+void BreadthFirstSearch<GraphT>::run(SizeType source) {
+  if (source == npos)
+    source = m_graph.root();
+  const SizeType sz = m_graph.size();
+  m_pool.parallel_for(0, sz, [&](SizeType v_i, SizeType) {
+    m_depth[v_i] = npos;
+    m_parent[v_i].store(npos, std::memory_order_relaxed);
+  });
+  // The source is its own parent during the search, so that it counts as
+  // visited.
+  m_parent[source].store(source, std::memory_order_relaxed);
+  m_depth[source] = 0;
+  m_frontier.assign(1, source);
+  m_num_of_reached = 1;
+  m_num_of_bottom_up_steps = 0;
+
+  SizeType edges_to_check = m_num_of_edges;
+  SizeType scout_count = m_graph[source].edges.size();
+  SizeType level = 0;
+  while (!m_frontier.empty()) {
+    if (scout_count > edges_to_check / alpha) {
+      list_to_bitmap();
+      SizeType awake_count = m_frontier.size(), old_awake_count;
+      do {
+        old_awake_count = awake_count;
+        awake_count = bottom_up_step(level++);
+        m_num_of_reached += awake_count;
+        ++m_num_of_bottom_up_steps;
+      } while (awake_count != 0 &&
+               (awake_count >= old_awake_count || awake_count > sz / beta));
+      bitmap_to_list();
+      scout_count = 1;
+    } else {
+      edges_to_check -= std::min(edges_to_check, scout_count);
+      scout_count = top_down_step(level++);
+      m_num_of_reached += m_frontier.size();
+    }
+  }
+  m_parent[source].store(npos, std::memory_order_relaxed);
+}
+
+/**
+ * Hop distances from `source` with `BreadthFirstSearch`, `npos` for
+ * unreachable nodes.
+ *
+ * @param parent receives the node each node was discovered from, `npos` for
+ * the source and unreachable nodes.
+ */
+template <typename GraphT>
+std::vector<typename GraphT::SizeType>
+bfs(const GraphT& graph, std::vector<typename GraphT::SizeType>& parent,
+    ThreadPool& pool, typename GraphT::SizeType source = GraphT::npos) {
+  using SizeType = typename GraphT::SizeType;
+  BreadthFirstSearch<GraphT> search(graph, pool);
+  search.run(source);
+  std::vector<SizeType> depth(graph.size());
+  parent.resize(graph.size());
+  pool.parallel_for(0, graph.size(), [&](SizeType v_i, SizeType) {
+    depth[v_i] = search.depth(v_i);
+    parent[v_i] = search.parent(v_i);
+  });
+  return depth;
+}
+
+/**
+ * Same as above, running on a temporary pool with one thread per hardware
+ * thread.
+ */
+template <typename GraphT>
+std::vector<typename GraphT::SizeType>
+bfs(const GraphT& graph, std::vector<typename GraphT::SizeType>& parent,
+    typename GraphT::SizeType source = GraphT::npos) {
+  ThreadPool pool;
+  return bfs(graph, parent, pool, source);
+}
+
+} // namespace dragon
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef DRAGON_GRAPH_BIPARTITE_MATCHING_HPP
+#define DRAGON_GRAPH_BIPARTITE_MATCHING_HPP
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+namespace details {
+/**
+ * Keeps a parameter out of template argument deduction, so that node
+ * counts given as literals convert to the index type of the edges.
+ */
+template <typename T> struct NonDeduced { using Type = T; };
+
+/**
+ * Hopcroft-Karp on a left to right adjacency in CSR form: the neighbours of
+ * left node `u` are `targets[offsets[u]]` to `targets[offsets[u + 1] - 1]`.
+ * `left_mate` and `right_mate` receive the matching, `npos` for unmatched
+ * nodes. Returns the size of the matching.
+ */
+template <typename SizeT>
+SizeT hopcroft_karp_csr(SizeT num_of_left, SizeT num_of_right,
+                        const std::vector<SizeT>& offsets,
+                        const std::vector<SizeT>& targets,
+                        std::vector<SizeT>& left_mate,
+                        std::vector<SizeT>& right_mate) {
+  const SizeT npos = std::numeric_limits<SizeT>::max();
+  left_mate.assign(num_of_left, npos);
+  right_mate.assign(num_of_right, npos);
+  SizeT matched = 0;
+
+  // Greedy initial matching, usually most of the final one.
+  for (SizeT u_i = 0; u_i < num_of_left; ++u_i) {
+    for (SizeT a = offsets[u_i]; a < offsets[u_i + 1]; ++a) {
+      if (right_mate[targets[a]] == npos) {
+        left_mate[u_i] = targets[a];
+        right_mate[targets[a]] = u_i;
+        ++matched;
+        break;
+      }
+    }
+  }
+
+  // Right to left adjacency, for the layering.
+  std::vector<SizeT> in_offsets(num_of_right + 1, 0), sources(targets.size());
+  for (SizeT a = 0; a < targets.size(); ++a) {
+    ++in_offsets[targets[a] + 1];
+  }
+  for (SizeT v_i = 0; v_i < num_of_right; ++v_i) {
+    in_offsets[v_i + 1] += in_offsets[v_i];
+  }
+  {
+    std::vector<SizeT> position(in_offsets.begin(), in_offsets.end() - 1);
+    for (SizeT u_i = 0; u_i < num_of_left; ++u_i) {
+      for (SizeT a = offsets[u_i]; a < offsets[u_i + 1]; ++a) {
+        sources[position[targets[a]]++] = u_i;
+      }
+    }
+  }
+
+  std::vector<SizeT> dist(num_of_left), queue, current(num_of_left), stack;
+  queue.reserve(num_of_left);
+  while (true) {
+    // Layers of left nodes by the number of left nodes on a shortest
+    // alternating path to a free right node, searching backwards from the
+    // free right nodes until the first layer holding free left nodes.
+    // Layering from the far end leaves the depth first search only edges
+    // that lead to a free right node.
+    std::fill(dist.begin(), dist.end(), npos);
+    queue.clear();
+    for (SizeT v_i = 0; v_i < num_of_right; ++v_i) {
+      if (right_mate[v_i] != npos)
+        continue;
+      for (SizeT a = in_offsets[v_i]; a < in_offsets[v_i + 1]; ++a) {
+        if (dist[sources[a]] == npos) {
+          dist[sources[a]] = 1;
+          queue.push_back(sources[a]);
+        }
+      }
+    }
+    SizeT limit = npos;
+    for (SizeT head = 0; head < queue.size(); ++head) {
+      SizeT u_i = queue[head];
+      if (dist[u_i] >= limit)
+        break;
+      SizeT v_i = left_mate[u_i];
+      if (v_i == npos) {
+        limit = dist[u_i];
+        continue;
+      }
+      for (SizeT a = in_offsets[v_i]; a < in_offsets[v_i + 1]; ++a) {
+        if (dist[sources[a]] == npos) {
+          dist[sources[a]] = dist[u_i] + 1;
+          queue.push_back(sources[a]);
+        }
+      }
+    }
+    if (limit == npos)
+      break;
+
+    // Vertex disjoint shortest augmenting paths, by depth first search down
+    // the layers with an explicit stack of left nodes. Each left node keeps
+    // a current arc, and nodes that lead nowhere or were used leave the
+    // layers.
+    for (SizeT u_i : queue) {
+      current[u_i] = offsets[u_i];
+    }
+    for (SizeT s : queue) {
+      if (dist[s] != limit || left_mate[s] != npos)
+        continue;
+      stack.assign(1, s);
+      while (!stack.empty()) {
+        SizeT u_i = stack.back();
+        SizeT& a = current[u_i];
+        bool advanced = false;
+        for (; a < offsets[u_i + 1]; ++a) {
+          SizeT w_i = right_mate[targets[a]];
+          if (dist[u_i] == 1 && w_i == npos) {
+            // Augment: every left node of the stack takes the right node
+            // its current arc points to.
+            for (SizeT x_i : stack) {
+              SizeT v_i = targets[current[x_i]];
+              left_mate[x_i] = v_i;
+              right_mate[v_i] = x_i;
+              dist[x_i] = npos;
+            }
+            ++matched;
+            stack.clear();
+            advanced = true;
+            break;
+          }
+          if (w_i != npos && dist[w_i] + 1 == dist[u_i]) {
+            stack.push_back(w_i);
+            advanced = true;
+            break;
+          }
+        }
+        if (advanced)
+          continue;
+        dist[u_i] = npos;
+        stack.pop_back();
+        if (!stack.empty())
+          ++current[stack.back()];
+      }
+    }
+  }
+  return matched;
+}
+} // namespace details
+
+/**
+ * Maximum matching of a bipartite graph given as a list of edges from left
+ * nodes `[0, num_of_left)` to right nodes `[0, num_of_right)`, with the
+ * Hopcroft-Karp algorithm in O(E sqrt(V)).
+ *
+ * The edges are laid out in flat arrays, in both directions. A greedy pass
+ * first matches every left node it can. Each phase then layers the graph
+ * with a breadth first search from the free right nodes, and augments along
+ * a maximal set of vertex disjoint shortest augmenting paths, found with an
+ * iterative depth first search from the free left nodes.
+ *
+ * @param edges `(left, right)` pairs, duplicates are allowed.
+ * @param left_mate receives the right node matched with each left node,
+ * `npos` if unmatched.
+ * @param right_mate receives the left node matched with each right node,
+ * `npos` if unmatched.
+ * @returns the number of matched pairs.
+ */
+template <typename SizeT>
+SizeT hopcroft_karp(typename details::NonDeduced<SizeT>::Type num_of_left,
+                    typename details::NonDeduced<SizeT>::Type num_of_right,
+                    const std::vector<std::pair<SizeT, SizeT>>& edges,
+                    std::vector<SizeT>& left_mate,
+                    std::vector<SizeT>& right_mate) {
+  std::vector<SizeT> offsets(num_of_left + 1, 0), targets(edges.size());
+  for (const auto& edge : edges) {
+    ++offsets[edge.first + 1];
+  }
+  for (SizeT u_i = 0; u_i < num_of_left; ++u_i) {
+    offsets[u_i + 1] += offsets[u_i];
+  }
+  std::vector<SizeT> position(offsets.begin(), offsets.end() - 1);
+  for (const auto& edge : edges) {
+    targets[position[edge.first]++] = edge.second;
+  }
+  return details::hopcroft_karp_csr(num_of_left, num_of_right, offsets,
+                                    targets, left_mate, right_mate);
+}
+
+/**
+ * Splits the nodes of `graph` into two sides such that every edge joins
+ * both sides, by 2-coloring each weakly connected component from its
+ * smallest node, which goes to the left side. O(V + E).
+ *
+ * @param left receives true for the nodes of the left side.
+ * @returns false if the graph is not bipartite, leaving `left` in an
+ * unspecified state.
+ */
+template <typename GraphT>
+bool bipartition(const GraphT& graph, std::vector<bool>& left) {
+  using SizeType = typename GraphT::SizeType;
+  const SizeType sz = graph.size();
+  // Edges are followed in both directions.
+  std::vector<SizeType> offsets(sz + 1, 0), targets;
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      ++offsets[u.index() + 1];
+      ++offsets[edge.first + 1];
+    }
+  }
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    offsets[u_i + 1] += offsets[u_i];
+  }
+  targets.resize(offsets[sz]);
+  std::vector<SizeType> position(offsets.begin(), offsets.end() - 1);
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      targets[position[u.index()]++] = edge.first;
+      targets[position[edge.first]++] = u.index();
+    }
+  }
+
+  left.assign(sz, false);
+  std::vector<bool> colored(sz, false);
+  std::vector<SizeType> queue;
+  for (SizeType s = 0; s < sz; ++s) {
+    if (colored[s])
+      continue;
+    colored[s] = true;
+    left[s] = true;
+    queue.assign(1, s);
+    for (SizeType head = 0; head < queue.size(); ++head) {
+      SizeType u_i = queue[head];
+      for (SizeType a = offsets[u_i]; a < offsets[u_i + 1]; ++a) {
+        SizeType v_i = targets[a];
+        if (!colored[v_i]) {
+          colored[v_i] = true;
+          left[v_i] = !left[u_i];
+          queue.push_back(v_i);
+        } else if (left[v_i] == left[u_i]) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Maximum matching of a bipartite `graph` with the Hopcroft-Karp algorithm,
+ * see above. Edges may be stored in either or both directions, and edges
+ * between two nodes of the same side are ignored.
+ *
+ * @param left side of every node, e.g. from `bipartition`.
+ * @param mate receives the node matched with each node, `npos` if
+ * unmatched.
+ * @returns the number of matched pairs.
+ */
+template <typename GraphT>
+typename GraphT::SizeType
+hopcroft_karp(const GraphT& graph, const std::vector<bool>& left,
+              std::vector<typename GraphT::SizeType>& mate) {
+  using SizeType = typename GraphT::SizeType;
+  const SizeType sz = graph.size();
+  // Local indices of the nodes within their side.
+  std::vector<SizeType> local(sz), left_nodes, right_nodes;
+  for (SizeType v_i = 0; v_i < sz; ++v_i) {
+    std::vector<SizeType>& side = left[v_i] ? left_nodes : right_nodes;
+    local[v_i] = side.size();
+    side.push_back(v_i);
+  }
+  std::vector<std::pair<SizeType, SizeType>> edges;
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      SizeType u_i = u.index(), v_i = edge.first;
+      if (left[u_i] && !left[v_i])
+        edges.emplace_back(local[u_i], local[v_i]);
+      else if (!left[u_i] && left[v_i])
+        edges.emplace_back(local[v_i], local[u_i]);
+    }
+  }
+  std::vector<SizeType> left_mate, right_mate;
+  SizeType matched =
+      hopcroft_karp(static_cast<SizeType>(left_nodes.size()),
+                    static_cast<SizeType>(right_nodes.size()), edges,
+                    left_mate, right_mate);
+  mate.assign(sz, GraphT::npos);
+  for (SizeType l = 0; l < left_nodes.size(); ++l) {
+    if (left_mate[l] != GraphT::npos) {
+      mate[left_nodes[l]] = right_nodes[left_mate[l]];
+      mate[right_nodes[left_mate[l]]] = left_nodes[l];
+    }
+  }
+  return matched;
+}
+
+} // namespace dragon
+
+#endif
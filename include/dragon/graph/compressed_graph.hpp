@@ -0,0 +1,434 @@
+#ifndef DRAGON_GRAPH_COMPRESSED_GRAPH_HPP
+#define DRAGON_GRAPH_COMPRESSED_GRAPH_HPP
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dragon {
+namespace details {
+/// Appends `value` as a LEB128 varint: 7 bits per byte, low bits first.
+inline void varint_write(std::vector<std::uint8_t>& bytes,
+                         std::uint64_t value) {
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+/// Reads a LEB128 varint and moves `data` past it.
+inline std::uint64_t varint_read(const std::uint8_t*& data) {
+  std::uint64_t value = *data++;
+  if (value < 0x80)
+    return value;
+  value &= 0x7f;
+  for (unsigned shift = 7;; shift += 7) {
+    const std::uint64_t byte = *data++;
+    value |= (byte & 0x7f) << shift;
+    if (byte < 0x80)
+      return value;
+  }
+}
+
+/// Maps signed integers to unsigned ones, small magnitudes first.
+inline std::uint64_t zigzag_encode(std::int64_t value) {
+  return (static_cast<std::uint64_t>(value) << 1) ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t zigzag_decode(std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1) ^
+         -static_cast<std::int64_t>(value & 1);
+}
+
+/// Unsigned integral weights are stored as varints.
+template <typename T>
+void weight_write(std::vector<std::uint8_t>& bytes, T weight,
+                  std::true_type /* integral */, std::false_type /* signed */) {
+  varint_write(bytes, static_cast<std::uint64_t>(weight));
+}
+
+template <typename T>
+T weight_read(const std::uint8_t*& data, std::true_type /* integral */,
+              std::false_type /* signed */) {
+  return static_cast<T>(varint_read(data));
+}
+
+/// Signed integral weights are stored as zigzag varints.
+template <typename T>
+void weight_write(std::vector<std::uint8_t>& bytes, T weight,
+                  std::true_type /* integral */, std::true_type /* signed */) {
+  varint_write(bytes, zigzag_encode(static_cast<std::int64_t>(weight)));
+}
+
+template <typename T>
+T weight_read(const std::uint8_t*& data, std::true_type /* integral */,
+              std::true_type /* signed */) {
+  return static_cast<T>(zigzag_decode(varint_read(data)));
+}
+
+/// Other weights are stored as their raw bytes.
+template <typename T, typename SignedT>
+void weight_write(std::vector<std::uint8_t>& bytes, const T& weight,
+                  std::false_type /* integral */, SignedT /* signed */) {
+  const auto* raw = reinterpret_cast<const std::uint8_t*>(&weight);
+  bytes.insert(bytes.end(), raw, raw + sizeof(T));
+}
+
+template <typename T, typename SignedT>
+T weight_read(const std::uint8_t*& data, std::false_type /* integral */,
+              SignedT /* signed */) {
+  T weight;
+  std::memcpy(&weight, data, sizeof(T));
+  data += sizeof(T);
+  return weight;
+}
+
+/**
+ * Read-only view over the out-edges of one node of a `CompressedGraph`,
+ * decoded on the fly while iterating. Iterators are forward only, and
+ * dereferencing one yields a `std::pair<target, weight>` by value, so code
+ * written against `Graph::Node::edges` works unchanged as long as it only
+ * walks the edges.
+ */
+template <typename SizeT, typename EdgeValueT> class CompressedEdgeRange {
+public:
+  using SizeType = SizeT;
+  using EdgeValueType = EdgeValueT;
+  using value_type = std::pair<SizeType, EdgeValueType>; // NOLINT
+  using size_type = SizeType;                            // NOLINT
+
+  class iterator { // NOLINT
+  public:
+    using iterator_category = std::forward_iterator_tag; // NOLINT
+    using value_type = CompressedEdgeRange::value_type;  // NOLINT
+    using difference_type = std::ptrdiff_t;              // NOLINT
+    using reference = const value_type&;                 // NOLINT
+    using pointer = const value_type*;                   // NOLINT
+
+    iterator() = default;
+    iterator(const std::uint8_t* data, SizeType remaining, SizeType source)
+        : m_data(data), m_remaining(remaining) {
+      if (m_remaining > 0) {
+        // The first target is stored relative to the source node.
+        m_edge.first = static_cast<SizeType>(
+            static_cast<std::int64_t>(source) +
+            zigzag_decode(varint_read(m_data)));
+        read_weight();
+      }
+    }
+
+    reference operator*() const { return m_edge; }
+    pointer operator->() const { return &m_edge; }
+
+    iterator& operator++() {
+      if (--m_remaining > 0) {
+        // Targets are sorted and distinct, so gaps are at least 1.
+        m_edge.first += static_cast<SizeType>(varint_read(m_data)) + 1;
+        read_weight();
+      }
+      return *this;
+    }
+    iterator operator++(int) {
+      auto temp = *this;
+      ++*this;
+      return temp;
+    }
+
+    /// Iterators of the same range are equal when as many edges remain.
+    friend bool operator==(const iterator& a, const iterator& b) {
+      return a.m_remaining == b.m_remaining;
+    }
+    friend bool operator!=(const iterator& a, const iterator& b) {
+      return a.m_remaining != b.m_remaining;
+    }
+
+  private:
+    void read_weight() {
+      m_edge.second = weight_read<EdgeValueType>(
+          m_data, std::is_integral<EdgeValueType>(),
+          std::is_signed<EdgeValueType>());
+    }
+
+    const std::uint8_t* m_data = nullptr;
+    SizeType m_remaining = 0;
+    value_type m_edge;
+  };
+  using const_iterator = iterator; // NOLINT
+
+public:
+  /**
+   * @param data encoded row, starting with its number of edges.
+   * @param source node the edges leave from.
+   */
+  CompressedEdgeRange(const std::uint8_t* data, SizeType source)
+      : m_data(data), m_source(source) {
+    m_size = static_cast<SizeType>(varint_read(m_data));
+  }
+
+  iterator begin() const { return {m_data, m_size, m_source}; }
+  iterator end() const { return {}; }
+  iterator cbegin() const { return begin(); }
+  iterator cend() const { return end(); }
+
+  SizeType size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  /**
+   * Returns an iterator to the edge towards `v_i`, or `end()` if absent,
+   * decoding the row up to it.
+   */
+  iterator find(SizeType v_i) const {
+    for (auto it = begin(); it != end(); ++it) {
+      if (it->first >= v_i)
+        return it->first == v_i ? it : end();
+    }
+    return end();
+  }
+
+  /// Returns 1 if an edge towards `v_i` exists, 0 otherwise.
+  SizeType count(SizeType v_i) const { return find(v_i) != end() ? 1 : 0; }
+
+  /**
+   * Returns the weight of the edge towards `v_i`.
+   *
+   * @throws std::out_of_range if no such edge exists.
+   */
+  EdgeValueType at(SizeType v_i) const {
+    auto it = find(v_i);
+    if (it == end())
+      throw std::out_of_range("dragon::CompressedGraph: edge does not exist");
+    return it->second;
+  }
+
+private:
+  const std::uint8_t* m_data;
+  SizeType m_source;
+  SizeType m_size;
+};
+} // namespace details
+
+/**
+ * `CompressedGraph` is an immutable graph whose adjacency lists are
+ * compressed, for graphs too large for `Graph` or even `CSRGraph`.
+ *
+ * The out-edges of every node are sorted by target and stored as one byte
+ * stream: the number of edges, then for each edge the gap to the previous
+ * target and the weight, all as LEB128 varints. The first target is stored
+ * relative to the node itself (zigzag encoded, since it may be smaller), so
+ * graphs with locality, e.g. after `reorder`, get mostly one byte gaps.
+ * Signed weights are zigzag encoded, and non-integral weights are stored as
+ * raw bytes. A byte offset per node gives random access to the rows.
+ *
+ * `CompressedGraph` exposes the same read interface as `Graph`
+ * (`graph[u].edges`, `graph[u].value`, `graph[u].index()`, iteration over
+ * nodes, `size()`, `root()`), so algorithms that walk the edges of a node,
+ * such as `bfs` or `djikstra`, accept it too. Edges are decoded on the fly,
+ * and looking up one edge with `find`, `count` or `at` costs O(degree).
+ *
+ * @param ValueT type of value of graph nodes.
+ * @param EdgeValueT type of weight of graph edges, trivially copyable.
+ */
+template <typename ValueT, typename EdgeValueT = int> class CompressedGraph {
+public:
+  using ValueType = ValueT;
+  using EdgeValueType = EdgeValueT;
+  using SizeType = std::size_t;
+  using AdjacencyStructureType =
+      details::CompressedEdgeRange<SizeType, EdgeValueType>;
+
+  using size_type = SizeType; // NOLINT
+
+  static_assert(std::is_trivially_copyable<EdgeValueType>::value,
+                "dragon::CompressedGraph: edge weights must be trivially "
+                "copyable");
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+
+public:
+  /**
+   * `Node` is a lightweight read-only view of a node of the graph.
+   */
+  class Node {
+  public:
+    Node(SizeType index, const ValueType& p_value,
+         AdjacencyStructureType p_edges)
+        : value(p_value), edges(p_edges), m_index(index) {}
+
+    SizeType index() const { return m_index; }
+    const ValueType& value;
+    AdjacencyStructureType edges;
+
+  private:
+    SizeType m_index;
+  };
+
+  class const_iterator { // NOLINT
+  public:
+    using iterator_category = std::forward_iterator_tag; // NOLINT
+    using value_type = Node;                             // NOLINT
+    using difference_type = std::ptrdiff_t;              // NOLINT
+    using reference = Node;                              // NOLINT
+    using pointer = void;                                // NOLINT
+
+    const_iterator(const CompressedGraph* graph, SizeType index)
+        : m_graph(graph), m_index(index) {}
+    Node operator*() const { return (*m_graph)[m_index]; }
+    const_iterator& operator++() {
+      ++m_index;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto temp = *this;
+      ++m_index;
+      return temp;
+    }
+    friend bool operator==(const const_iterator& a, const const_iterator& b) {
+      return a.m_index == b.m_index;
+    }
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) {
+      return a.m_index != b.m_index;
+    }
+
+  private:
+    const CompressedGraph* m_graph;
+    SizeType m_index;
+  };
+  using iterator = const_iterator; // NOLINT
+
+public:
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+  static constexpr EdgeValueType
+      nweight = std::numeric_limits<EdgeValueType>::max();
+
+public:
+  /// Builds a graph with `sz` nodes and no edges.
+  CompressedGraph(SizeType sz = 0, SizeType root = 0);
+
+  /**
+   * Builds a compressed copy of `graph` (a `Graph`, a `CSRGraph` or anything
+   * with the same read interface), keeping node values, edge weights and
+   * the root. Rows are sorted by target first if needed.
+   */
+  template <typename GraphT, typename = std::enable_if_t<
+                                 std::is_class<GraphT>::value>>
+  explicit CompressedGraph(const GraphT& graph);
+
+  CompressedGraph(const CompressedGraph&) = default;
+  CompressedGraph(CompressedGraph&&) noexcept = default;
+  CompressedGraph& operator=(const CompressedGraph&) = default;
+  CompressedGraph& operator=(CompressedGraph&&) noexcept = default;
+  ~CompressedGraph() = default;
+
+  /// Returns a view of the ith node of the graph.
+  Node operator[](SizeType index) const {
+    return Node(index, m_values[index], edges(index));
+  }
+
+  /// Returns the out-edges of the ith node of the graph.
+  AdjacencyStructureType edges(SizeType index) const {
+    return AdjacencyStructureType(m_bytes.data() + m_offsets[index], index);
+  }
+
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator end() const { return {this, size()}; }
+  const_iterator cend() const { return end(); }
+
+  /// Returns the number of nodes in the graph.
+  SizeType size() const { return m_values.size(); }
+
+  /// Returns the number of directed edges in the graph.
+  SizeType num_edges() const { return m_num_of_edges; }
+
+  /// Returns the out-degree of the ith node.
+  SizeType degree(SizeType index) const { return edges(index).size(); }
+
+  /// Returns the index of the root node.
+  SizeType root() const { return m_root; }
+
+  /// Returns the number of bytes of the encoded rows.
+  SizeType num_bytes() const { return m_bytes.size(); }
+
+  /**
+   * Returns the number of bytes used by the graph: encoded rows, row
+   * offsets and node values.
+   */
+  SizeType memory_usage() const {
+    return m_bytes.capacity() + m_offsets.capacity() * sizeof(SizeType) +
+           m_values.capacity() * sizeof(ValueType) + sizeof(*this);
+  }
+
+private:
+  /// `m_offsets[u]` is the position of the row of node `u` in `m_bytes`.
+  Sequence<SizeType> m_offsets;
+  /// Encoded rows.
+  Sequence<std::uint8_t> m_bytes;
+  /// Value of each node.
+  Sequence<ValueType> m_values;
+  SizeType m_num_of_edges = 0;
+  /// Stores index of the root node.
+  SizeType m_root;
+};
+
+template <typename ValueT, typename EdgeValueT>
+constexpr typename CompressedGraph<ValueT, EdgeValueT>::SizeType
+    CompressedGraph<ValueT, EdgeValueT>::npos;
+template <typename ValueT, typename EdgeValueT>
+constexpr typename CompressedGraph<ValueT, EdgeValueT>::EdgeValueType
+    CompressedGraph<ValueT, EdgeValueT>::nweight;
+
+template <typename ValueT, typename EdgeValueT>
+CompressedGraph<ValueT, EdgeValueT>::CompressedGraph(SizeType sz,
+                                                     SizeType root)
+    : m_offsets(sz), m_bytes(sz, 0), m_values(sz), m_root(root) {
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    m_offsets[u_i] = u_i;
+  }
+}
+
+template <typename ValueT, typename EdgeValueT>
+template <typename GraphT, typename>
+CompressedGraph<ValueT, EdgeValueT>::CompressedGraph(const GraphT& graph)
+    : m_root(graph.root()) {
+  const SizeType sz = graph.size();
+  m_offsets.reserve(sz);
+  m_values.reserve(sz);
+  Sequence<std::pair<SizeType, EdgeValueType>> row;
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    const auto& u = graph[u_i];
+    m_offsets.push_back(m_bytes.size());
+    m_values.push_back(u.value);
+    row.assign(u.edges.begin(), u.edges.end());
+    auto by_target = [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    };
+    if (!std::is_sorted(row.begin(), row.end(), by_target))
+      std::sort(row.begin(), row.end(), by_target);
+    details::varint_write(m_bytes, row.size());
+    for (SizeType a = 0; a < row.size(); ++a) {
+      if (a == 0)
+        details::varint_write(
+            m_bytes, details::zigzag_encode(static_cast<std::int64_t>(
+                         row[a].first - u_i)));
+      else
+        details::varint_write(m_bytes, row[a].first - row[a - 1].first - 1);
+      details::weight_write(m_bytes, row[a].second,
+                            std::is_integral<EdgeValueType>(),
+                            std::is_signed<EdgeValueType>());
+    }
+    m_num_of_edges += row.size();
+  }
+  m_bytes.shrink_to_fit();
+}
+
+} // namespace dragon
+
+#endif
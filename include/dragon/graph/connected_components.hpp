@@ -0,0 +1,153 @@
+#ifndef DRAGON_GRAPH_CONNECTED_COMPONENTS_HPP
+#define DRAGON_GRAPH_CONNECTED_COMPONENTS_HPP
+#include <atomic>
+#include <iterator>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "dragon/core/thread-pool.hpp"
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+namespace details {
+/**
+ * Lock free union of the trees of `u_i` and `v_i` in the parent forest
+ * `comp`, always hooking the larger root under the smaller one, so that
+ * every root is the smallest node of its tree.
+ */
+template <typename SizeT>
+void afforest_link(std::vector<std::atomic<SizeT>>& comp, SizeT u_i,
+                   SizeT v_i) {
+  SizeT p1 = comp[u_i].load(std::memory_order_relaxed);
+  SizeT p2 = comp[v_i].load(std::memory_order_relaxed);
+  while (p1 != p2) {
+    SizeT high = p1 < p2 ? p2 : p1, low = p1 < p2 ? p1 : p2;
+    SizeT p_high = comp[high].load(std::memory_order_relaxed);
+    if (p_high == low)
+      break;
+    if (p_high == high && comp[high].compare_exchange_strong(
+                              p_high, low, std::memory_order_relaxed))
+      break;
+    p1 = comp[comp[high].load(std::memory_order_relaxed)].load(
+        std::memory_order_relaxed);
+    p2 = comp[low].load(std::memory_order_relaxed);
+  }
+}
+
+/// Points every node of `comp` directly at its root.
+template <typename SizeT>
+void afforest_compress(std::vector<std::atomic<SizeT>>& comp,
+                       ThreadPool& pool) {
+  pool.parallel_for(0, comp.size(), [&](SizeT v_i, SizeT) {
+    SizeT p = comp[v_i].load(std::memory_order_relaxed);
+    while (p != comp[p].load(std::memory_order_relaxed)) {
+      p = comp[p].load(std::memory_order_relaxed);
+      comp[v_i].store(p, std::memory_order_relaxed);
+    }
+  });
+}
+} // namespace details
+
+/**
+ * Parallel connected components of an undirected graph with the Afforest
+ * algorithm (Sutton, Ben-Nun and Barak), working directly on node indices.
+ *
+ * Every node first links along its first two edges only, which already
+ * merges most of the graph into one large component. That component is
+ * found by sampling, and in the final pass its nodes skip their remaining
+ * edges, while all other nodes link along all of theirs. Links are lock
+ * free compare-and-swap hooks on a shared parent forest, interleaved with
+ * parallel path compression.
+ *
+ * @param graph undirected graph, i.e. every edge `u -> v` comes with
+ * `v -> u`, as `Graph::add_undirected_edge` stores them.
+ * @param sizes receives the number of nodes of each component.
+ * @param pool threads to run on.
+ * @returns the component of every node, components are numbered from 0 in
+ * order of their smallest node.
+ */
+template <typename GraphT>
+std::vector<typename GraphT::SizeType>
+connected_components(const GraphT& graph,
+                     std::vector<typename GraphT::SizeType>& sizes,
+                     ThreadPool& pool) {
+  using SizeType = typename GraphT::SizeType;
+  const SizeType sz = graph.size();
+  const SizeType neighbor_rounds = 2;
+  const SizeType num_of_samples = 1024;
+
+  std::vector<std::atomic<SizeType>> comp(sz);
+  pool.parallel_for(0, sz, [&](SizeType v_i, SizeType) {
+    comp[v_i].store(v_i, std::memory_order_relaxed);
+  });
+
+  for (SizeType r = 0; r < neighbor_rounds; ++r) {
+    pool.parallel_for(0, sz, [&](SizeType u_i, SizeType) {
+      const auto& edges = graph[u_i].edges;
+      if (r < edges.size())
+        details::afforest_link(comp, u_i, std::next(edges.begin(), r)->first);
+    });
+    details::afforest_compress(comp, pool);
+  }
+
+  // The most frequent root among a few random nodes is very likely the
+  // root of the largest component.
+  SizeType largest = 0;
+  if (sz > 0) {
+    std::mt19937_64 rng(sz);
+    std::uniform_int_distribution<SizeType> node(0, sz - 1);
+    std::unordered_map<SizeType, SizeType> count;
+    SizeType best_count = 0;
+    for (SizeType i = 0; i < num_of_samples; ++i) {
+      SizeType root = comp[node(rng)].load(std::memory_order_relaxed);
+      if (++count[root] > best_count) {
+        best_count = count[root];
+        largest = root;
+      }
+    }
+  }
+
+  pool.parallel_for(0, sz, [&](SizeType u_i, SizeType) {
+    if (comp[u_i].load(std::memory_order_relaxed) == largest)
+      return;
+    const auto& edges = graph[u_i].edges;
+    if (edges.size() <= neighbor_rounds)
+      return;
+    for (auto it = std::next(edges.begin(), neighbor_rounds);
+         it != edges.end(); ++it) {
+      details::afforest_link(comp, u_i, it->first);
+    }
+  });
+  details::afforest_compress(comp, pool);
+
+  // Roots are the smallest nodes of their components.
+  std::vector<SizeType> component(sz);
+  sizes.clear();
+  for (SizeType v_i = 0; v_i < sz; ++v_i) {
+    SizeType root = comp[v_i].load(std::memory_order_relaxed);
+    if (root == v_i) {
+      component[v_i] = sizes.size();
+      sizes.push_back(0);
+    } else {
+      component[v_i] = component[root];
+    }
+    ++sizes[component[v_i]];
+  }
+  return component;
+}
+
+/**
+ * Same as above, running on a temporary pool with one thread per hardware
+ * thread.
+ */
+template <typename GraphT>
+std::vector<typename GraphT::SizeType>
+connected_components(const GraphT& graph,
+                     std::vector<typename GraphT::SizeType>& sizes) {
+  ThreadPool pool;
+  return connected_components(graph, sizes, pool);
+}
+
+} // namespace dragon
+
+#endif
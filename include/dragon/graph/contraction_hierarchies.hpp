@@ -0,0 +1,510 @@
+#ifndef DRAGON_GRAPH_CONTRACTION_HIERARCHIES_HPP
+#define DRAGON_GRAPH_CONTRACTION_HIERARCHIES_HPP
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "dragon/ds/indexed-d-ary-heap.hpp"
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+namespace details {
+/**
+ * Node contraction phase of `ContractionHierarchy`. Keeps a growing arc set
+ * (original edges plus shortcuts) with in and out lists per node, and
+ * contracts nodes one by one in order of edge difference.
+ */
+template <typename EdgeValueT> class CHContractor {
+public:
+  using EdgeValueType = EdgeValueT;
+  using SizeType = std::size_t;
+  using PriorityType = long long;
+
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+
+  struct Arc {
+    SizeType node;
+    EdgeValueType weight;
+    /// Contracted node this shortcut bypasses, `npos` for original edges.
+    SizeType middle;
+  };
+
+  template <typename GraphT>
+  CHContractor(const GraphT& graph, SizeType witness_settle_limit)
+      : out(graph.size()), in(graph.size()),
+        m_deleted_neighbors(graph.size(), 0), m_dist(graph.size()),
+        m_stamp(graph.size(), 0), m_target_stamp(graph.size(), 0),
+        m_heap(graph.size()), m_witness_settle_limit(witness_settle_limit) {
+    for (const auto& u : graph) {
+      for (auto edge : u.edges) {
+        if (edge.first != u.index())
+          add_arc(u.index(), edge.first, edge.second, npos);
+      }
+    }
+  }
+
+  /// Contracts every node, returns the rank (contraction order) of each.
+  std::vector<SizeType> contract_all() {
+    const SizeType sz = out.size();
+    IndexedDaryHeap<PriorityType> queue(sz);
+    for (SizeType v_i = 0; v_i < sz; ++v_i) {
+      queue.push(v_i, priority(v_i));
+    }
+    std::vector<SizeType> rank(sz, 0);
+    SizeType next_rank = 0;
+    while (!queue.empty()) {
+      SizeType v_i = queue.top();
+      queue.pop();
+      // Lazy update: priorities go stale as neighbours get contracted.
+      PriorityType p = priority(v_i);
+      if (!queue.empty() && queue.top_key() < p) {
+        queue.push(v_i, p);
+        continue;
+      }
+      shortcuts(v_i, true);
+      rank[v_i] = next_rank++;
+      // Detach `v_i` from the remaining graph. Its own lists are frozen and
+      // only lead to nodes contracted later, i.e. of higher rank.
+      for (const auto& arc : out[v_i]) {
+        ++m_deleted_neighbors[arc.node];
+        remove_arc(in[arc.node], v_i);
+      }
+      for (const auto& arc : in[v_i]) {
+        ++m_deleted_neighbors[arc.node];
+        remove_arc(out[arc.node], v_i);
+      }
+    }
+    return rank;
+  }
+
+  /**
+   * Out and in arcs of every node. Once a node is contracted its lists only
+   * hold arcs to and from higher ranked nodes.
+   */
+  std::vector<std::vector<Arc>> out, in;
+
+private:
+  /// Edge difference plus the number of already contracted neighbours.
+  PriorityType priority(SizeType v_i) {
+    auto removed = static_cast<PriorityType>(out[v_i].size() + in[v_i].size());
+    return static_cast<PriorityType>(shortcuts(v_i, false)) - removed +
+           static_cast<PriorityType>(m_deleted_neighbors[v_i]);
+  }
+
+  /**
+   * Returns the number of shortcuts needed to contract `v_i`, and adds them
+   * if `add` is true. A shortcut u -> w replaces u -> v_i -> w unless a
+   * witness search from `u` that avoids `v_i` finds a path no longer than
+   * it.
+   */
+  SizeType shortcuts(SizeType v_i, bool add) {
+    SizeType count = 0;
+    const auto& in_arcs = in[v_i];
+    const auto& out_arcs = out[v_i];
+    if (in_arcs.empty() || out_arcs.empty())
+      return 0;
+    EdgeValueType max_out = 0;
+    for (const auto& arc : out_arcs) {
+      max_out = std::max(max_out, arc.weight);
+    }
+    for (const auto& in_arc : in_arcs) {
+      SizeType u_i = in_arc.node;
+      ++m_search;
+      SizeType num_of_targets = 0;
+      for (const auto& out_arc : out_arcs) {
+        if (out_arc.node != u_i && m_target_stamp[out_arc.node] != m_search) {
+          m_target_stamp[out_arc.node] = m_search;
+          ++num_of_targets;
+        }
+      }
+      witness_search(u_i, v_i, in_arc.weight + max_out, num_of_targets);
+      for (const auto& out_arc : out_arcs) {
+        SizeType w_i = out_arc.node;
+        if (w_i == u_i)
+          continue;
+        EdgeValueType via = in_arc.weight + out_arc.weight;
+        if (m_stamp[w_i] == m_search && !(via < m_dist[w_i]))
+          continue;
+        ++count;
+        if (add)
+          add_arc(u_i, w_i, via, v_i);
+      }
+    }
+    return count;
+  }
+
+  /**
+   * Bounded Dijkstra from `source` over uncontracted nodes except `avoid`.
+   * Stops past distance `limit`, after settling the witness settle limit,
+   * or once all `num_of_targets` nodes marked in `m_target_stamp` are
+   * settled.
+   */
+  void witness_search(SizeType source, SizeType avoid, EdgeValueType limit,
+                      SizeType num_of_targets) {
+    m_heap.clear();
+    m_stamp[source] = m_search;
+    m_dist[source] = 0;
+    m_heap.push(source, 0);
+    SizeType settled = 0;
+    while (!m_heap.empty() && settled < m_witness_settle_limit) {
+      SizeType u_i = m_heap.top();
+      EdgeValueType d = m_heap.top_key();
+      m_heap.pop();
+      if (limit < d)
+        break;
+      ++settled;
+      if (m_target_stamp[u_i] == m_search && --num_of_targets == 0)
+        break;
+      for (const auto& arc : out[u_i]) {
+        if (arc.node == avoid)
+          continue;
+        EdgeValueType temp_dist = d + arc.weight;
+        if (m_stamp[arc.node] != m_search) {
+          m_stamp[arc.node] = m_search;
+          m_dist[arc.node] = temp_dist;
+          m_heap.push(arc.node, temp_dist);
+        } else if (temp_dist < m_dist[arc.node] &&
+                   m_heap.contains(arc.node)) {
+          m_dist[arc.node] = temp_dist;
+          m_heap.decrease_key(arc.node, temp_dist);
+        }
+      }
+    }
+  }
+
+  static void remove_arc(std::vector<Arc>& arcs, SizeType node) {
+    for (auto& arc : arcs) {
+      if (arc.node == node) {
+        arc = arcs.back();
+        arcs.pop_back();
+        return;
+      }
+    }
+  }
+
+  /// Adds arc u -> w, or lowers the weight of an existing one.
+  void add_arc(SizeType u_i, SizeType w_i, EdgeValueType weight,
+               SizeType middle) {
+    for (auto& arc : out[u_i]) {
+      if (arc.node != w_i)
+        continue;
+      if (weight < arc.weight) {
+        arc.weight = weight;
+        arc.middle = middle;
+        for (auto& back_arc : in[w_i]) {
+          if (back_arc.node == u_i) {
+            back_arc.weight = weight;
+            back_arc.middle = middle;
+          }
+        }
+      }
+      return;
+    }
+    out[u_i].push_back({w_i, weight, middle});
+    in[w_i].push_back({u_i, weight, middle});
+  }
+
+private:
+  std::vector<SizeType> m_deleted_neighbors;
+  /// Timestamped scratch state of witness searches.
+  std::vector<EdgeValueType> m_dist;
+  std::vector<SizeType> m_stamp;
+  /// Nodes whose witness distance the current search must settle.
+  std::vector<SizeType> m_target_stamp;
+  SizeType m_search = 0;
+  IndexedDaryHeap<EdgeValueType> m_heap;
+  SizeType m_witness_settle_limit;
+};
+
+template <typename EdgeValueT>
+constexpr typename CHContractor<EdgeValueT>::SizeType
+    CHContractor<EdgeValueT>::npos;
+} // namespace details
+
+/**
+ * `ContractionHierarchy` answers source to target shortest path queries on
+ * large, mostly static graphs with non-negative edge weights (e.g. road
+ * networks) by exploring only a tiny part of the graph.
+ *
+ * Preprocessing contracts nodes one at a time, in order of edge difference
+ * (shortcuts added minus edges removed, plus contracted neighbours), and
+ * inserts a shortcut u -> w for every path u -> v -> w through the
+ * contracted node `v` that a bounded witness search cannot prove redundant.
+ * The position of a node in that order is its rank.
+ *
+ * A query runs a bidirectional Dijkstra in which the forward search only
+ * follows arcs to higher ranked nodes and the backward search only follows
+ * arcs from higher ranked nodes. `path()` unpacks shortcuts recursively into
+ * the original edges.
+ *
+ * The hierarchy keeps its own copy of the search graph, so the input graph
+ * may be discarded after construction.
+ *
+ * @param EdgeValueT type of edge weights.
+ */
+template <typename EdgeValueT> class ContractionHierarchy {
+public:
+  using EdgeValueType = EdgeValueT;
+  using SizeType = std::size_t;
+
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+  static constexpr EdgeValueType inf_weight =
+      std::numeric_limits<EdgeValueType>::max();
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+  using ArcType = typename details::CHContractor<EdgeValueType>::Arc;
+
+  struct Search {
+    explicit Search(SizeType sz)
+        : dist(sz), parent(sz), stamp(sz, 0), heap(sz) {}
+    Sequence<EdgeValueType> dist;
+    Sequence<SizeType> parent;
+    Sequence<SizeType> stamp;
+    IndexedDaryHeap<EdgeValueType> heap;
+  };
+
+public:
+  /**
+   * Preprocesses `graph`.
+   *
+   * @param graph `Graph` or any type with the same read interface.
+   * @param witness_settle_limit maximum number of nodes settled by one
+   * witness search. Lower values speed up preprocessing but may add
+   * superfluous shortcuts; queries stay exact either way.
+   */
+  template <typename GraphT>
+  explicit ContractionHierarchy(const GraphT& graph,
+                                SizeType witness_settle_limit = 500);
+
+  /**
+   * Returns the weight of the shortest path from `source` to `target`,
+   * `inf_weight` if there is none.
+   */
+  EdgeValueType query(SizeType source, SizeType target);
+
+  /**
+   * Returns the nodes of the shortest path found by the last query, in the
+   * original graph, from source to target. Empty if the target was
+   * unreachable.
+   */
+  Sequence<SizeType> path() const;
+
+  /// Returns the number of nodes.
+  SizeType size() const { return m_rank.size(); }
+
+  /// Returns the contraction order position of node `v_i`.
+  SizeType rank(SizeType v_i) const { return m_rank[v_i]; }
+
+  /// Returns the number of shortcut arcs in the search graph.
+  SizeType num_of_shortcuts() const { return m_num_of_shortcuts; }
+
+  /// Returns the number of nodes settled by the last query.
+  SizeType num_of_settled() const { return m_num_of_settled; }
+
+private:
+  bool reached(const Search& search, SizeType v_i) const {
+    return search.stamp[v_i] == m_query;
+  }
+  void relax(Search& search, SizeType u_i, SizeType v_i, EdgeValueType d);
+  /// Settles the top node of `search`, following `arcs`.
+  void settle(Search& search, const Search& other,
+              const Sequence<SizeType>& offsets, const Sequence<ArcType>& arcs,
+              EdgeValueType& best);
+  /// Returns the arc u -> w of the search graph.
+  const ArcType& find_arc(SizeType u_i, SizeType w_i) const;
+  /// Appends the original nodes of arc u -> w, except `u_i`, to `nodes`.
+  void unpack(SizeType u_i, SizeType w_i, Sequence<SizeType>& nodes) const;
+
+private:
+  /// Upward arcs u -> w (rank[u] < rank[w]), stored in the row of `u`.
+  Sequence<SizeType> m_up_offsets;
+  Sequence<ArcType> m_up;
+  /// Downward arcs u -> w (rank[u] > rank[w]), stored in the row of `w`
+  /// with `node == u`, so that the backward search also climbs ranks.
+  Sequence<SizeType> m_down_offsets;
+  Sequence<ArcType> m_down;
+  Sequence<SizeType> m_rank;
+  SizeType m_num_of_shortcuts = 0;
+
+  Search m_forward;
+  Search m_backward;
+  SizeType m_query = 0;
+  SizeType m_meet = npos;
+  SizeType m_num_of_settled = 0;
+};
+
+template <typename EdgeValueT>
+constexpr typename ContractionHierarchy<EdgeValueT>::SizeType
+    ContractionHierarchy<EdgeValueT>::npos;
+template <typename EdgeValueT>
+constexpr typename ContractionHierarchy<EdgeValueT>::EdgeValueType
+    ContractionHierarchy<EdgeValueT>::inf_weight;
+
+template <typename EdgeValueT>
+template <typename GraphT>
+ContractionHierarchy<EdgeValueT>::ContractionHierarchy(
+    const GraphT& graph, SizeType witness_settle_limit)
+    : m_forward(graph.size()), m_backward(graph.size()) {
+  const SizeType sz = graph.size();
+  details::CHContractor<EdgeValueType> contractor(graph, witness_settle_limit);
+  m_rank = contractor.contract_all();
+
+  // After contraction the out list of a node holds exactly its upward arcs
+  // and its in list exactly the downward arcs ending at it.
+  m_up_offsets.assign(sz + 1, 0);
+  m_down_offsets.assign(sz + 1, 0);
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    m_up_offsets[u_i + 1] = m_up_offsets[u_i] + contractor.out[u_i].size();
+    m_down_offsets[u_i + 1] = m_down_offsets[u_i] + contractor.in[u_i].size();
+  }
+  m_up.reserve(m_up_offsets.back());
+  m_down.reserve(m_down_offsets.back());
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    m_up.insert(m_up.end(), contractor.out[u_i].begin(),
+                contractor.out[u_i].end());
+    m_down.insert(m_down.end(), contractor.in[u_i].begin(),
+                  contractor.in[u_i].end());
+  }
+  for (const auto& arc : m_up) {
+    m_num_of_shortcuts += arc.middle != npos;
+  }
+  for (const auto& arc : m_down) {
+    m_num_of_shortcuts += arc.middle != npos;
+  }
+  // Sorted rows let `find_arc` binary search while unpacking.
+  auto by_node = [](const ArcType& a, const ArcType& b) {
+    return a.node < b.node;
+  };
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    std::sort(m_up.begin() + m_up_offsets[u_i],
+              m_up.begin() + m_up_offsets[u_i + 1], by_node);
+    std::sort(m_down.begin() + m_down_offsets[u_i],
+              m_down.begin() + m_down_offsets[u_i + 1], by_node);
+  }
+}
+
+template <typename EdgeValueT>
+void ContractionHierarchy<EdgeValueT>::relax(Search& search, SizeType u_i,
+                                             SizeType v_i, EdgeValueType d) {
+  if (!reached(search, v_i)) {
+    search.stamp[v_i] = m_query;
+    search.dist[v_i] = d;
+    search.parent[v_i] = u_i;
+    search.heap.push(v_i, d);
+  } else if (d < search.dist[v_i]) {
+    search.dist[v_i] = d;
+    search.parent[v_i] = u_i;
+    search.heap.decrease_key(v_i, d);
+  }
+}
+
+template <typename EdgeValueT>
+void ContractionHierarchy<EdgeValueT>::settle(
+    Search& search, const Search& other, const Sequence<SizeType>& offsets,
+    const Sequence<ArcType>& arcs, EdgeValueType& best) {
+  SizeType u_i = search.heap.top();
+  search.heap.pop();
+  ++m_num_of_settled;
+  EdgeValueType d = search.dist[u_i];
+  if (reached(other, u_i) && d + other.dist[u_i] < best) {
+    best = d + other.dist[u_i];
+    m_meet = u_i;
+  }
+  for (SizeType e = offsets[u_i]; e < offsets[u_i + 1]; ++e) {
+    relax(search, u_i, arcs[e].node, d + arcs[e].weight);
+  }
+}
+
+template <typename EdgeValueT>
+typename ContractionHierarchy<EdgeValueT>::EdgeValueType
+ContractionHierarchy<EdgeValueT>::query(SizeType source, SizeType target) {
+  ++m_query;
+  m_meet = npos;
+  m_num_of_settled = 0;
+  m_forward.heap.clear();
+  m_backward.heap.clear();
+  relax(m_forward, npos, source, 0);
+  relax(m_backward, npos, target, 0);
+  EdgeValueType best = inf_weight;
+
+  // Unlike plain bidirectional Dijkstra the searches cannot stop when they
+  // first meet: each side runs until its smallest key reaches `best`.
+  while (true) {
+    bool forward_open =
+        !m_forward.heap.empty() && m_forward.heap.top_key() < best;
+    bool backward_open =
+        !m_backward.heap.empty() && m_backward.heap.top_key() < best;
+    if (!forward_open && !backward_open)
+      break;
+    if (forward_open &&
+        (!backward_open ||
+         !(m_backward.heap.top_key() < m_forward.heap.top_key())))
+      settle(m_forward, m_backward, m_up_offsets, m_up, best);
+    else
+      settle(m_backward, m_forward, m_down_offsets, m_down, best);
+  }
+  return best;
+}
+
+template <typename EdgeValueT>
+const typename ContractionHierarchy<EdgeValueT>::ArcType&
+ContractionHierarchy<EdgeValueT>::find_arc(SizeType u_i, SizeType w_i) const {
+  auto by_node = [](const ArcType& arc, SizeType node) {
+    return arc.node < node;
+  };
+  if (m_rank[u_i] < m_rank[w_i]) {
+    return *std::lower_bound(m_up.begin() + m_up_offsets[u_i],
+                             m_up.begin() + m_up_offsets[u_i + 1], w_i,
+                             by_node);
+  }
+  return *std::lower_bound(m_down.begin() + m_down_offsets[w_i],
+                           m_down.begin() + m_down_offsets[w_i + 1], u_i,
+                           by_node);
+}
+
+template <typename EdgeValueT>
+void ContractionHierarchy<EdgeValueT>::unpack(SizeType u_i, SizeType w_i,
+                                              Sequence<SizeType>& nodes) const {
+  // Explicit stack of arcs still to unpack, last one on top.
+  Sequence<std::pair<SizeType, SizeType>> stack = {{u_i, w_i}};
+  while (!stack.empty()) {
+    auto arc_ends = stack.back();
+    stack.pop_back();
+    SizeType middle = find_arc(arc_ends.first, arc_ends.second).middle;
+    if (middle == npos) {
+      nodes.push_back(arc_ends.second);
+      continue;
+    }
+    stack.emplace_back(middle, arc_ends.second);
+    stack.emplace_back(arc_ends.first, middle);
+  }
+}
+
+template <typename EdgeValueT>
+std::vector<typename ContractionHierarchy<EdgeValueT>::SizeType>
+ContractionHierarchy<EdgeValueT>::path() const {
+  Sequence<SizeType> nodes;
+  if (m_meet == npos)
+    return nodes;
+  // Upward part: source -> ... -> meet, collected backwards.
+  Sequence<SizeType> up_chain;
+  for (SizeType u_i = m_meet; u_i != npos; u_i = m_forward.parent[u_i]) {
+    up_chain.push_back(u_i);
+  }
+  std::reverse(up_chain.begin(), up_chain.end());
+  nodes.push_back(up_chain.front());
+  for (SizeType i = 0; i + 1 < up_chain.size(); ++i) {
+    unpack(up_chain[i], up_chain[i + 1], nodes);
+  }
+  // Downward part: meet -> ... -> target.
+  for (SizeType u_i = m_meet; m_backward.parent[u_i] != npos;
+       u_i = m_backward.parent[u_i]) {
+    unpack(u_i, m_backward.parent[u_i], nodes);
+  }
+  return nodes;
+}
+
+} // namespace dragon
+
+#endif
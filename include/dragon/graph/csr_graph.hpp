@@ -0,0 +1,424 @@
+#ifndef DRAGON_GRAPH_CSR_GRAPH_HPP
+#define DRAGON_GRAPH_CSR_GRAPH_HPP
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+namespace details {
+/**
+ * Read-only view over the out-edges of one node of a compressed sparse row
+ * graph. Targets and weights live in two separate contiguous arrays, and
+ * dereferencing an iterator yields a `std::pair<target, weight>` by value, so
+ * code written against `Graph::Node::edges` works unchanged.
+ *
+ * Targets of a row are sorted in increasing order.
+ */
+template <typename SizeT, typename EdgeValueT> class CSREdgeRange {
+public:
+  using SizeType = SizeT;
+  using EdgeValueType = EdgeValueT;
+  using value_type = std::pair<SizeType, EdgeValueType>; // NOLINT
+  using size_type = SizeType;                            // NOLINT
+
+  class iterator { // NOLINT
+  public:
+    using iterator_category = std::random_access_iterator_tag; // NOLINT
+    using value_type = CSREdgeRange::value_type;               // NOLINT
+    using difference_type = std::ptrdiff_t;                    // NOLINT
+    using reference = value_type;                              // NOLINT
+
+    /// Proxy so that `it->first` and `it->second` work on a by-value pair.
+    struct pointer { // NOLINT
+      value_type edge;
+      const value_type* operator->() const { return &edge; }
+    };
+
+    iterator() = default;
+    iterator(const SizeType* target, const EdgeValueType* weight)
+        : m_target(target), m_weight(weight) {}
+
+    value_type operator*() const { return {*m_target, *m_weight}; }
+    pointer operator->() const { return {**this}; }
+    value_type operator[](difference_type n) const { return *(*this + n); }
+
+    SizeType target() const { return *m_target; }
+    EdgeValueType weight() const { return *m_weight; }
+
+    iterator& operator++() {
+      ++m_target;
+      ++m_weight;
+      return *this;
+    }
+    iterator operator++(int) {
+      auto temp = *this;
+      ++*this;
+      return temp;
+    }
+    iterator& operator--() {
+      --m_target;
+      --m_weight;
+      return *this;
+    }
+    iterator operator--(int) {
+      auto temp = *this;
+      --*this;
+      return temp;
+    }
+    iterator& operator+=(difference_type n) {
+      m_target += n;
+      m_weight += n;
+      return *this;
+    }
+    iterator& operator-=(difference_type n) { return *this += -n; }
+    friend iterator operator+(iterator it, difference_type n) {
+      return it += n;
+    }
+    friend iterator operator+(difference_type n, iterator it) {
+      return it += n;
+    }
+    friend iterator operator-(iterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const iterator& a, const iterator& b) {
+      return a.m_target - b.m_target;
+    }
+    friend bool operator==(const iterator& a, const iterator& b) {
+      return a.m_target == b.m_target;
+    }
+    friend bool operator!=(const iterator& a, const iterator& b) {
+      return a.m_target != b.m_target;
+    }
+    friend bool operator<(const iterator& a, const iterator& b) {
+      return a.m_target < b.m_target;
+    }
+    friend bool operator>(const iterator& a, const iterator& b) {
+      return b < a;
+    }
+    friend bool operator<=(const iterator& a, const iterator& b) {
+      return !(b < a);
+    }
+    friend bool operator>=(const iterator& a, const iterator& b) {
+      return !(a < b);
+    }
+
+  private:
+    const SizeType* m_target = nullptr;
+    const EdgeValueType* m_weight = nullptr;
+  };
+  using const_iterator = iterator; // NOLINT
+
+public:
+  CSREdgeRange(const SizeType* targets, const EdgeValueType* weights,
+               SizeType sz)
+      : m_targets(targets), m_weights(weights), m_size(sz) {}
+
+  iterator begin() const { return {m_targets, m_weights}; }
+  iterator end() const { return {m_targets + m_size, m_weights + m_size}; }
+  iterator cbegin() const { return begin(); }
+  iterator cend() const { return end(); }
+
+  SizeType size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  /// Returns an iterator to the edge towards `v_i`, or `end()` if absent.
+  iterator find(SizeType v_i) const {
+    auto target = std::lower_bound(m_targets, m_targets + m_size, v_i);
+    if (target == m_targets + m_size || *target != v_i)
+      return end();
+    return begin() + (target - m_targets);
+  }
+
+  /// Returns 1 if an edge towards `v_i` exists, 0 otherwise.
+  SizeType count(SizeType v_i) const { return find(v_i) != end() ? 1 : 0; }
+
+  /**
+   * Returns the weight of the edge towards `v_i`.
+   *
+   * @throws std::out_of_range if no such edge exists.
+   */
+  EdgeValueType at(SizeType v_i) const {
+    auto it = find(v_i);
+    if (it == end())
+      throw std::out_of_range("dragon::CSRGraph: edge does not exist");
+    return it.weight();
+  }
+
+  const SizeType* targets() const { return m_targets; }
+  const EdgeValueType* weights() const { return m_weights; }
+
+private:
+  const SizeType* m_targets;
+  const EdgeValueType* m_weights;
+  SizeType m_size;
+};
+} // namespace details
+
+/**
+ * `CSRGraph` is an immutable graph stored in compressed sparse row format:
+ * an offsets array of size `size() + 1` and two contiguous arrays holding the
+ * target and the weight of every edge. Out-edges of node `u` occupy the
+ * half-open range `[offsets()[u], offsets()[u + 1])`, sorted by target.
+ *
+ * `CSRGraph` exposes the same read interface as `Graph` (`graph[u].edges`,
+ * `graph[u].value`, `graph[u].index()`, iteration over nodes, `size()`,
+ * `root()`), so algorithms templated on `GraphT` accept either type.
+ *
+ * @param ValueT type of value of graph nodes.
+ * @param EdgeValueT type of weight of graph edges.
+ *
+ * @note `CSRGraph` do not support multiple edges between the same nodes.
+ */
+template <typename ValueT, typename EdgeValueT = int> class CSRGraph {
+public:
+  using ValueType = ValueT;
+  using EdgeValueType = EdgeValueT;
+  using SizeType = std::size_t;
+  using AdjacencyStructureType = details::CSREdgeRange<SizeType, EdgeValueType>;
+
+  using size_type = SizeType; // NOLINT
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+
+public:
+  /// An edge `from` -> `to` with weight `weight`, used for building graphs.
+  struct Edge {
+    SizeType from;
+    SizeType to;
+    EdgeValueType weight;
+  };
+
+  /**
+   * `Node` is a lightweight read-only view of a node of the graph.
+   */
+  class Node {
+  public:
+    Node(SizeType index, const ValueType& p_value,
+         AdjacencyStructureType p_edges)
+        : value(p_value), edges(p_edges), m_index(index) {}
+
+    SizeType index() const { return m_index; }
+    const ValueType& value;
+    AdjacencyStructureType edges;
+
+  private:
+    SizeType m_index;
+  };
+
+  class const_iterator { // NOLINT
+  public:
+    using iterator_category = std::forward_iterator_tag; // NOLINT
+    using value_type = Node;                             // NOLINT
+    using difference_type = std::ptrdiff_t;              // NOLINT
+    using reference = Node;                              // NOLINT
+    using pointer = void;                                // NOLINT
+
+    const_iterator(const CSRGraph* graph, SizeType index)
+        : m_graph(graph), m_index(index) {}
+    Node operator*() const { return (*m_graph)[m_index]; }
+    const_iterator& operator++() {
+      ++m_index;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto temp = *this;
+      ++m_index;
+      return temp;
+    }
+    friend bool operator==(const const_iterator& a, const const_iterator& b) {
+      return a.m_index == b.m_index;
+    }
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) {
+      return a.m_index != b.m_index;
+    }
+
+  private:
+    const CSRGraph* m_graph;
+    SizeType m_index;
+  };
+  using iterator = const_iterator; // NOLINT
+
+public:
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+  static constexpr EdgeValueType
+      nweight = std::numeric_limits<EdgeValueType>::max();
+
+public:
+  /// Builds a graph with `sz` nodes and no edges.
+  CSRGraph(SizeType sz = 0, SizeType root = 0)
+      : m_offsets(sz + 1, 0), m_values(sz), m_root(root) {}
+
+  /**
+   * Builds a frozen copy of `graph`, keeping node values, edge weights and
+   * the root.
+   */
+  template <typename NodeValueT>
+  explicit CSRGraph(const Graph<NodeValueT, EdgeValueType>& graph);
+
+  /**
+   * Builds a graph with `sz` nodes from a list of directed edges.
+   *
+   * Edges are bucketed by source in O(sz + edges.size()) (degree count,
+   * prefix sum, scatter) and each row is then sorted by target. If the list
+   * contains the same edge more than once, the weight that appears last wins,
+   * as with repeated `Graph::add_directed_edge` calls.
+   *
+   * @param sz number of nodes.
+   * @param edges directed edges of the graph.
+   * @param root index of the root node.
+   */
+  CSRGraph(SizeType sz, const Sequence<Edge>& edges, SizeType root = 0);
+
+  /**
+   * Builds a graph directly from its arrays, as returned by `offsets()`,
+   * `targets()`, `weights()` and `values()`. Every row must be sorted by
+   * target, without duplicates.
+   */
+  CSRGraph(Sequence<SizeType> offsets, Sequence<SizeType> targets,
+           Sequence<EdgeValueType> weights, Sequence<ValueType> values,
+           SizeType root = 0)
+      : m_offsets(std::move(offsets)), m_targets(std::move(targets)),
+        m_weights(std::move(weights)), m_values(std::move(values)),
+        m_root(root) {}
+
+  CSRGraph(const CSRGraph&) = default;
+  CSRGraph(CSRGraph&&) noexcept = default;
+  CSRGraph& operator=(const CSRGraph&) = default;
+  CSRGraph& operator=(CSRGraph&&) noexcept = default;
+  ~CSRGraph() = default;
+
+  /// Returns a view of the ith node of the graph.
+  Node operator[](SizeType index) const {
+    return Node(index, m_values[index], edges(index));
+  }
+
+  /// Returns the out-edges of the ith node of the graph.
+  AdjacencyStructureType edges(SizeType index) const {
+    return AdjacencyStructureType(m_targets.data() + m_offsets[index],
+                                  m_weights.data() + m_offsets[index],
+                                  m_offsets[index + 1] - m_offsets[index]);
+  }
+
+  /// Returns begin iterator for the nodes of the graph.
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator cbegin() const { return begin(); }
+
+  /// Returns end iterator for the nodes of the graph.
+  const_iterator end() const { return {this, size()}; }
+  const_iterator cend() const { return end(); }
+
+  /// Returns the number of nodes in the graph.
+  SizeType size() const { return m_offsets.size() - 1; }
+
+  /// Returns the number of directed edges in the graph.
+  SizeType num_edges() const { return m_targets.size(); }
+
+  /// Returns the out-degree of the ith node.
+  SizeType degree(SizeType index) const {
+    return m_offsets[index + 1] - m_offsets[index];
+  }
+
+  /// Returns the index of the root node.
+  SizeType root() const { return m_root; }
+
+  /// Raw CSR arrays.
+  const Sequence<SizeType>& offsets() const { return m_offsets; }
+  const Sequence<SizeType>& targets() const { return m_targets; }
+  const Sequence<EdgeValueType>& weights() const { return m_weights; }
+  const Sequence<ValueType>& values() const { return m_values; }
+
+private:
+  /// `m_offsets[u]` is the position of the first out-edge of node `u`.
+  Sequence<SizeType> m_offsets;
+  /// Target node of each edge.
+  Sequence<SizeType> m_targets;
+  /// Weight of each edge.
+  Sequence<EdgeValueType> m_weights;
+  /// Value of each node.
+  Sequence<ValueType> m_values;
+  /// Stores index of the root node.
+  SizeType m_root;
+};
+
+template <typename ValueT, typename EdgeValueT>
+constexpr typename CSRGraph<ValueT, EdgeValueT>::SizeType
+    CSRGraph<ValueT, EdgeValueT>::npos;
+template <typename ValueT, typename EdgeValueT>
+constexpr typename CSRGraph<ValueT, EdgeValueT>::EdgeValueType
+    CSRGraph<ValueT, EdgeValueT>::nweight;
+
+template <typename ValueT, typename EdgeValueT>
+template <typename NodeValueT>
+CSRGraph<ValueT, EdgeValueT>::CSRGraph(
+    const Graph<NodeValueT, EdgeValueType>& graph)
+    : m_root(graph.root()) {
+  m_offsets.reserve(graph.size() + 1);
+  m_values.reserve(graph.size());
+  SizeType num_of_edges = 0;
+  for (const auto& u : graph) {
+    num_of_edges += u.edges.size();
+  }
+  m_targets.reserve(num_of_edges);
+  m_weights.reserve(num_of_edges);
+
+  m_offsets.push_back(0);
+  for (const auto& u : graph) {
+    // `std::map` iterates in increasing key order, so rows come out sorted.
+    for (const auto& edge : u.edges) {
+      m_targets.push_back(edge.first);
+      m_weights.push_back(edge.second);
+    }
+    m_offsets.push_back(m_targets.size());
+    m_values.push_back(u.value);
+  }
+}
+
+template <typename ValueT, typename EdgeValueT>
+CSRGraph<ValueT, EdgeValueT>::CSRGraph(SizeType sz, const Sequence<Edge>& edges,
+                                       SizeType root)
+    : m_offsets(sz + 1, 0), m_values(sz), m_root(root) {
+  // Count out-degrees, shifted by one so that the prefix sum gives offsets.
+  for (const auto& edge : edges) {
+    ++m_offsets[edge.from + 1];
+  }
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    m_offsets[u_i + 1] += m_offsets[u_i];
+  }
+
+  // Scatter edges into their rows, preserving input order within a row.
+  Sequence<std::pair<SizeType, EdgeValueType>> scattered(edges.size());
+  Sequence<SizeType> position(m_offsets.begin(), m_offsets.end() - 1);
+  for (const auto& edge : edges) {
+    scattered[position[edge.from]++] = {edge.to, edge.weight};
+  }
+
+  // Sort each row by target and drop duplicates, keeping the last weight.
+  m_targets.reserve(edges.size());
+  m_weights.reserve(edges.size());
+  SizeType row_first = 0;
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    auto first = scattered.begin() + row_first;
+    auto last = scattered.begin() + m_offsets[u_i + 1];
+    std::stable_sort(first, last, [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    });
+    row_first = m_offsets[u_i + 1];
+    m_offsets[u_i + 1] = m_offsets[u_i];
+    for (auto it = first; it != last; ++it) {
+      if (std::next(it) != last && std::next(it)->first == it->first)
+        continue;
+      m_targets.push_back(it->first);
+      m_weights.push_back(it->second);
+      ++m_offsets[u_i + 1];
+    }
+  }
+}
+
+} // namespace dragon
+
+#endif
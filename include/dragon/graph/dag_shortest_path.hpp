@@ -0,0 +1,144 @@
+#ifndef DRAGON_GRAPH_DAG_SHORTEST_PATH_HPP
+#define DRAGON_GRAPH_DAG_SHORTEST_PATH_HPP
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <vector>
+#include "dragon/graph/graph.hpp"
+#include "dragon/graph/topological_sort.hpp"
+
+namespace dragon {
+namespace details {
+/**
+ * Relaxes the out-edges of every node of `order`, in that order, keeping
+ * for each node the path weight that is best according to `better`. Nodes
+ * still at `none` are skipped. O(V + E).
+ */
+template <typename GraphT, typename CompareT>
+void dag_relax(const GraphT& graph,
+               const std::vector<typename GraphT::SizeType>& order,
+               std::vector<typename GraphT::EdgeValueType>& dist,
+               std::vector<typename GraphT::SizeType>& parent,
+               typename GraphT::EdgeValueType none, CompareT better) {
+  for (auto u_i : order) {
+    if (dist[u_i] == none)
+      continue;
+    for (auto edge : graph[u_i].edges) {
+      auto temp_dist = dist[u_i] + edge.second;
+      if (dist[edge.first] == none || better(temp_dist, dist[edge.first])) {
+        dist[edge.first] = temp_dist;
+        parent[edge.first] = u_i;
+      }
+    }
+  }
+}
+
+/// Shared part of `dag_shortest_paths` and `dag_longest_paths`.
+template <typename GraphT, typename CompareT>
+bool dag_paths(const GraphT& graph,
+               std::vector<typename GraphT::EdgeValueType>& path_wt,
+               std::vector<typename GraphT::SizeType>& parent,
+               typename GraphT::SizeType source,
+               typename GraphT::EdgeValueType none, CompareT better) {
+  std::vector<typename GraphT::SizeType> order;
+  if (!topological_sort(graph, order))
+    return false;
+  if (source == GraphT::npos)
+    source = graph.root();
+  path_wt.assign(graph.size(), none);
+  parent.assign(graph.size(), GraphT::npos);
+  path_wt[source] = 0;
+  dag_relax(graph, order, path_wt, parent, none, better);
+  return true;
+}
+} // namespace details
+
+/**
+ * Single source shortest paths of a directed acyclic graph in O(V + E), by
+ * relaxing edges in topological order. Edge weights may be negative.
+ *
+ * @param shortest_path_wt receives shortest path weights from `source`,
+ * `std::numeric_limits<EdgeValueType>::max()` for unreachable nodes.
+ * @param parent receives the previous node on a shortest path, `npos` for
+ * `source` and unreachable nodes.
+ * @param source index of the source node, root of the graph by default.
+ * @returns false, leaving the outputs untouched, if the graph has a cycle.
+ */
+template <typename GraphT>
+bool dag_shortest_paths(
+    const GraphT& graph,
+    std::vector<typename GraphT::EdgeValueType>& shortest_path_wt,
+    std::vector<typename GraphT::SizeType>& parent,
+    typename GraphT::SizeType source = GraphT::npos) {
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  return details::dag_paths(graph, shortest_path_wt, parent, source,
+                            std::numeric_limits<EdgeValueType>::max(),
+                            std::less<EdgeValueType>());
+}
+
+/**
+ * Single source longest paths of a directed acyclic graph in O(V + E), by
+ * relaxing edges in topological order.
+ *
+ * @param longest_path_wt receives longest path weights from `source`,
+ * `std::numeric_limits<EdgeValueType>::lowest()` for unreachable nodes.
+ * @param parent receives the previous node on a longest path, `npos` for
+ * `source` and unreachable nodes.
+ * @param source index of the source node, root of the graph by default.
+ * @returns false, leaving the outputs untouched, if the graph has a cycle.
+ */
+template <typename GraphT>
+bool dag_longest_paths(
+    const GraphT& graph,
+    std::vector<typename GraphT::EdgeValueType>& longest_path_wt,
+    std::vector<typename GraphT::SizeType>& parent,
+    typename GraphT::SizeType source = GraphT::npos) {
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  return details::dag_paths(graph, longest_path_wt, parent, source,
+                            std::numeric_limits<EdgeValueType>::lowest(),
+                            std::greater<EdgeValueType>());
+}
+
+/**
+ * Critical path of a directed acyclic graph: the heaviest path between any
+ * two nodes, e.g. the chain of tasks that bounds the length of a schedule
+ * when edge weights are durations. O(V + E).
+ *
+ * @param path receives the nodes of a critical path, from its first to its
+ * last node. A single node if no path is heavier than an empty one.
+ * @param length receives the weight of the critical path.
+ * @returns false, leaving the outputs untouched, if the graph has a cycle.
+ */
+template <typename GraphT>
+bool critical_path(const GraphT& graph,
+                   std::vector<typename GraphT::SizeType>& path,
+                   typename GraphT::EdgeValueType& length) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  std::vector<SizeType> order;
+  if (!topological_sort(graph, order))
+    return false;
+  // Every node may start the path.
+  std::vector<EdgeValueType> dist(graph.size(), 0);
+  std::vector<SizeType> parent(graph.size(), GraphT::npos);
+  details::dag_relax(graph, order, dist, parent,
+                     std::numeric_limits<EdgeValueType>::lowest(),
+                     std::greater<EdgeValueType>());
+  path.clear();
+  if (graph.size() == 0) {
+    length = 0;
+    return true;
+  }
+  SizeType last = static_cast<SizeType>(
+      std::max_element(dist.begin(), dist.end()) - dist.begin());
+  length = dist[last];
+  for (SizeType v_i = last; v_i != GraphT::npos; v_i = parent[v_i]) {
+    path.push_back(v_i);
+  }
+  std::reverse(path.begin(), path.end());
+  return true;
+}
+
+} // namespace dragon
+
+#endif
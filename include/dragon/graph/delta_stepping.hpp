@@ -0,0 +1,193 @@
+#ifndef DRAGON_GRAPH_DELTA_STEPPING_HPP
+#define DRAGON_GRAPH_DELTA_STEPPING_HPP
+#include <atomic>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "dragon/core/thread-pool.hpp"
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+namespace details {
+/**
+ * Out-edges of every node split into light (`weight <= delta`) and heavy
+ * (`weight > delta`) edges, each kind stored in its own flat CSR arrays.
+ */
+template <typename SizeT, typename EdgeValueT> struct LightHeavyEdges {
+  std::vector<SizeT> light_offsets, heavy_offsets;
+  std::vector<std::pair<SizeT, EdgeValueT>> light, heavy;
+
+  template <typename GraphT>
+  LightHeavyEdges(const GraphT& graph, EdgeValueT delta, ThreadPool& pool)
+      : light_offsets(graph.size() + 1, 0), heavy_offsets(graph.size() + 1, 0) {
+    pool.parallel_for(0, graph.size(), [&](SizeT u_i, SizeT) {
+      for (auto edge : graph[u_i].edges) {
+        if (edge.second <= delta)
+          ++light_offsets[u_i + 1];
+        else
+          ++heavy_offsets[u_i + 1];
+      }
+    });
+    for (SizeT u_i = 0; u_i < graph.size(); ++u_i) {
+      light_offsets[u_i + 1] += light_offsets[u_i];
+      heavy_offsets[u_i + 1] += heavy_offsets[u_i];
+    }
+    light.resize(light_offsets.back());
+    heavy.resize(heavy_offsets.back());
+    pool.parallel_for(0, graph.size(), [&](SizeT u_i, SizeT) {
+      SizeT light_pos = light_offsets[u_i], heavy_pos = heavy_offsets[u_i];
+      for (auto edge : graph[u_i].edges) {
+        if (edge.second <= delta)
+          light[light_pos++] = edge;
+        else
+          heavy[heavy_pos++] = edge;
+      }
+    });
+  }
+};
+
+/// Atomically lowers `target` to `value`, returns true if it was lowered.
+template <typename T> bool atomic_fetch_min(std::atomic<T>& target, T value) {
+  T cur = target.load(std::memory_order_relaxed);
+  while (value < cur) {
+    if (target.compare_exchange_weak(cur, value, std::memory_order_relaxed))
+      return true;
+  }
+  return false;
+}
+} // namespace details
+
+/**
+ * Parallel delta-stepping single source shortest paths (Meyer and Sanders)
+ * for graphs with non-negative edge weights. Returns the same distances as
+ * `djikstra`, with `std::numeric_limits<EdgeValueType>::max()` for
+ * unreachable nodes.
+ *
+ * Nodes are kept in buckets of width `delta` by tentative distance. Buckets
+ * are settled in increasing order; inside a bucket, light edges
+ * (`weight <= delta`) are relaxed in parallel rounds until the bucket stops
+ * changing, then heavy edges of every node removed from the bucket are
+ * relaxed once, in parallel. A small `delta` approaches Dijkstra's work
+ * efficiency, a large one approaches Bellman-Ford's parallelism; the
+ * average edge weight times a small constant is usually a good start.
+ *
+ * @param graph graph with non-negative edge weights.
+ * @param delta bucket width, must be positive.
+ * @param pool threads to run on.
+ * @param source index of the source node, root of the graph by default.
+ *
+ * @throws std::invalid_argument if `delta` is not positive.
+ */
+template <typename GraphT>
+std::vector<typename GraphT::EdgeValueType>
+delta_stepping(const GraphT& graph, typename GraphT::EdgeValueType delta,
+               ThreadPool& pool,
+               typename GraphT::SizeType source = GraphT::npos) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  if (source == GraphT::npos)
+    source = graph.root();
+  if (!(delta > 0))
+    throw std::invalid_argument("dragon::delta_stepping: delta must be "
+                                "positive");
+  const auto inf_weight = std::numeric_limits<EdgeValueType>::max();
+  const SizeType npos = GraphT::npos;
+  const SizeType sz = graph.size();
+
+  details::LightHeavyEdges<SizeType, EdgeValueType> edges(graph, delta, pool);
+
+  std::vector<std::atomic<EdgeValueType>> dist(sz);
+  pool.parallel_for(0, sz, [&](SizeType i, SizeType) {
+    dist[i].store(inf_weight, std::memory_order_relaxed);
+  });
+  dist[source].store(0, std::memory_order_relaxed);
+
+  auto bucket_of = [delta](EdgeValueType d) {
+    return static_cast<SizeType>(d / delta);
+  };
+  // Only non-empty buckets are stored, so that the memory and the number of
+  // buckets visited do not depend on `max_weight / delta`.
+  std::map<SizeType, std::vector<SizeType>> buckets;
+  buckets[0].push_back(source);
+
+  // `stamp[v]` remembers the last round that picked `v`, so that a node
+  // pushed several times into the same bucket is expanded once per round.
+  std::vector<SizeType> stamp(sz, 0);
+  std::vector<SizeType> settled_stamp(sz, npos);
+  SizeType round = 0;
+
+  std::vector<std::vector<SizeType>> updated(pool.size());
+  std::vector<SizeType> frontier, settled;
+
+  auto relax = [&](const std::vector<SizeType>& nodes,
+                   const std::vector<SizeType>& offsets,
+                   const std::vector<std::pair<SizeType, EdgeValueType>>& adj) {
+    pool.parallel_for(0, nodes.size(), [&](SizeType i, SizeType thread_index) {
+      SizeType u_i = nodes[i];
+      EdgeValueType d = dist[u_i].load(std::memory_order_relaxed);
+      for (SizeType e = offsets[u_i]; e < offsets[u_i + 1]; ++e) {
+        if (details::atomic_fetch_min(dist[adj[e].first], d + adj[e].second))
+          updated[thread_index].push_back(adj[e].first);
+      }
+    });
+    for (auto& local : updated) {
+      for (SizeType v_i : local) {
+        buckets[bucket_of(dist[v_i].load(std::memory_order_relaxed))]
+            .push_back(v_i);
+      }
+      local.clear();
+    }
+  };
+
+  while (!buckets.empty()) {
+    // Relaxations only reach this bucket or later ones, and references to
+    // `std::map` elements stay valid while others are inserted.
+    const SizeType cur = buckets.begin()->first;
+    auto& bucket = buckets.begin()->second;
+    settled.clear();
+    while (!bucket.empty()) {
+      ++round;
+      frontier.clear();
+      for (SizeType v_i : bucket) {
+        // Skip stale entries of nodes that moved to a lower bucket.
+        if (stamp[v_i] == round ||
+            bucket_of(dist[v_i].load(std::memory_order_relaxed)) != cur)
+          continue;
+        stamp[v_i] = round;
+        frontier.push_back(v_i);
+        if (settled_stamp[v_i] != cur) {
+          settled_stamp[v_i] = cur;
+          settled.push_back(v_i);
+        }
+      }
+      bucket.clear();
+      relax(frontier, edges.light_offsets, edges.light);
+    }
+    buckets.erase(buckets.begin());
+    relax(settled, edges.heavy_offsets, edges.heavy);
+  }
+
+  std::vector<EdgeValueType> shortest_paths_weight(sz);
+  pool.parallel_for(0, sz, [&](SizeType i, SizeType) {
+    shortest_paths_weight[i] = dist[i].load(std::memory_order_relaxed);
+  });
+  return shortest_paths_weight;
+}
+
+/**
+ * Same as above, running on a temporary pool with one thread per hardware
+ * thread.
+ */
+template <typename GraphT>
+std::vector<typename GraphT::EdgeValueType>
+delta_stepping(const GraphT& graph, typename GraphT::EdgeValueType delta,
+               typename GraphT::SizeType source = GraphT::npos) {
+  ThreadPool pool;
+  return delta_stepping(graph, delta, pool, source);
+}
+
+} // namespace dragon
+
+#endif
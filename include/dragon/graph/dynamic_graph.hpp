@@ -0,0 +1,455 @@
+#ifndef DRAGON_GRAPH_DYNAMIC_GRAPH_HPP
+#define DRAGON_GRAPH_DYNAMIC_GRAPH_HPP
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "dragon/core/thread-pool.hpp"
+
+namespace dragon {
+namespace details {
+/**
+ * Flat map from target to weight holding the out-edges of one node of a
+ * `DynamicGraph`.
+ *
+ * Edges live in one contiguous array, in no particular order. Up to
+ * `linear_scan_limit` edges, lookups scan the array. Past that, an open
+ * addressing index (linear probing over a power of two table of positions
+ * in the array, at most half full) finds them in O(1) expected. Erasing
+ * moves the last edge into the hole and shifts the probe sequence back, so
+ * neither leaves tombstones. Inserting and erasing only allocate when the
+ * array or the index grows.
+ */
+template <typename SizeT, typename EdgeValueT> class FlatEdgeMap {
+public:
+  using SizeType = SizeT;
+  using EdgeValueType = EdgeValueT;
+  using value_type = std::pair<SizeType, EdgeValueType>; // NOLINT
+  using size_type = SizeType;                            // NOLINT
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+
+public:
+  using const_iterator = // NOLINT
+      typename Sequence<value_type>::const_iterator;
+  using iterator = const_iterator; // NOLINT
+
+  /// Largest number of edges looked up without the index.
+  static constexpr SizeType linear_scan_limit = 16;
+
+public:
+  FlatEdgeMap() = default;
+  FlatEdgeMap(const FlatEdgeMap&) = default;
+  FlatEdgeMap(FlatEdgeMap&&) noexcept = default;
+  FlatEdgeMap& operator=(const FlatEdgeMap&) = default;
+  FlatEdgeMap& operator=(FlatEdgeMap&&) noexcept = default;
+  ~FlatEdgeMap() = default;
+
+  const_iterator begin() const { return m_edges.begin(); }
+  const_iterator end() const { return m_edges.end(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  SizeType size() const { return m_edges.size(); }
+  bool empty() const { return m_edges.empty(); }
+
+  /// Returns an iterator to the edge towards `v_i`, or `end()` if absent.
+  const_iterator find(SizeType v_i) const {
+    const SizeType pos = position(v_i);
+    return pos == npos ? end() : begin() + pos;
+  }
+
+  /// Returns 1 if an edge towards `v_i` exists, 0 otherwise.
+  SizeType count(SizeType v_i) const { return position(v_i) != npos ? 1 : 0; }
+
+  /**
+   * Returns the weight of the edge towards `v_i`.
+   *
+   * @throws std::out_of_range if no such edge exists.
+   */
+  const EdgeValueType& at(SizeType v_i) const {
+    const SizeType pos = position(v_i);
+    if (pos == npos)
+      throw std::out_of_range("dragon::DynamicGraph: edge does not exist");
+    return m_edges[pos].second;
+  }
+
+  /**
+   * Adds an edge towards `v_i`, or updates its weight if it exists.
+   *
+   * @returns true if the edge was added.
+   */
+  bool insert_or_assign(SizeType v_i, EdgeValueType weight);
+
+  /**
+   * Removes the edge towards `v_i`, moving the last edge in its place.
+   *
+   * @returns the number of removed edges, 0 or 1.
+   */
+  SizeType erase(SizeType v_i);
+
+  /// Removes every edge and releases the index.
+  void clear() {
+    m_edges.clear();
+    m_slots.clear();
+  }
+
+  /// Reserves room for `sz` edges.
+  void reserve(SizeType sz) { m_edges.reserve(sz); }
+
+private:
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+
+  /// Home slot of `v_i`, Fibonacci hashing on the top bits.
+  SizeType home(SizeType v_i) const {
+    return static_cast<SizeType>(
+        (static_cast<std::uint64_t>(v_i) * 0x9E3779B97F4A7C15ULL) >>
+        m_shift);
+  }
+  SizeType mask() const { return m_slots.size() - 1; }
+
+  /// Returns the slot holding `v_i`, or the empty slot ending its probe.
+  SizeType slot(SizeType v_i) const {
+    SizeType s = home(v_i);
+    while (m_slots[s] != npos && m_edges[m_slots[s]].first != v_i) {
+      s = (s + 1) & mask();
+    }
+    return s;
+  }
+
+  /// Returns the position of the edge towards `v_i`, or `npos`.
+  SizeType position(SizeType v_i) const;
+
+  /// Rebuilds the index with `sz` slots, a power of two.
+  void rehash(SizeType sz);
+
+private:
+  /// Out-edges, unordered.
+  Sequence<value_type> m_edges;
+  /// Position in `m_edges` of the edge in each slot, `npos` for empty ones.
+  /// Empty until the node has more than `linear_scan_limit` edges.
+  Sequence<SizeType> m_slots;
+  /// 64 minus the number of bits of a slot index.
+  unsigned m_shift = 64;
+};
+
+template <typename SizeT, typename EdgeValueT>
+constexpr typename FlatEdgeMap<SizeT, EdgeValueT>::SizeType
+    FlatEdgeMap<SizeT, EdgeValueT>::linear_scan_limit;
+template <typename SizeT, typename EdgeValueT>
+constexpr typename FlatEdgeMap<SizeT, EdgeValueT>::SizeType
+    FlatEdgeMap<SizeT, EdgeValueT>::npos;
+
+template <typename SizeT, typename EdgeValueT>
+typename FlatEdgeMap<SizeT, EdgeValueT>::SizeType
+FlatEdgeMap<SizeT, EdgeValueT>::position(SizeType v_i) const {
+  if (m_slots.empty()) {
+    for (SizeType pos = 0; pos < m_edges.size(); ++pos) {
+      if (m_edges[pos].first == v_i)
+        return pos;
+    }
+    return npos;
+  }
+  return m_slots[slot(v_i)];
+}
+
+template <typename SizeT, typename EdgeValueT>
+void FlatEdgeMap<SizeT, EdgeValueT>::rehash(SizeType sz) {
+  m_slots.assign(sz, npos);
+  m_shift = 64;
+  for (SizeType bits = sz; bits > 1; bits >>= 1) {
+    --m_shift;
+  }
+  for (SizeType pos = 0; pos < m_edges.size(); ++pos) {
+    m_slots[slot(m_edges[pos].first)] = pos;
+  }
+}
+
+template <typename SizeT, typename EdgeValueT>
+bool FlatEdgeMap<SizeT, EdgeValueT>::insert_or_assign(SizeType v_i,
+                                                      EdgeValueType weight) {
+  if (m_slots.empty()) {
+    const SizeType pos = position(v_i);
+    if (pos != npos) {
+      m_edges[pos].second = weight;
+      return false;
+    }
+    m_edges.emplace_back(v_i, weight);
+    if (m_edges.size() > linear_scan_limit)
+      rehash(4 * linear_scan_limit);
+    return true;
+  }
+  const SizeType s = slot(v_i);
+  if (m_slots[s] != npos) {
+    m_edges[m_slots[s]].second = weight;
+    return false;
+  }
+  m_slots[s] = m_edges.size();
+  m_edges.emplace_back(v_i, weight);
+  if (2 * m_edges.size() > m_slots.size())
+    rehash(2 * m_slots.size());
+  return true;
+}
+
+template <typename SizeT, typename EdgeValueT>
+typename FlatEdgeMap<SizeT, EdgeValueT>::SizeType
+FlatEdgeMap<SizeT, EdgeValueT>::erase(SizeType v_i) {
+  const SizeType last = m_edges.size() - 1;
+  if (m_slots.empty()) {
+    const SizeType pos = position(v_i);
+    if (pos == npos)
+      return 0;
+    m_edges[pos] = m_edges[last];
+    m_edges.pop_back();
+    return 1;
+  }
+  SizeType hole = slot(v_i);
+  const SizeType pos = m_slots[hole];
+  if (pos == npos)
+    return 0;
+  // Backward shift: pull later entries of the probe sequence into the hole
+  // unless their home slot lies cyclically in (hole, s].
+  for (SizeType s = (hole + 1) & mask(); m_slots[s] != npos;
+       s = (s + 1) & mask()) {
+    const SizeType h = home(m_edges[m_slots[s]].first);
+    const bool stays = hole < s ? (hole < h && h <= s) : (hole < h || h <= s);
+    if (!stays) {
+      m_slots[hole] = m_slots[s];
+      hole = s;
+    }
+  }
+  m_slots[hole] = npos;
+  if (pos != last) {
+    m_slots[slot(m_edges[last].first)] = pos;
+    m_edges[pos] = m_edges[last];
+  }
+  m_edges.pop_back();
+  return 1;
+}
+} // namespace details
+
+/**
+ * `DynamicGraph` is a mutable graph tuned for high rates of edge insertions
+ * and deletions. It has the same interface as `Graph`, but the out-edges of
+ * each node are kept in a `details::FlatEdgeMap`, a flat array with an open
+ * addressing index, instead of a `std::map`: adding or removing an edge
+ * costs O(1) expected and no allocation in the steady state.
+ *
+ * Batches of updates can also be applied in parallel, one source node per
+ * task, with `apply_updates`.
+ *
+ * @param ValueT type of value of graph nodes.
+ * @param EdgeValueT type of weight of graph edges.
+ *
+ * @note Unlike `Graph`, out-edges are iterated in no particular order, and
+ * removing an edge reorders the remaining ones.
+ * @note `DynamicGraph` do not support multiple edges between the same nodes.
+ */
+template <typename ValueT, typename EdgeValueT = int> class DynamicGraph {
+public:
+  using ValueType = ValueT;
+  using EdgeValueType = EdgeValueT;
+  using SizeType = std::size_t;
+  using AdjacencyStructureType =
+      details::FlatEdgeMap<SizeType, EdgeValueType>;
+  class Node;
+
+  using size_type = SizeType; // NOLINT
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+  using NodeSequenceType = Sequence<Node>;
+
+public:
+  using iterator = typename NodeSequenceType::iterator;             // NOLINT
+  using const_iterator = typename NodeSequenceType::const_iterator; // NOLINT
+
+  /**
+   * An update of the edge `from` -> `to`: sets its weight to `weight`,
+   * adding it if needed, or removes it if `remove` is set.
+   */
+  struct EdgeUpdate {
+    SizeType from;
+    SizeType to;
+    EdgeValueType weight;
+    bool remove = false;
+  };
+
+public:
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+  static constexpr EdgeValueType
+      nweight = std::numeric_limits<EdgeValueType>::max();
+
+public:
+  DynamicGraph(SizeType sz = 0, SizeType root = 0) : m_root(root) {
+    m_nodes.reserve(sz);
+    for (SizeType i = 0; i < sz; ++i) {
+      m_nodes.emplace_back(i);
+    }
+  }
+  DynamicGraph(const DynamicGraph&) = default;
+  DynamicGraph(DynamicGraph&&) noexcept = default;
+  DynamicGraph& operator=(const DynamicGraph&) = default;
+  DynamicGraph& operator=(DynamicGraph&&) noexcept = default;
+  ~DynamicGraph() = default;
+
+  /// Returns a reference to ith node of the graph.
+  Node& operator[](SizeType index) { return m_nodes[index]; }
+  const Node& operator[](SizeType index) const { return m_nodes[index]; }
+
+  /// Returns begin iterator for the nodes of the graph.
+  iterator begin() { return m_nodes.begin(); }
+  const_iterator begin() const { return m_nodes.begin(); }
+  const_iterator cbegin() const { return m_nodes.cbegin(); }
+
+  /// Returns end iterator for the nodes of the graph.
+  iterator end() { return m_nodes.end(); }
+  const_iterator end() const { return m_nodes.end(); }
+  const_iterator cend() const { return m_nodes.cend(); }
+
+  /// Clears all nodes of the graph.
+  void clear() {
+    m_nodes.clear();
+    m_num_of_edges = 0;
+  }
+
+  /**
+   * Adds a weighted directed edge from node `u` to `v` (`u` -> `v`),
+   *
+   * If an edge already exists from node `u` to node `v`, then the edge weight
+   * is updated.
+   */
+  void add_directed_edge(SizeType u_i, SizeType v_i, EdgeValueType weight = 1) {
+    m_num_of_edges += m_nodes[u_i].edges.insert_or_assign(v_i, weight);
+  }
+
+  /**
+   * Adds a weighted undirected edge between node `u` and `v`.
+   *
+   * If an undirected edge already exists between nodes `u` and `v`, then the
+   * edge weight is updated.
+   */
+  void add_undirected_edge(SizeType u_i, SizeType v_i,
+                           EdgeValueType weight = 1) {
+    add_directed_edge(u_i, v_i, weight);
+    add_directed_edge(v_i, u_i, weight);
+  }
+
+  /**
+   * Remove a directed edge from node `u` to `v`.
+   *
+   * Does nothing if no directed edge exist from node `u` to `v`.
+   */
+  void remove_directed_edge(SizeType u_i, SizeType v_i) {
+    m_num_of_edges -= m_nodes[u_i].edges.erase(v_i);
+  }
+
+  /**
+   * Remove an undirected edge between nodes `u` and `v`.
+   *
+   * Does nothing if no undirected edge exist between nodes `u` and `v`.
+   */
+  void remove_undirected_edge(SizeType u_i, SizeType v_i) {
+    remove_directed_edge(u_i, v_i);
+    remove_directed_edge(v_i, u_i);
+  }
+
+  /**
+   * Applies a batch of updates, sorted by source node, in parallel. Each
+   * run of updates with the same source is applied in order by one task,
+   * so the last update of an edge wins, as with sequential calls.
+   *
+   * Updates of an undirected edge need one update per direction.
+   *
+   * @param updates updates sorted by `from`, e.g. with `std::stable_sort`
+   * to keep the order of updates of the same edge.
+   * @param pool threads to run on.
+   */
+  void apply_updates(const Sequence<EdgeUpdate>& updates, ThreadPool& pool);
+
+  /**
+   * Same as above, running on a temporary pool with one thread per hardware
+   * thread.
+   */
+  void apply_updates(const Sequence<EdgeUpdate>& updates) {
+    ThreadPool pool;
+    apply_updates(updates, pool);
+  }
+
+  /// Returns the number of nodes in the graph.
+  SizeType size() const { return m_nodes.size(); }
+
+  /// Returns the number of directed edges in the graph.
+  SizeType num_edges() const { return m_num_of_edges; }
+
+  /// Returns the index of the root node.
+  SizeType root() const { return m_root; }
+
+  /**
+   * `Node` is a data structure to represent a node of the graph.
+   */
+  class Node {
+  public:
+    Node(SizeType index) : m_index(index) {}
+    Node(SizeType index, ValueType p_value) : value(p_value), m_index(index) {}
+    Node(const Node&) = default;
+    Node(Node&&) noexcept = default;
+    Node& operator=(const Node&) = default;
+    Node& operator=(Node&&) noexcept = default;
+    ~Node() = default;
+
+  public:
+    SizeType index() const { return m_index; }
+    ValueType value;
+    AdjacencyStructureType edges;
+
+  private:
+    SizeType m_index;
+  };
+
+private:
+  /// Stores nodes of the graph.
+  NodeSequenceType m_nodes;
+  SizeType m_num_of_edges = 0;
+  /// Stores index of the root node.
+  SizeType m_root;
+};
+
+template <typename ValueT, typename EdgeValueT>
+constexpr typename DynamicGraph<ValueT, EdgeValueT>::SizeType
+    DynamicGraph<ValueT, EdgeValueT>::npos;
+template <typename ValueT, typename EdgeValueT>
+constexpr typename DynamicGraph<ValueT, EdgeValueT>::EdgeValueType
+    DynamicGraph<ValueT, EdgeValueT>::nweight;
+
+template <typename ValueT, typename EdgeValueT>
+void DynamicGraph<ValueT, EdgeValueT>::apply_updates(
+    const Sequence<EdgeUpdate>& updates, ThreadPool& pool) {
+  const SizeType sz = updates.size();
+  // Edges added minus edges removed by each thread.
+  Sequence<std::ptrdiff_t> added(pool.size(), 0);
+  // The task of an index is a no-op unless it starts a run of its source.
+  pool.parallel_for(0, sz, [&](SizeType i, SizeType thread_index) {
+    const SizeType u_i = updates[i].from;
+    if (i > 0 && updates[i - 1].from == u_i)
+      return;
+    auto& edges = m_nodes[u_i].edges;
+    std::ptrdiff_t delta = 0;
+    for (SizeType j = i; j < sz && updates[j].from == u_i; ++j) {
+      if (updates[j].remove)
+        delta -= static_cast<std::ptrdiff_t>(edges.erase(updates[j].to));
+      else
+        delta += edges.insert_or_assign(updates[j].to, updates[j].weight);
+    }
+    added[thread_index] += delta;
+  });
+  for (auto delta : added) {
+    m_num_of_edges += delta;
+  }
+}
+
+} // namespace dragon
+
+#endif
@@ -0,0 +1,507 @@
+#ifndef DRAGON_GRAPH_EDGE_LIST_HPP
+#define DRAGON_GRAPH_EDGE_LIST_HPP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "dragon/core/thread-pool.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+
+/**
+ * Directed edges parsed from an edge list, in input order, as three
+ * parallel arrays.
+ */
+template <typename EdgeValueT> struct EdgeList {
+  using SizeType = std::size_t;
+  using EdgeValueType = EdgeValueT;
+
+  std::vector<SizeType> sources;
+  std::vector<SizeType> targets;
+  std::vector<EdgeValueType> weights;
+  /// One more than the largest node index, 0 without edges.
+  SizeType num_of_nodes = 0;
+
+  SizeType size() const { return sources.size(); }
+};
+
+namespace details {
+inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+/**
+ * Parses a non-negative integer, returns false if there is no digit or if
+ * it does not fit in `std::size_t`.
+ */
+inline bool parse_unsigned(const char*& it, const char* last,
+                           std::size_t& value) {
+  if (it == last || !is_digit(*it))
+    return false;
+  const std::size_t max_value = std::numeric_limits<std::size_t>::max();
+  value = 0;
+  for (; it != last && is_digit(*it); ++it) {
+    const auto digit = static_cast<std::size_t>(*it - '0');
+    if (value > (max_value - digit) / 10)
+      return false;
+    value = value * 10 + digit;
+  }
+  return true;
+}
+
+/**
+ * Parses a node index, returns false if there is no digit or if it is not
+ * below `std::size_t`'s maximum, the `npos` of graphs.
+ */
+inline bool parse_index(const char*& it, const char* last,
+                        std::size_t& value) {
+  return parse_unsigned(it, last, value) &&
+         value != std::numeric_limits<std::size_t>::max();
+}
+
+/**
+ * Parses an optionally signed integer weight, returns false if it does not
+ * fit in `T`.
+ */
+template <typename T>
+bool parse_weight(const char*& it, const char* last, T& value,
+                  std::true_type /* integral */) {
+  using Limits = std::numeric_limits<T>;
+  const bool negative = it != last && *it == '-';
+  if (it != last && (*it == '-' || *it == '+'))
+    ++it;
+  std::size_t magnitude;
+  if (!parse_unsigned(it, last, magnitude))
+    return false;
+  if (negative) {
+    // The magnitude of the minimum of a signed type is its maximum plus 1.
+    const std::size_t max_magnitude =
+        Limits::is_signed ? static_cast<std::size_t>(Limits::max()) + 1 : 0;
+    if (magnitude > max_magnitude)
+      return false;
+    value = static_cast<T>(0 - magnitude);
+  } else {
+    if (magnitude > static_cast<std::size_t>(Limits::max()))
+      return false;
+    value = static_cast<T>(magnitude);
+  }
+  return true;
+}
+
+/**
+ * Parses a decimal floating point weight, `[+-]digits[.digits][e[+-]digits]`.
+ *
+ * Mantissas of at most 19 digits below 2^53 with a power of ten up to 22
+ * are both exact doubles, so one multiplication or division gives the
+ * correctly rounded result. Other values, including subnormals, are read by
+ * a stream in the classic locale, whatever the global one. Values out of
+ * the range of `double` are malformed.
+ */
+template <typename T>
+bool parse_weight(const char*& it, const char* last, T& value,
+                  std::false_type /* integral */) {
+  const char* const first = it;
+  const bool negative = it != last && *it == '-';
+  if (it != last && (*it == '-' || *it == '+'))
+    ++it;
+  std::uint64_t mantissa = 0;
+  int exponent = 0, num_of_digits = 0;
+  const int max_digits = 19;
+  for (; it != last && is_digit(*it); ++it, ++num_of_digits) {
+    if (num_of_digits < max_digits)
+      mantissa = mantissa * 10 + static_cast<std::uint64_t>(*it - '0');
+    else
+      ++exponent;
+  }
+  if (it != last && *it == '.') {
+    for (++it; it != last && is_digit(*it); ++it, ++num_of_digits) {
+      if (num_of_digits < max_digits) {
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*it - '0');
+        --exponent;
+      }
+    }
+  }
+  if (num_of_digits == 0)
+    return false;
+  if (it != last && (*it == 'e' || *it == 'E')) {
+    ++it;
+    int sign = 1;
+    if (it != last && (*it == '-' || *it == '+'))
+      sign = *it++ == '-' ? -1 : 1;
+    if (it == last || !is_digit(*it))
+      return false;
+    // Saturates, any power past 1000 overflows or underflows anyway.
+    int power = 0;
+    for (; it != last && is_digit(*it); ++it) {
+      power = std::min(power * 10 + (*it - '0'), 1000);
+    }
+    exponent += sign * power;
+  }
+  const bool exact = num_of_digits <= max_digits;
+  if (exact && mantissa == 0) {
+    value = static_cast<T>(negative ? -0.0 : 0.0);
+    return true;
+  }
+  const int max_exact_exponent = 22;
+  if (!exact || mantissa >= (std::uint64_t(1) << 53) ||
+      exponent < -max_exact_exponent || exponent > max_exact_exponent) {
+    std::istringstream stream(std::string(first, it));
+    stream.imbue(std::locale::classic());
+    double result;
+    // Extraction fails on overflow, and must consume the whole number.
+    if (!(stream >> result) ||
+        stream.peek() != std::istringstream::traits_type::eof())
+      return false;
+    value = static_cast<T>(result);
+    return true;
+  }
+  double scale = 1;
+  for (int e = exponent < 0 ? -exponent : exponent; e != 0; --e) {
+    scale *= 10;
+  }
+  const double magnitude = exponent < 0
+                               ? static_cast<double>(mantissa) / scale
+                               : static_cast<double>(mantissa) * scale;
+  value = static_cast<T>(negative ? -magnitude : magnitude);
+  return true;
+}
+
+/**
+ * Parses the lines of `[first, last)`, see `parse_edge_list`, writing the
+ * edges from `sources`, `targets` and `weights` on.
+ *
+ * @param num_of_edges receives the number of edges parsed.
+ * @param num_of_nodes receives one more than the largest node index.
+ * @returns false on a malformed line.
+ */
+template <typename EdgeValueT>
+bool parse_edge_lines(const char* first, const char* last,
+                      std::size_t* sources, std::size_t* targets,
+                      EdgeValueT* weights, std::size_t& num_of_edges,
+                      std::size_t& num_of_nodes) {
+  // Locals rather than the output references, which the stores below could
+  // alias.
+  std::size_t count = 0, largest = 0;
+  num_of_edges = num_of_nodes = 0;
+  const char* it = first;
+  while (it != last) {
+    while (it != last && is_blank(*it)) {
+      ++it;
+    }
+    if (it == last)
+      break;
+    if (*it == '\n') {
+      ++it;
+      continue;
+    }
+    if (*it == '#' || *it == '%') {
+      while (it != last && *it != '\n') {
+        ++it;
+      }
+      continue;
+    }
+    std::size_t u_i, v_i;
+    if (!parse_index(it, last, u_i) || it == last || !is_blank(*it))
+      return false;
+    while (it != last && is_blank(*it)) {
+      ++it;
+    }
+    if (!parse_index(it, last, v_i) ||
+        (it != last && !is_blank(*it) && *it != '\n'))
+      return false;
+    while (it != last && is_blank(*it)) {
+      ++it;
+    }
+    EdgeValueT weight = 1;
+    if (it != last && *it != '\n' &&
+        (!parse_weight(it, last, weight, std::is_integral<EdgeValueT>()) ||
+         (it != last && !is_blank(*it) && *it != '\n')))
+      return false;
+    // Further columns are ignored.
+    while (it != last && *it != '\n') {
+      ++it;
+    }
+    sources[count] = u_i;
+    targets[count] = v_i;
+    weights[count] = weight;
+    ++count;
+    largest = std::max(largest, std::max(u_i, v_i) + 1);
+  }
+  num_of_edges = count;
+  num_of_nodes = largest;
+  return true;
+}
+
+/// Read-only memory mapping of a whole file.
+class MappedFile {
+public:
+  MappedFile() = default;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+  ~MappedFile() {
+    if (m_data != nullptr)
+      ::munmap(m_data, m_size);
+  }
+
+  /// Returns false if the file cannot be opened or mapped.
+  bool open(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat status;
+    if (::fstat(fd, &status) != 0) {
+      ::close(fd);
+      return false;
+    }
+    m_size = static_cast<std::size_t>(status.st_size);
+    if (m_size > 0) {
+      void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      m_data = data == MAP_FAILED ? nullptr : data;
+    }
+    ::close(fd);
+    if (m_size > 0 && m_data == nullptr)
+      return false;
+#ifdef MADV_SEQUENTIAL
+    if (m_data != nullptr)
+      ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+#endif
+    return true;
+  }
+
+  const char* data() const { return static_cast<const char*>(m_data); }
+  std::size_t size() const { return m_size; }
+
+private:
+  void* m_data = nullptr;
+  std::size_t m_size = 0;
+};
+} // namespace details
+
+/**
+ * Parses an edge list text: one directed edge `u v [weight]` per line,
+ * columns separated by spaces or tabs, node indices from 0, weight 1 when
+ * omitted, further columns ignored. Empty lines and lines starting with `#`
+ * or `%` are skipped.
+ *
+ * The text is split into chunks at line boundaries, and the chunks are
+ * parsed in parallel by a hand-rolled number parser, with no locale, stream
+ * or per-edge allocation overhead except for the rare floating point
+ * weights it cannot round exactly.
+ *
+ * @param edges receives the edges, in input order.
+ * @param pool threads to run on.
+ * @returns false on a malformed line, leaving `edges` in an unspecified
+ * state.
+ */
+template <typename EdgeValueT>
+bool parse_edge_list(const char* first, const char* last,
+                     EdgeList<EdgeValueT>& edges, ThreadPool& pool) {
+  using SizeType = std::size_t;
+  const SizeType min_chunk_size = SizeType(1) << 20;
+  const auto length = static_cast<SizeType>(last - first);
+  const SizeType num_of_chunks = std::max<SizeType>(
+      1, std::min(pool.size() * 4, length / min_chunk_size));
+
+  // Chunk `i` holds the lines starting in `[bounds[i], bounds[i + 1])`.
+  std::vector<const char*> bounds(num_of_chunks + 1, last);
+  bounds[0] = first;
+  for (SizeType i = 1; i < num_of_chunks; ++i) {
+    const char* it =
+        std::max(bounds[i - 1], first + length / num_of_chunks * i);
+    while (it != last && it[-1] != '\n') {
+      ++it;
+    }
+    bounds[i] = it;
+  }
+
+  // Every line holds at most one edge, so counting lines gives room for
+  // the edges of each chunk in the output arrays.
+  std::vector<SizeType> position(num_of_chunks + 1, 0);
+  pool.parallel_for(
+      0, num_of_chunks,
+      [&](SizeType i, SizeType) {
+        const char* chunk_first = bounds[i];
+        const char* chunk_last = bounds[i + 1];
+        SizeType num_of_lines = static_cast<SizeType>(
+            std::count(chunk_first, chunk_last, '\n'));
+        if (chunk_first != chunk_last && chunk_last[-1] != '\n')
+          ++num_of_lines;
+        position[i + 1] = num_of_lines;
+      },
+      1);
+  for (SizeType i = 0; i < num_of_chunks; ++i) {
+    position[i + 1] += position[i];
+  }
+  edges.sources.resize(position[num_of_chunks]);
+  edges.targets.resize(position[num_of_chunks]);
+  edges.weights.resize(position[num_of_chunks]);
+
+  std::vector<SizeType> num_of_edges(num_of_chunks);
+  std::vector<SizeType> num_of_nodes(num_of_chunks);
+  std::vector<char> valid(num_of_chunks, 0);
+  pool.parallel_for(
+      0, num_of_chunks,
+      [&](SizeType i, SizeType) {
+        valid[i] = details::parse_edge_lines(
+            bounds[i], bounds[i + 1], edges.sources.data() + position[i],
+            edges.targets.data() + position[i],
+            edges.weights.data() + position[i], num_of_edges[i],
+            num_of_nodes[i]);
+      },
+      1);
+
+  // Close the gaps left by comments and empty lines.
+  SizeType size = 0;
+  edges.num_of_nodes = 0;
+  for (SizeType i = 0; i < num_of_chunks; ++i) {
+    if (!valid[i])
+      return false;
+    if (size != position[i]) {
+      std::move(edges.sources.begin() + position[i],
+                edges.sources.begin() + position[i] + num_of_edges[i],
+                edges.sources.begin() + size);
+      std::move(edges.targets.begin() + position[i],
+                edges.targets.begin() + position[i] + num_of_edges[i],
+                edges.targets.begin() + size);
+      std::move(edges.weights.begin() + position[i],
+                edges.weights.begin() + position[i] + num_of_edges[i],
+                edges.weights.begin() + size);
+    }
+    size += num_of_edges[i];
+    edges.num_of_nodes = std::max(edges.num_of_nodes, num_of_nodes[i]);
+  }
+  edges.sources.resize(size);
+  edges.targets.resize(size);
+  edges.weights.resize(size);
+  return true;
+}
+
+/**
+ * Reads the edge list text file at `path`, see `parse_edge_list`. The file
+ * is memory mapped and parsed in place.
+ *
+ * @returns false if the file cannot be read or has a malformed line.
+ */
+template <typename EdgeValueT>
+bool read_edge_list(const std::string& path, EdgeList<EdgeValueT>& edges,
+                    ThreadPool& pool) {
+  details::MappedFile file;
+  if (!file.open(path))
+    return false;
+  return parse_edge_list(file.data(), file.data() + file.size(), edges, pool);
+}
+
+/**
+ * Same as above, running on a temporary pool with one thread per hardware
+ * thread.
+ */
+template <typename EdgeValueT>
+bool read_edge_list(const std::string& path, EdgeList<EdgeValueT>& edges) {
+  ThreadPool pool;
+  return read_edge_list(path, edges, pool);
+}
+
+/**
+ * Builds a `CSRGraph` from `edges` in bulk: out-degrees are counted, turned
+ * into row offsets by a prefix sum, and edges are scattered into their rows
+ * in input order. Rows are then sorted by target in parallel, and repeated
+ * edges keep the weight that appears last, as with `CSRGraph(sz, edges)`.
+ *
+ * @param sz number of nodes, at least `edges.num_of_nodes`, or 0 for
+ * `edges.num_of_nodes`.
+ * @param pool threads to run on.
+ */
+template <typename ValueT, typename EdgeValueT>
+CSRGraph<ValueT, EdgeValueT> build_csr_graph(const EdgeList<EdgeValueT>& edges,
+                                             ThreadPool& pool,
+                                             std::size_t sz = 0,
+                                             std::size_t root = 0) {
+  using SizeType = std::size_t;
+  sz = std::max(sz, edges.num_of_nodes);
+  const SizeType num_of_edges = edges.size();
+  std::vector<SizeType> offsets(sz + 1, 0);
+  for (SizeType e = 0; e < num_of_edges; ++e) {
+    ++offsets[edges.sources[e] + 1];
+  }
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    offsets[u_i + 1] += offsets[u_i];
+  }
+  std::vector<std::pair<SizeType, EdgeValueT>> scattered(num_of_edges);
+  {
+    std::vector<SizeType> position(offsets.begin(), offsets.end() - 1);
+    for (SizeType e = 0; e < num_of_edges; ++e) {
+      scattered[position[edges.sources[e]]++] = {edges.targets[e],
+                                                 edges.weights[e]};
+    }
+  }
+
+  // Sort and deduplicate every row in place, then compact the rows.
+  std::vector<SizeType> degree(sz);
+  pool.parallel_for(0, sz, [&](SizeType u_i, SizeType) {
+    auto first = scattered.begin() + offsets[u_i];
+    auto last = scattered.begin() + offsets[u_i + 1];
+    std::stable_sort(first, last, [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    });
+    auto out = first;
+    for (auto it = first; it != last; ++it) {
+      if (std::next(it) != last && std::next(it)->first == it->first)
+        continue;
+      *out++ = *it;
+    }
+    degree[u_i] = static_cast<SizeType>(out - first);
+  });
+  std::vector<SizeType> compact_offsets(sz + 1, 0);
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    compact_offsets[u_i + 1] = compact_offsets[u_i] + degree[u_i];
+  }
+  std::vector<SizeType> targets(compact_offsets[sz]);
+  std::vector<EdgeValueT> weights(compact_offsets[sz]);
+  pool.parallel_for(0, sz, [&](SizeType u_i, SizeType) {
+    for (SizeType a = 0; a < degree[u_i]; ++a) {
+      targets[compact_offsets[u_i] + a] = scattered[offsets[u_i] + a].first;
+      weights[compact_offsets[u_i] + a] = scattered[offsets[u_i] + a].second;
+    }
+  });
+  return CSRGraph<ValueT, EdgeValueT>(
+      std::move(compact_offsets), std::move(targets), std::move(weights),
+      std::vector<ValueT>(sz), root);
+}
+
+/**
+ * Builds a `Graph` from `edges` in bulk: the rows are first laid out as
+ * with `build_csr_graph`, then every adjacency map is filled in parallel
+ * from its sorted row, which makes each insertion amortized O(1) instead of
+ * O(log degree) per `add_directed_edge`.
+ */
+template <typename ValueT, typename EdgeValueT>
+Graph<ValueT, EdgeValueT> build_graph(const EdgeList<EdgeValueT>& edges,
+                                      ThreadPool& pool, std::size_t sz = 0,
+                                      std::size_t root = 0) {
+  using SizeType = std::size_t;
+  auto csr_graph = build_csr_graph<ValueT>(edges, pool, sz, root);
+  Graph<ValueT, EdgeValueT> graph(csr_graph.size(), root);
+  pool.parallel_for(0, csr_graph.size(), [&](SizeType u_i, SizeType) {
+    auto& adjacency = graph[u_i].edges;
+    for (auto edge : csr_graph[u_i].edges) {
+      adjacency.emplace_hint(adjacency.end(), edge.first, edge.second);
+    }
+  });
+  return graph;
+}
+
+} // namespace dragon
+
+#endif
@@ -0,0 +1,330 @@
+#ifndef DRAGON_GRAPH_FLOYD_WARSHALL_HPP
+#define DRAGON_GRAPH_FLOYD_WARSHALL_HPP
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "dragon/core/thread-pool.hpp"
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+namespace details {
+/// Side of the square tiles processed by `FloydWarshall`, in elements.
+constexpr std::size_t floyd_warshall_block = 64;
+
+/**
+ * Internal "infinity" of `FloydWarshall`. For integers it is half the
+ * maximum so that adding two of them never overflows, and any value past a
+ * quarter of the maximum counts as unreachable: sums involving infinity land
+ * there even with negative edges.
+ */
+template <typename EdgeValueT>
+EdgeValueT floyd_warshall_inf(std::true_type /* is_integral */) {
+  return std::numeric_limits<EdgeValueT>::max() / 2;
+}
+template <typename EdgeValueT>
+EdgeValueT floyd_warshall_inf(std::false_type /* is_integral */) {
+  return std::numeric_limits<EdgeValueT>::infinity();
+}
+template <typename EdgeValueT>
+EdgeValueT floyd_warshall_unreachable(std::true_type /* is_integral */) {
+  return std::numeric_limits<EdgeValueT>::max() / 4;
+}
+template <typename EdgeValueT>
+EdgeValueT floyd_warshall_unreachable(std::false_type /* is_integral */) {
+  return std::numeric_limits<EdgeValueT>::max();
+}
+
+/**
+ * Min-plus kernel: `c[j] = min(c[j], a + b[j])` for `j` in `[0, n)`. `c` and
+ * `b` must not overlap. The loop is branch free over restrict pointers so
+ * that compilers turn it into packed adds and mins for 32 and 64 bit
+ * integers and floating point types.
+ */
+template <typename EdgeValueT>
+void min_plus(EdgeValueT* __restrict c, EdgeValueT a,
+              const EdgeValueT* __restrict b, std::size_t n) {
+  for (std::size_t j = 0; j < n; ++j) {
+    EdgeValueT s = a + b[j];
+    c[j] = s < c[j] ? s : c[j];
+  }
+}
+
+/**
+ * Same as above, also setting `next[j] = next_k` wherever `c[j]` improves.
+ */
+template <typename EdgeValueT, typename SizeT>
+void min_plus(EdgeValueT* __restrict c, SizeT* __restrict next, EdgeValueT a,
+              SizeT next_k, const EdgeValueT* __restrict b, std::size_t n) {
+  for (std::size_t j = 0; j < n; ++j) {
+    EdgeValueT s = a + b[j];
+    bool better = s < c[j];
+    c[j] = better ? s : c[j];
+    next[j] = better ? next_k : next[j];
+  }
+}
+} // namespace details
+
+/**
+ * All pairs shortest paths of a dense graph with the Floyd-Warshall
+ * algorithm, in O(V^3) time and O(V^2) memory. Edge weights may be negative.
+ *
+ * Distances live in a flat row-major matrix whose rows are padded to a
+ * multiple of `details::floyd_warshall_block`. The matrix is processed as
+ * square tiles in the usual three phases per diagonal tile: the diagonal
+ * tile itself, then the tiles of its row and column, then all remaining
+ * tiles. Tiles of the second and third phases are independent of each other
+ * and run on the threads of a `ThreadPool`; each one only touches three
+ * tiles, which stay in L1/L2 cache. The innermost loop is a min-plus update
+ * of one contiguous tile row, written to be vectorized by the compiler.
+ *
+ * Integer weights must keep every path weight within a quarter of
+ * `std::numeric_limits<EdgeValueType>::max()` in absolute value.
+ *
+ * @param EdgeValueT edge weight type of the graphs to process.
+ */
+template <typename EdgeValueT> class FloydWarshall {
+public:
+  using SizeType = std::size_t;
+  using EdgeValueType = EdgeValueT;
+
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+  static constexpr EdgeValueType inf_weight =
+      std::numeric_limits<EdgeValueType>::max();
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+  static constexpr SizeType block = details::floyd_warshall_block;
+
+public:
+  /**
+   * Computes the shortest path weight between every pair of nodes of
+   * `graph` on the threads of `pool`.
+   *
+   * @param record_next_hop also record the first hop of every shortest path,
+   * needed by `next_hop()` and `path()`.
+   */
+  template <typename GraphT>
+  FloydWarshall(const GraphT& graph, ThreadPool& pool,
+                bool record_next_hop = false) {
+    compute(graph, pool, record_next_hop);
+  }
+
+  /**
+   * Same as above, running on a temporary pool with one thread per hardware
+   * thread.
+   */
+  template <typename GraphT>
+  explicit FloydWarshall(const GraphT& graph, bool record_next_hop = false) {
+    ThreadPool pool;
+    compute(graph, pool, record_next_hop);
+  }
+
+  FloydWarshall(const FloydWarshall&) = default;
+  FloydWarshall(FloydWarshall&&) noexcept = default;
+  FloydWarshall& operator=(const FloydWarshall&) = default;
+  FloydWarshall& operator=(FloydWarshall&&) noexcept = default;
+  ~FloydWarshall() = default;
+
+  /// Returns the number of nodes.
+  SizeType size() const { return m_size; }
+
+  /// Returns the distance between the starts of two consecutive rows.
+  SizeType stride() const { return m_stride; }
+
+  /**
+   * Returns the shortest path weight from `u` to `v`, `inf_weight` if `v` is
+   * unreachable from `u`.
+   */
+  EdgeValueType operator()(SizeType u, SizeType v) const {
+    return m_dist[u * m_stride + v];
+  }
+
+  /// Returns the `size()` distances from `u`, see `operator()`.
+  const EdgeValueType* row(SizeType u) const {
+    return m_dist.data() + u * m_stride;
+  }
+
+  /// Returns true if the graph has a negative weight cycle, in which case
+  /// the distances are meaningless.
+  bool has_negative_cycle() const { return m_negative_cycle; }
+
+  /// Returns true if next hops were recorded.
+  bool has_next_hop() const { return !m_next.empty(); }
+
+  /**
+   * Returns the node following `u` on a shortest path from `u` to `v`, `v`
+   * itself if `u == v`, `npos` if `v` is unreachable.
+   */
+  SizeType next_hop(SizeType u, SizeType v) const {
+    return m_next[u * m_stride + v];
+  }
+
+  /**
+   * Returns the nodes of a shortest path from `u` to `v`, both included, or
+   * an empty vector if `v` is unreachable. Requires recorded next hops and no
+   * negative cycle.
+   */
+  Sequence<SizeType> path(SizeType u, SizeType v) const;
+
+private:
+  template <typename GraphT>
+  void compute(const GraphT& graph, ThreadPool& pool, bool record_next_hop);
+  /// Runs the min-plus updates of tile `(i_b, j_b)` through tile `k_b`.
+  void update_tile(SizeType i_b, SizeType j_b, SizeType k_b);
+  EdgeValueType* tile_row(SizeType i, SizeType j_b) {
+    return m_dist.data() + i * m_stride + j_b * block;
+  }
+
+private:
+  SizeType m_size = 0;
+  SizeType m_stride = 0;
+  Sequence<EdgeValueType> m_dist;
+  /// Next hops in the same layout as `m_dist`, empty if not recorded.
+  Sequence<SizeType> m_next;
+  bool m_negative_cycle = false;
+  /// Distances from this value up stand for unreachable.
+  EdgeValueType m_unreachable = 0;
+};
+
+template <typename EdgeValueT>
+constexpr typename FloydWarshall<EdgeValueT>::SizeType
+    FloydWarshall<EdgeValueT>::npos;
+template <typename EdgeValueT>
+constexpr typename FloydWarshall<EdgeValueT>::EdgeValueType
+    FloydWarshall<EdgeValueT>::inf_weight;
+template <typename EdgeValueT>
+constexpr typename FloydWarshall<EdgeValueT>::SizeType
+    FloydWarshall<EdgeValueT>::block;
+
+template <typename EdgeValueT>
+template <typename GraphT>
+void FloydWarshall<EdgeValueT>::compute(const GraphT& graph, ThreadPool& pool,
+                                        bool record_next_hop) {
+  using IsIntegral = std::is_integral<EdgeValueType>;
+  const auto inf = details::floyd_warshall_inf<EdgeValueType>(IsIntegral());
+  m_unreachable =
+      details::floyd_warshall_unreachable<EdgeValueType>(IsIntegral());
+  m_size = graph.size();
+  m_stride = (m_size + block - 1) / block * block;
+  m_dist.assign(m_stride * m_stride, inf);
+  if (record_next_hop)
+    m_next.assign(m_stride * m_stride, npos);
+  for (SizeType u_i = 0; u_i < m_size; ++u_i) {
+    m_dist[u_i * m_stride + u_i] = 0;
+    if (record_next_hop)
+      m_next[u_i * m_stride + u_i] = u_i;
+  }
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      SizeType pos = u.index() * m_stride + edge.first;
+      if (edge.second < m_dist[pos]) {
+        m_dist[pos] = edge.second;
+        if (record_next_hop)
+          m_next[pos] = edge.first;
+      }
+    }
+  }
+
+  const SizeType num_of_blocks = m_stride / block;
+  for (SizeType k_b = 0; k_b < num_of_blocks; ++k_b) {
+    update_tile(k_b, k_b, k_b);
+    // Tiles sharing a row or column with the diagonal tile.
+    pool.parallel_for(
+        0, 2 * num_of_blocks,
+        [&](SizeType i, SizeType) {
+          SizeType other = i / 2;
+          if (other == k_b)
+            return;
+          if (i % 2 == 0)
+            update_tile(k_b, other, k_b);
+          else
+            update_tile(other, k_b, k_b);
+        },
+        1);
+    // All the other tiles.
+    pool.parallel_for(
+        0, num_of_blocks * num_of_blocks,
+        [&](SizeType i, SizeType) {
+          SizeType i_b = i / num_of_blocks, j_b = i % num_of_blocks;
+          if (i_b != k_b && j_b != k_b)
+            update_tile(i_b, j_b, k_b);
+        },
+        1);
+  }
+
+  pool.parallel_for(0, m_size, [&](SizeType u_i, SizeType) {
+    for (SizeType v_i = 0; v_i < m_size; ++v_i) {
+      SizeType pos = u_i * m_stride + v_i;
+      if (!(m_dist[pos] < m_unreachable)) {
+        m_dist[pos] = inf_weight;
+        if (record_next_hop)
+          m_next[pos] = npos;
+      }
+    }
+  });
+  for (SizeType u_i = 0; u_i < m_size; ++u_i) {
+    if (m_dist[u_i * m_stride + u_i] < EdgeValueType(0))
+      m_negative_cycle = true;
+  }
+}
+
+template <typename EdgeValueT>
+void FloydWarshall<EdgeValueT>::update_tile(SizeType i_b, SizeType j_b,
+                                            SizeType k_b) {
+  const bool record_next_hop = has_next_hop();
+  // When the tile lies in row `k_b`, row `k` of the tile is both read and
+  // written; its update through `k` is a no-op unless `k` is on a negative
+  // cycle, so it is skipped to keep the kernel operands disjoint.
+  const bool same_rows = i_b == k_b;
+  // Rows of tile `(i_b, j_b)` depend on the `k` loop when it lies in row or
+  // column `k_b`, so `k` is the outer loop; otherwise `i` is, for locality.
+  if (same_rows || j_b == k_b) {
+    for (SizeType k = k_b * block; k < (k_b + 1) * block; ++k) {
+      const EdgeValueType* b = tile_row(k, j_b);
+      for (SizeType i = i_b * block; i < (i_b + 1) * block; ++i) {
+        EdgeValueType a = m_dist[i * m_stride + k];
+        if ((same_rows && i == k) || !(a < m_unreachable))
+          continue;
+        if (record_next_hop)
+          details::min_plus(tile_row(i, j_b),
+                            m_next.data() + i * m_stride + j_b * block, a,
+                            m_next[i * m_stride + k], b, block);
+        else
+          details::min_plus(tile_row(i, j_b), a, b, block);
+      }
+    }
+    return;
+  }
+  for (SizeType i = i_b * block; i < (i_b + 1) * block; ++i) {
+    for (SizeType k = k_b * block; k < (k_b + 1) * block; ++k) {
+      EdgeValueType a = m_dist[i * m_stride + k];
+      if (!(a < m_unreachable))
+        continue;
+      if (record_next_hop)
+        details::min_plus(tile_row(i, j_b),
+                          m_next.data() + i * m_stride + j_b * block, a,
+                          m_next[i * m_stride + k], tile_row(k, j_b), block);
+      else
+        details::min_plus(tile_row(i, j_b), a, tile_row(k, j_b), block);
+    }
+  }
+}
+
+template <typename EdgeValueT>
+std::vector<typename FloydWarshall<EdgeValueT>::SizeType>
+FloydWarshall<EdgeValueT>::path(SizeType u, SizeType v) const {
+  Sequence<SizeType> nodes;
+  if (next_hop(u, v) == npos)
+    return nodes;
+  nodes.push_back(u);
+  while (u != v) {
+    u = next_hop(u, v);
+    nodes.push_back(u);
+  }
+  return nodes;
+}
+
+} // namespace dragon
+
+#endif
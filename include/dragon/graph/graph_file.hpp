@@ -0,0 +1,411 @@
+#ifndef DRAGON_GRAPH_GRAPH_FILE_HPP
+#define DRAGON_GRAPH_GRAPH_FILE_HPP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "dragon/graph/csr_graph.hpp"
+
+namespace dragon {
+namespace details {
+/**
+ * Header of a graph file, followed by four sections, each starting at a
+ * multiple of 8 bytes: offsets (`num_of_nodes + 1` sizes), targets
+ * (`num_of_edges` sizes), weights (`num_of_edges` edge values) and values
+ * (`num_of_nodes` node values). Everything is stored in the byte order and
+ * representation of the writing machine, which the header records so that
+ * other machines refuse the file instead of misreading it.
+ */
+struct GraphFileHeader {
+  char magic[8];
+  std::uint32_t version;
+  /// `graph_file_byte_order` as written, reads differently on other orders.
+  std::uint32_t byte_order;
+  std::uint32_t size_bytes;
+  std::uint32_t value_bytes;
+  std::uint32_t value_kind;
+  std::uint32_t edge_value_bytes;
+  std::uint32_t edge_value_kind;
+  std::uint32_t reserved;
+  std::uint64_t num_of_nodes;
+  std::uint64_t num_of_edges;
+  std::uint64_t root;
+};
+static_assert(sizeof(GraphFileHeader) == 64,
+              "dragon::GraphFileHeader: unexpected padding");
+
+constexpr char graph_file_magic[8] = {'D', 'R', 'A', 'G',
+                                      'O', 'N', 'G', '\0'};
+constexpr std::uint32_t graph_file_version = 1;
+constexpr std::uint32_t graph_file_byte_order = 0x01020304;
+
+/// Coarse kind of an arithmetic type, to tell `int` from `float`.
+template <typename T> constexpr std::uint32_t graph_file_kind() {
+  return std::is_floating_point<T>::value ? 2
+         : std::is_signed<T>::value       ? 1
+         : std::is_integral<T>::value     ? 0
+                                          : 3;
+}
+
+/// Rounds `bytes` up to the next multiple of 8.
+constexpr std::uint64_t graph_file_align(std::uint64_t bytes) {
+  return (bytes + 7) / 8 * 8;
+}
+
+template <typename ValueT, typename EdgeValueT>
+GraphFileHeader graph_file_header(std::uint64_t num_of_nodes,
+                                  std::uint64_t num_of_edges,
+                                  std::uint64_t root) {
+  GraphFileHeader header{};
+  std::memcpy(header.magic, graph_file_magic, sizeof(header.magic));
+  header.version = graph_file_version;
+  header.byte_order = graph_file_byte_order;
+  header.size_bytes = sizeof(std::size_t);
+  header.value_bytes = sizeof(ValueT);
+  header.value_kind = graph_file_kind<ValueT>();
+  header.edge_value_bytes = sizeof(EdgeValueT);
+  header.edge_value_kind = graph_file_kind<EdgeValueT>();
+  header.num_of_nodes = num_of_nodes;
+  header.num_of_edges = num_of_edges;
+  header.root = root;
+  return header;
+}
+
+/// Writes `data` followed by zeros up to a multiple of 8 bytes.
+inline void graph_file_write(std::ofstream& out, const void* data,
+                             std::uint64_t bytes) {
+  const char zeros[8] = {};
+  out.write(static_cast<const char*>(data),
+            static_cast<std::streamsize>(bytes));
+  out.write(zeros, static_cast<std::streamsize>(graph_file_align(bytes) -
+                                                bytes));
+}
+} // namespace details
+
+/**
+ * Writes `graph` (a `Graph`, a `CSRGraph` or anything with the same read
+ * interface) to `path` in the binary graph format read by
+ * `MappedCSRGraph`. Edges are streamed through a small buffer, so the
+ * graph is never copied as a whole.
+ *
+ * @returns false if the file could not be written.
+ */
+template <typename GraphT>
+bool write_graph_file(const std::string& path, const GraphT& graph) {
+  using SizeType = std::size_t;
+  using ValueType = typename GraphT::ValueType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  static_assert(std::is_trivially_copyable<ValueType>::value &&
+                    std::is_trivially_copyable<EdgeValueType>::value,
+                "dragon::write_graph_file: node values and edge weights "
+                "must be trivially copyable");
+  const SizeType buffer_size = SizeType(1) << 16;
+  const SizeType sz = graph.size();
+
+  std::vector<SizeType> offsets(sz + 1, 0);
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    offsets[u_i + 1] = offsets[u_i] + graph[u_i].edges.size();
+  }
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out)
+    return false;
+  auto header = details::graph_file_header<ValueType, EdgeValueType>(
+      sz, offsets[sz], graph.root());
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  details::graph_file_write(out, offsets.data(),
+                            offsets.size() * sizeof(SizeType));
+
+  // Sections are written one after the other in chunks of `buffer_size`.
+  auto write_section = [&](auto&& get, auto element) {
+    std::vector<decltype(element)> buffer;
+    buffer.reserve(buffer_size);
+    std::uint64_t bytes = 0;
+    auto flush = [&] {
+      out.write(reinterpret_cast<const char*>(buffer.data()),
+                static_cast<std::streamsize>(buffer.size() *
+                                             sizeof(element)));
+      bytes += buffer.size() * sizeof(element);
+      buffer.clear();
+    };
+    get([&](const decltype(element)& x) {
+      buffer.push_back(x);
+      if (buffer.size() == buffer_size)
+        flush();
+    });
+    flush();
+    const char zeros[8] = {};
+    out.write(zeros, static_cast<std::streamsize>(
+                         details::graph_file_align(bytes) - bytes));
+  };
+  write_section(
+      [&](auto&& emit) {
+        for (SizeType u_i = 0; u_i < sz; ++u_i) {
+          for (auto edge : graph[u_i].edges) {
+            emit(edge.first);
+          }
+        }
+      },
+      SizeType());
+  write_section(
+      [&](auto&& emit) {
+        for (SizeType u_i = 0; u_i < sz; ++u_i) {
+          for (auto edge : graph[u_i].edges) {
+            emit(edge.second);
+          }
+        }
+      },
+      EdgeValueType());
+  write_section(
+      [&](auto&& emit) {
+        for (SizeType u_i = 0; u_i < sz; ++u_i) {
+          emit(graph[u_i].value);
+        }
+      },
+      ValueType());
+  out.close();
+  return static_cast<bool>(out);
+}
+
+/**
+ * `MappedCSRGraph` is a read-only graph backed by a file written with
+ * `write_graph_file`. The file is memory mapped and its arrays are used in
+ * place, so opening takes constant time whatever the size of the graph,
+ * and pages are only read from disk when an algorithm first touches them.
+ *
+ * It exposes the same read interface as `CSRGraph` (`graph[u].edges`,
+ * `graph[u].value`, `graph[u].index()`, iteration over nodes, `size()`,
+ * `root()`), so algorithms templated on `GraphT` accept it too.
+ *
+ * @param ValueT type of value of graph nodes, as written.
+ * @param EdgeValueT type of weight of graph edges, as written.
+ *
+ * @note Uses POSIX `mmap`.
+ */
+template <typename ValueT, typename EdgeValueT = int> class MappedCSRGraph {
+public:
+  using ValueType = ValueT;
+  using EdgeValueType = EdgeValueT;
+  using SizeType = std::size_t;
+  using AdjacencyStructureType = details::CSREdgeRange<SizeType, EdgeValueType>;
+  using Node = typename CSRGraph<ValueType, EdgeValueType>::Node;
+
+  using size_type = SizeType; // NOLINT
+
+  class const_iterator { // NOLINT
+  public:
+    using iterator_category = std::forward_iterator_tag; // NOLINT
+    using value_type = Node;                             // NOLINT
+    using difference_type = std::ptrdiff_t;              // NOLINT
+    using reference = Node;                              // NOLINT
+    using pointer = void;                                // NOLINT
+
+    const_iterator(const MappedCSRGraph* graph, SizeType index)
+        : m_graph(graph), m_index(index) {}
+    Node operator*() const { return (*m_graph)[m_index]; }
+    const_iterator& operator++() {
+      ++m_index;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto temp = *this;
+      ++m_index;
+      return temp;
+    }
+    friend bool operator==(const const_iterator& a, const const_iterator& b) {
+      return a.m_index == b.m_index;
+    }
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) {
+      return a.m_index != b.m_index;
+    }
+
+  private:
+    const MappedCSRGraph* m_graph;
+    SizeType m_index;
+  };
+  using iterator = const_iterator; // NOLINT
+
+public:
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+  static constexpr EdgeValueType
+      nweight = std::numeric_limits<EdgeValueType>::max();
+
+public:
+  /// Creates an empty graph, see `open`.
+  MappedCSRGraph() = default;
+  MappedCSRGraph(const MappedCSRGraph&) = delete;
+  MappedCSRGraph(MappedCSRGraph&& other) noexcept { swap(other); }
+  MappedCSRGraph& operator=(const MappedCSRGraph&) = delete;
+  MappedCSRGraph& operator=(MappedCSRGraph&& other) noexcept {
+    MappedCSRGraph(std::move(other)).swap(*this);
+    return *this;
+  }
+  ~MappedCSRGraph() { close(); }
+
+  /**
+   * Maps the graph file at `path`, closing the current one first.
+   *
+   * @returns false if the file cannot be mapped, is not a graph file, was
+   * written with another version of the format, on a machine with another
+   * byte order, or with other node value or edge weight types. The graph is
+   * then empty.
+   */
+  bool open(const std::string& path);
+
+  /// Unmaps the file, leaving an empty graph.
+  void close();
+
+  /// Returns a view of the ith node of the graph.
+  Node operator[](SizeType index) const {
+    return Node(index, m_values[index], edges(index));
+  }
+
+  /// Returns the out-edges of the ith node of the graph.
+  AdjacencyStructureType edges(SizeType index) const {
+    return AdjacencyStructureType(m_targets + m_offsets[index],
+                                  m_weights + m_offsets[index],
+                                  m_offsets[index + 1] - m_offsets[index]);
+  }
+
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator end() const { return {this, size()}; }
+  const_iterator cend() const { return end(); }
+
+  /// Returns the number of nodes in the graph.
+  SizeType size() const { return m_size; }
+
+  /// Returns the number of directed edges in the graph.
+  SizeType num_edges() const { return m_size == 0 ? 0 : m_offsets[m_size]; }
+
+  /// Returns the out-degree of the ith node.
+  SizeType degree(SizeType index) const {
+    return m_offsets[index + 1] - m_offsets[index];
+  }
+
+  /// Returns the index of the root node.
+  SizeType root() const { return m_root; }
+
+  /// Raw CSR arrays, pointing into the mapped file.
+  const SizeType* offsets() const { return m_offsets; }
+  const SizeType* targets() const { return m_targets; }
+  const EdgeValueType* weights() const { return m_weights; }
+  const ValueType* values() const { return m_values; }
+
+private:
+  void swap(MappedCSRGraph& other) noexcept {
+    std::swap(m_mapping, other.m_mapping);
+    std::swap(m_mapping_size, other.m_mapping_size);
+    std::swap(m_offsets, other.m_offsets);
+    std::swap(m_targets, other.m_targets);
+    std::swap(m_weights, other.m_weights);
+    std::swap(m_values, other.m_values);
+    std::swap(m_size, other.m_size);
+    std::swap(m_root, other.m_root);
+  }
+
+private:
+  void* m_mapping = nullptr;
+  std::size_t m_mapping_size = 0;
+  const SizeType* m_offsets = nullptr;
+  const SizeType* m_targets = nullptr;
+  const EdgeValueType* m_weights = nullptr;
+  const ValueType* m_values = nullptr;
+  SizeType m_size = 0;
+  SizeType m_root = 0;
+};
+
+template <typename ValueT, typename EdgeValueT>
+constexpr typename MappedCSRGraph<ValueT, EdgeValueT>::SizeType
+    MappedCSRGraph<ValueT, EdgeValueT>::npos;
+template <typename ValueT, typename EdgeValueT>
+constexpr typename MappedCSRGraph<ValueT, EdgeValueT>::EdgeValueType
+    MappedCSRGraph<ValueT, EdgeValueT>::nweight;
+
+template <typename ValueT, typename EdgeValueT>
+bool MappedCSRGraph<ValueT, EdgeValueT>::open(const std::string& path) {
+  close();
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat status;
+  if (::fstat(fd, &status) != 0 ||
+      static_cast<std::uint64_t>(status.st_size) <
+          sizeof(details::GraphFileHeader)) {
+    ::close(fd);
+    return false;
+  }
+  const auto file_size = static_cast<std::size_t>(status.st_size);
+  void* mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping keeps the file alive.
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+    return false;
+  m_mapping = mapping;
+  m_mapping_size = file_size;
+
+  const auto* bytes = static_cast<const char*>(mapping);
+  details::GraphFileHeader header;
+  std::memcpy(&header, bytes, sizeof(header));
+  const auto expected = details::graph_file_header<ValueType, EdgeValueType>(
+      header.num_of_nodes, header.num_of_edges, header.root);
+  if (std::memcmp(&header, &expected, sizeof(header)) != 0 ||
+      header.num_of_nodes >= std::numeric_limits<SizeType>::max() / 16 ||
+      header.num_of_edges >= std::numeric_limits<SizeType>::max() / 16) {
+    close();
+    return false;
+  }
+  const std::uint64_t sz = header.num_of_nodes;
+  const std::uint64_t num_of_edges = header.num_of_edges;
+  std::uint64_t position = sizeof(header);
+  const std::uint64_t offsets_position = position;
+  position += details::graph_file_align((sz + 1) * sizeof(SizeType));
+  const std::uint64_t targets_position = position;
+  position += details::graph_file_align(num_of_edges * sizeof(SizeType));
+  const std::uint64_t weights_position = position;
+  position +=
+      details::graph_file_align(num_of_edges * sizeof(EdgeValueType));
+  const std::uint64_t values_position = position;
+  position += details::graph_file_align(sz * sizeof(ValueType));
+  if (position != file_size) {
+    close();
+    return false;
+  }
+  m_offsets = reinterpret_cast<const SizeType*>(bytes + offsets_position);
+  m_targets = reinterpret_cast<const SizeType*>(bytes + targets_position);
+  m_weights =
+      reinterpret_cast<const EdgeValueType*>(bytes + weights_position);
+  m_values = reinterpret_cast<const ValueType*>(bytes + values_position);
+  m_size = static_cast<SizeType>(sz);
+  m_root = static_cast<SizeType>(header.root);
+  if (m_offsets[m_size] != num_of_edges) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+template <typename ValueT, typename EdgeValueT>
+void MappedCSRGraph<ValueT, EdgeValueT>::close() {
+  if (m_mapping != nullptr)
+    ::munmap(m_mapping, m_mapping_size);
+  m_mapping = nullptr;
+  m_mapping_size = 0;
+  m_offsets = m_targets = nullptr;
+  m_weights = nullptr;
+  m_values = nullptr;
+  m_size = 0;
+  m_root = 0;
+}
+
+} // namespace dragon
+
+#endif
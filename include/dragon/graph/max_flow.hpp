@@ -0,0 +1,508 @@
+#ifndef DRAGON_GRAPH_MAX_FLOW_HPP
+#define DRAGON_GRAPH_MAX_FLOW_HPP
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+
+/**
+ * `FlowNetwork` is a directed graph with edge capacities on which maximum
+ * flows are computed.
+ *
+ * The residual graph lives in flat arrays sorted by tail node: every edge
+ * becomes a forward arc and a paired reverse arc, and each arc stores the
+ * index of its partner. Arrays are laid out on the first solve after edges
+ * were added; every solve starts again from the zero flow.
+ *
+ * Two algorithms are available:
+ * - `dinic`: Dinic's blocking flows, with current-arc pointers and an
+ *   iterative augmenting path search. Good on unit capacity and bipartite
+ *   networks.
+ * - `push_relabel`: highest-label push-relabel with the global relabeling
+ *   and gap heuristics. Usually the fastest on large, dense or deep
+ *   networks.
+ *
+ * @param CapacityT capacity type, integral types give exact results.
+ */
+template <typename CapacityT> class FlowNetwork {
+public:
+  using SizeType = std::size_t;
+  using CapacityType = CapacityT;
+
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+
+public:
+  explicit FlowNetwork(SizeType sz = 0) : m_size(sz) {}
+
+  /**
+   * Builds a network with one edge per edge of `graph`, using edge weights
+   * as capacities. Edge `i` is the `i`-th edge met iterating over the nodes
+   * of `graph` and their edges in order.
+   */
+  template <typename GraphT, typename = std::enable_if_t<
+                                 std::is_class<GraphT>::value>>
+  explicit FlowNetwork(const GraphT& graph);
+
+  FlowNetwork(const FlowNetwork&) = default;
+  FlowNetwork(FlowNetwork&&) noexcept = default;
+  FlowNetwork& operator=(const FlowNetwork&) = default;
+  FlowNetwork& operator=(FlowNetwork&&) noexcept = default;
+  ~FlowNetwork() = default;
+
+  /**
+   * Adds an edge `u_i -> v_i` with capacity `capacity` and returns its id.
+   * Parallel edges and edges in both directions are allowed.
+   */
+  SizeType add_edge(SizeType u_i, SizeType v_i, CapacityType capacity);
+
+  /// Returns the number of nodes.
+  SizeType size() const { return m_size; }
+
+  /// Returns the number of edges added.
+  SizeType num_of_edges() const { return m_edge_tails.size(); }
+
+  /// Returns the maximum flow from `source` to `sink` with Dinic's
+  /// algorithm.
+  CapacityType dinic(SizeType source, SizeType sink);
+
+  /// Returns the maximum flow from `source` to `sink` with highest-label
+  /// push-relabel.
+  CapacityType push_relabel(SizeType source, SizeType sink);
+
+  /// Returns the flow on edge `edge` in the last computed maximum flow.
+  CapacityType flow(SizeType edge) const {
+    SizeType a = m_edge_arc[edge];
+    return m_capacity[a] - m_residual[a];
+  }
+
+  /**
+   * Returns the source side of a minimum cut of the last computed maximum
+   * flow: the nodes reachable from the source in the residual graph. The
+   * edges leaving it are saturated and their capacities add up to the flow
+   * value.
+   */
+  Sequence<bool> min_cut() const;
+
+private:
+  /// Lays out the arcs if needed, and resets every arc to zero flow.
+  void prepare(SizeType source);
+  void push(SizeType a, CapacityType delta) {
+    m_residual[a] -= delta;
+    m_residual[m_reverse[a]] += delta;
+    m_excess[m_heads[a]] += delta;
+    m_excess[m_heads[m_reverse[a]]] -= delta;
+  }
+  /// Sets `m_level` to the residual distance to `sink`, returns true if the
+  /// source can reach it. Searching from the sink keeps the level graph to
+  /// arcs on shortest paths to the sink.
+  bool dinic_levels(SizeType sink);
+  CapacityType dinic_blocking_flow(SizeType sink);
+  /// Sets heights to exact residual distances to `sink` and rebuilds the
+  /// height buckets.
+  void global_relabel(SizeType sink);
+  void bucket_insert(SizeType v_i);
+  void bucket_erase(SizeType v_i);
+  /// Pushes the excess of `u_i` along admissible arcs, relabeling it as
+  /// needed, until it has no excess or reaches height `size()`.
+  void discharge(SizeType u_i, SizeType sink);
+  /// Sends the excess left on nodes that cannot reach the sink back to the
+  /// source, turning the preflow into a flow.
+  void return_excess(SizeType sink);
+
+private:
+  SizeType m_size = 0;
+  /// Edges as added.
+  Sequence<SizeType> m_edge_tails, m_edge_heads;
+  Sequence<CapacityType> m_edge_capacity;
+
+  /// Residual graph: arcs of node `u` are `[m_offsets[u], m_offsets[u + 1])`.
+  bool m_built = false;
+  Sequence<SizeType> m_offsets;
+  Sequence<SizeType> m_heads;
+  Sequence<SizeType> m_reverse;
+  Sequence<CapacityType> m_capacity;
+  Sequence<CapacityType> m_residual;
+  /// Forward arc of every edge.
+  Sequence<SizeType> m_edge_arc;
+
+  SizeType m_source = npos;
+  Sequence<SizeType> m_current;
+  Sequence<CapacityType> m_excess;
+  /// Dinic's level graph: residual distances to the sink, `npos` for
+  /// unreached or dead nodes.
+  Sequence<SizeType> m_level;
+  /// Arcs of Dinic's current augmenting path, from the source.
+  Sequence<SizeType> m_path;
+  Sequence<SizeType> m_queue;
+
+  /// Push-relabel state. Nodes below height `size()` are kept in a doubly
+  /// linked list per height, active ones also in a stack per height.
+  Sequence<SizeType> m_height;
+  Sequence<SizeType> m_bucket_head, m_next, m_prev;
+  Sequence<Sequence<SizeType>> m_active;
+  SizeType m_max_height = 0, m_max_active = 0;
+  SizeType m_relabels = 0;
+};
+
+template <typename CapacityT>
+constexpr typename FlowNetwork<CapacityT>::SizeType
+    FlowNetwork<CapacityT>::npos;
+
+template <typename CapacityT>
+template <typename GraphT, typename>
+FlowNetwork<CapacityT>::FlowNetwork(const GraphT& graph)
+    : m_size(graph.size()) {
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      add_edge(u.index(), edge.first, edge.second);
+    }
+  }
+}
+
+template <typename CapacityT>
+typename FlowNetwork<CapacityT>::SizeType
+FlowNetwork<CapacityT>::add_edge(SizeType u_i, SizeType v_i,
+                                 CapacityType capacity) {
+  m_edge_tails.push_back(u_i);
+  m_edge_heads.push_back(v_i);
+  m_edge_capacity.push_back(capacity);
+  m_built = false;
+  return m_edge_tails.size() - 1;
+}
+
+template <typename CapacityT>
+void FlowNetwork<CapacityT>::prepare(SizeType source) {
+  m_source = source;
+  if (!m_built) {
+    const SizeType num_of_arcs = 2 * m_edge_tails.size();
+    m_offsets.assign(m_size + 1, 0);
+    for (SizeType e = 0; e < m_edge_tails.size(); ++e) {
+      ++m_offsets[m_edge_tails[e] + 1];
+      ++m_offsets[m_edge_heads[e] + 1];
+    }
+    for (SizeType u_i = 0; u_i < m_size; ++u_i) {
+      m_offsets[u_i + 1] += m_offsets[u_i];
+    }
+    m_heads.resize(num_of_arcs);
+    m_reverse.resize(num_of_arcs);
+    m_capacity.resize(num_of_arcs);
+    m_edge_arc.resize(m_edge_tails.size());
+    Sequence<SizeType> position(m_offsets.begin(), m_offsets.end() - 1);
+    for (SizeType e = 0; e < m_edge_tails.size(); ++e) {
+      SizeType a = position[m_edge_tails[e]]++;
+      SizeType b = position[m_edge_heads[e]]++;
+      m_heads[a] = m_edge_heads[e];
+      m_heads[b] = m_edge_tails[e];
+      m_reverse[a] = b;
+      m_reverse[b] = a;
+      m_capacity[a] = m_edge_capacity[e];
+      m_capacity[b] = 0;
+      m_edge_arc[e] = a;
+    }
+    m_built = true;
+  }
+  m_residual = m_capacity;
+  m_current.assign(m_offsets.begin(), m_offsets.end() - 1);
+  m_excess.assign(m_size, 0);
+}
+
+template <typename CapacityT>
+bool FlowNetwork<CapacityT>::dinic_levels(SizeType sink) {
+  m_level.assign(m_size, npos);
+  m_queue.assign(1, sink);
+  m_level[sink] = 0;
+  for (SizeType head = 0; head < m_queue.size(); ++head) {
+    SizeType v_i = m_queue[head];
+    if (v_i == m_source)
+      break;
+    for (SizeType a = m_offsets[v_i]; a < m_offsets[v_i + 1]; ++a) {
+      SizeType u_i = m_heads[a];
+      if (m_level[u_i] == npos && m_residual[m_reverse[a]] > 0) {
+        m_level[u_i] = m_level[v_i] + 1;
+        m_queue.push_back(u_i);
+      }
+    }
+  }
+  return m_level[m_source] != npos;
+}
+
+template <typename CapacityT>
+typename FlowNetwork<CapacityT>::CapacityType
+FlowNetwork<CapacityT>::dinic_blocking_flow(SizeType sink) {
+  CapacityType total = 0;
+  Sequence<SizeType>& path = m_path;
+  path.clear();
+  SizeType u_i = m_source;
+  while (true) {
+    if (u_i == sink) {
+      CapacityType delta = m_residual[path[0]];
+      for (SizeType a : path) {
+        delta = std::min(delta, m_residual[a]);
+      }
+      for (SizeType a : path) {
+        m_residual[a] -= delta;
+        m_residual[m_reverse[a]] += delta;
+      }
+      total += delta;
+      // Retreat to the tail of the first saturated arc.
+      SizeType keep = 0;
+      while (m_residual[path[keep]] > 0) {
+        ++keep;
+      }
+      path.resize(keep);
+      u_i = keep == 0 ? m_source : m_heads[path.back()];
+      continue;
+    }
+    SizeType& a = m_current[u_i];
+    for (; a < m_offsets[u_i + 1]; ++a) {
+      SizeType v_i = m_heads[a];
+      if (m_residual[a] > 0 && m_level[v_i] + 1 == m_level[u_i])
+        break;
+    }
+    if (a < m_offsets[u_i + 1]) {
+      path.push_back(a);
+      u_i = m_heads[a];
+      continue;
+    }
+    // Dead end: remove `u_i` from the level graph and retreat.
+    if (u_i == m_source)
+      break;
+    m_level[u_i] = npos;
+    SizeType last = path.back();
+    path.pop_back();
+    u_i = m_heads[m_reverse[last]];
+    ++m_current[u_i];
+  }
+  return total;
+}
+
+template <typename CapacityT>
+typename FlowNetwork<CapacityT>::CapacityType
+FlowNetwork<CapacityT>::dinic(SizeType source, SizeType sink) {
+  prepare(source);
+  CapacityType total = 0;
+  if (source == sink)
+    return total;
+  while (dinic_levels(sink)) {
+    m_current.assign(m_offsets.begin(), m_offsets.end() - 1);
+    total += dinic_blocking_flow(sink);
+  }
+  return total;
+}
+
+template <typename CapacityT>
+void FlowNetwork<CapacityT>::bucket_insert(SizeType v_i) {
+  SizeType h = m_height[v_i];
+  m_prev[v_i] = npos;
+  m_next[v_i] = m_bucket_head[h];
+  if (m_bucket_head[h] != npos)
+    m_prev[m_bucket_head[h]] = v_i;
+  m_bucket_head[h] = v_i;
+  m_max_height = std::max(m_max_height, h);
+}
+
+template <typename CapacityT>
+void FlowNetwork<CapacityT>::bucket_erase(SizeType v_i) {
+  if (m_prev[v_i] != npos)
+    m_next[m_prev[v_i]] = m_next[v_i];
+  else
+    m_bucket_head[m_height[v_i]] = m_next[v_i];
+  if (m_next[v_i] != npos)
+    m_prev[m_next[v_i]] = m_prev[v_i];
+}
+
+template <typename CapacityT>
+void FlowNetwork<CapacityT>::global_relabel(SizeType sink) {
+  const SizeType n = m_size;
+  m_height.assign(n, n);
+  m_height[sink] = 0;
+  m_queue.assign(1, sink);
+  for (SizeType head = 0; head < m_queue.size(); ++head) {
+    SizeType v_i = m_queue[head];
+    for (SizeType a = m_offsets[v_i]; a < m_offsets[v_i + 1]; ++a) {
+      SizeType u_i = m_heads[a];
+      if (m_height[u_i] == n && u_i != m_source &&
+          m_residual[m_reverse[a]] > 0) {
+        m_height[u_i] = m_height[v_i] + 1;
+        m_queue.push_back(u_i);
+      }
+    }
+  }
+  m_bucket_head.assign(n, npos);
+  for (auto& active : m_active) {
+    active.clear();
+  }
+  m_max_height = m_max_active = 0;
+  for (SizeType v_i : m_queue) {
+    bucket_insert(v_i);
+    if (m_excess[v_i] > 0 && v_i != sink) {
+      m_active[m_height[v_i]].push_back(v_i);
+      m_max_active = std::max(m_max_active, m_height[v_i]);
+    }
+  }
+  m_current.assign(m_offsets.begin(), m_offsets.end() - 1);
+  m_relabels = 0;
+}
+
+template <typename CapacityT>
+void FlowNetwork<CapacityT>::discharge(SizeType u_i, SizeType sink) {
+  const SizeType n = m_size;
+  while (m_excess[u_i] > 0) {
+    SizeType& a = m_current[u_i];
+    if (a == m_offsets[u_i + 1]) {
+      // Relabel.
+      ++m_relabels;
+      SizeType old_height = m_height[u_i], new_height = n;
+      for (SizeType b = m_offsets[u_i]; b < m_offsets[u_i + 1]; ++b) {
+        if (m_residual[b] > 0)
+          new_height = std::min(new_height, m_height[m_heads[b]] + 1);
+      }
+      bucket_erase(u_i);
+      if (m_bucket_head[old_height] == npos) {
+        // Gap: nodes above `old_height` can no longer reach the sink. None
+        // of them is active, `u_i` being the highest active node.
+        for (SizeType h = old_height + 1; h <= m_max_height; ++h) {
+          for (SizeType v_i = m_bucket_head[h]; v_i != npos;
+               v_i = m_next[v_i]) {
+            m_height[v_i] = n;
+          }
+          m_bucket_head[h] = npos;
+        }
+        m_max_height = old_height == 0 ? 0 : old_height - 1;
+        m_height[u_i] = n;
+        return;
+      }
+      m_height[u_i] = new_height;
+      a = m_offsets[u_i];
+      if (new_height >= n)
+        return;
+      bucket_insert(u_i);
+      continue;
+    }
+    SizeType v_i = m_heads[a];
+    if (m_residual[a] > 0 && m_height[u_i] == m_height[v_i] + 1) {
+      bool was_inactive = m_excess[v_i] == 0;
+      push(a, std::min(m_excess[u_i], m_residual[a]));
+      if (was_inactive && v_i != sink) {
+        m_active[m_height[v_i]].push_back(v_i);
+        m_max_active = std::max(m_max_active, m_height[v_i]);
+      }
+      if (m_excess[u_i] == 0)
+        return;
+    }
+    ++a;
+  }
+}
+
+template <typename CapacityT>
+void FlowNetwork<CapacityT>::return_excess(SizeType sink) {
+  const SizeType n = m_size;
+  // Heights become residual distances to the source, offset by `n`.
+  m_height.assign(n, 2 * n);
+  m_height[m_source] = n;
+  m_queue.assign(1, m_source);
+  for (SizeType head = 0; head < m_queue.size(); ++head) {
+    SizeType v_i = m_queue[head];
+    for (SizeType a = m_offsets[v_i]; a < m_offsets[v_i + 1]; ++a) {
+      SizeType u_i = m_heads[a];
+      if (m_height[u_i] == 2 * n && u_i != sink &&
+          m_residual[m_reverse[a]] > 0) {
+        m_height[u_i] = m_height[v_i] + 1;
+        m_queue.push_back(u_i);
+      }
+    }
+  }
+  m_current.assign(m_offsets.begin(), m_offsets.end() - 1);
+  Sequence<SizeType> fifo;
+  for (SizeType v_i = 0; v_i < n; ++v_i) {
+    if (m_excess[v_i] > 0 && v_i != m_source && v_i != sink)
+      fifo.push_back(v_i);
+  }
+  for (SizeType head = 0; head < fifo.size(); ++head) {
+    SizeType u_i = fifo[head];
+    while (m_excess[u_i] > 0) {
+      SizeType& a = m_current[u_i];
+      if (a == m_offsets[u_i + 1]) {
+        SizeType new_height = std::numeric_limits<SizeType>::max();
+        for (SizeType b = m_offsets[u_i]; b < m_offsets[u_i + 1]; ++b) {
+          if (m_residual[b] > 0)
+            new_height = std::min(new_height, m_height[m_heads[b]] + 1);
+        }
+        m_height[u_i] = new_height;
+        a = m_offsets[u_i];
+        continue;
+      }
+      SizeType v_i = m_heads[a];
+      if (m_residual[a] > 0 && m_height[u_i] == m_height[v_i] + 1) {
+        bool was_inactive = m_excess[v_i] == 0;
+        push(a, std::min(m_excess[u_i], m_residual[a]));
+        if (was_inactive && v_i != m_source && v_i != sink)
+          fifo.push_back(v_i);
+        if (m_excess[u_i] == 0)
+          break;
+      }
+      ++a;
+    }
+  }
+}
+
+template <typename CapacityT>
+typename FlowNetwork<CapacityT>::CapacityType
+FlowNetwork<CapacityT>::push_relabel(SizeType source, SizeType sink) {
+  prepare(source);
+  if (source == sink)
+    return 0;
+  const SizeType n = m_size;
+  m_next.assign(n, npos);
+  m_prev.assign(n, npos);
+  m_active.resize(n);
+  for (SizeType a = m_offsets[source]; a < m_offsets[source + 1]; ++a) {
+    if (m_residual[a] > 0)
+      push(a, m_residual[a]);
+  }
+  global_relabel(sink);
+
+  while (true) {
+    while (m_max_active > 0 && m_active[m_max_active].empty()) {
+      --m_max_active;
+    }
+    if (m_active[m_max_active].empty())
+      break;
+    SizeType u_i = m_active[m_max_active].back();
+    m_active[m_max_active].pop_back();
+    discharge(u_i, sink);
+    if (m_relabels >= n)
+      global_relabel(sink);
+  }
+  return_excess(sink);
+  return m_excess[sink];
+}
+
+template <typename CapacityT>
+std::vector<bool> FlowNetwork<CapacityT>::min_cut() const {
+  Sequence<bool> reached(m_size, false);
+  if (m_source == npos)
+    return reached;
+  Sequence<SizeType> queue(1, m_source);
+  reached[m_source] = true;
+  for (SizeType head = 0; head < queue.size(); ++head) {
+    SizeType u_i = queue[head];
+    for (SizeType a = m_offsets[u_i]; a < m_offsets[u_i + 1]; ++a) {
+      if (m_residual[a] > 0 && !reached[m_heads[a]]) {
+        reached[m_heads[a]] = true;
+        queue.push_back(m_heads[a]);
+      }
+    }
+  }
+  return reached;
+}
+
+} // namespace dragon
+
+#endif
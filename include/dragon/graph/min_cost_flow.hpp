@@ -0,0 +1,534 @@
+#ifndef DRAGON_GRAPH_MIN_COST_FLOW_HPP
+#define DRAGON_GRAPH_MIN_COST_FLOW_HPP
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "dragon/ds/indexed-d-ary-heap.hpp"
+#include "dragon/graph/max_flow.hpp"
+
+namespace dragon {
+
+/**
+ * `MinCostFlowNetwork` is a directed graph with edge capacities and per unit
+ * costs on which minimum cost flows are computed.
+ *
+ * The residual graph uses the same flat layout as `FlowNetwork`, with the
+ * reverse arc of an edge costing the opposite of the edge. Unlike
+ * `FlowNetwork`, the flow is kept between calls: `augment` pushes more flow
+ * on top of the current one, so demand can be raised step by step, and
+ * edges may be added in between without losing the flow already routed. An
+ * added edge that would make the current flow cheaper closes a negative cost
+ * cycle in the residual graph, which `augment` reports.
+ *
+ * Two algorithms are available:
+ * - `augment` / `successive_shortest_paths`: sends flow along shortest
+ *   paths of the residual graph. Node potentials (as in Johnson's
+ *   algorithm) keep every reduced cost non negative, so each path is found
+ *   with a heap based Dijkstra instead of Bellman-Ford. Costs may be
+ *   negative, as long as no cycle of edges with positive capacity has a
+ *   negative total cost.
+ * - `cost_scaling`: Goldberg and Tarjan's cost scaling push-relabel, which
+ *   computes a minimum cost maximum flow in a bounded number of passes
+ *   whatever the flow value, and accepts negative cost cycles. Better on
+ *   large instances whose maximum flow needs many augmenting paths.
+ *
+ * @param CapacityT capacity type.
+ * @param CostT cost type, integral for `cost_scaling`.
+ */
+template <typename CapacityT, typename CostT = CapacityT>
+class MinCostFlowNetwork {
+public:
+  using SizeType = std::size_t;
+  using CapacityType = CapacityT;
+  using CostType = CostT;
+
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+
+public:
+  explicit MinCostFlowNetwork(SizeType sz = 0) : m_size(sz) {}
+  MinCostFlowNetwork(const MinCostFlowNetwork&) = default;
+  MinCostFlowNetwork(MinCostFlowNetwork&&) noexcept = default;
+  MinCostFlowNetwork& operator=(const MinCostFlowNetwork&) = default;
+  MinCostFlowNetwork& operator=(MinCostFlowNetwork&&) noexcept = default;
+  ~MinCostFlowNetwork() = default;
+
+  /**
+   * Adds an edge `u_i -> v_i` with capacity `capacity` and cost `cost` per
+   * unit of flow, and returns its id. The edge starts without flow.
+   */
+  SizeType add_edge(SizeType u_i, SizeType v_i, CapacityType capacity,
+                    CostType cost);
+
+  /// Returns the number of nodes.
+  SizeType size() const { return m_size; }
+
+  /// Returns the number of edges added.
+  SizeType num_of_edges() const { return m_edge_tails.size(); }
+
+  /// Removes all flow.
+  void reset();
+
+  /**
+   * Pushes up to `limit` more units of flow from `source` to `sink` on top
+   * of the current flow, each unit along a cheapest residual path. If the
+   * current flow has minimum cost for its value, so has the new one.
+   *
+   * @returns the amount pushed, less than `limit` only if the flow is now a
+   * maximum flow. 0 if the residual graph has a negative cost cycle, see
+   * `has_negative_cycle`.
+   */
+  CapacityType augment(
+      SizeType source, SizeType sink,
+      CapacityType limit = std::numeric_limits<CapacityType>::max());
+
+  /**
+   * Minimum cost flow of value at most `limit` from `source` to `sink`,
+   * starting from the zero flow.
+   *
+   * @returns the flow value, see `augment`.
+   */
+  CapacityType successive_shortest_paths(
+      SizeType source, SizeType sink,
+      CapacityType limit = std::numeric_limits<CapacityType>::max()) {
+    reset();
+    return augment(source, sink, limit);
+  }
+
+  /**
+   * Minimum cost maximum flow from `source` to `sink` with cost scaling,
+   * starting from the zero flow. Costs are scaled by `size() + 1`, which
+   * must not overflow `CostType`.
+   *
+   * @returns the flow value.
+   */
+  CapacityType cost_scaling(SizeType source, SizeType sink);
+
+  /// Returns the flow on edge `edge`.
+  CapacityType flow(SizeType edge) const {
+    SizeType a = m_edge_arc[edge];
+    return m_capacity[a] - m_residual[a];
+  }
+
+  /// Returns the total cost of the current flow.
+  CostType cost() const { return m_cost; }
+
+  /**
+   * Returns true if the last `augment` found a negative cost cycle in the
+   * residual graph, in which case it pushed nothing.
+   */
+  bool has_negative_cycle() const { return m_negative_cycle; }
+
+private:
+  /// Lays out the arcs if edges were added, keeping the current flow.
+  void layout();
+  /// Makes every reduced cost of the residual graph non negative, running
+  /// Bellman-Ford if needed. Returns false on a negative cost cycle.
+  bool update_potentials();
+  /// Dijkstra on reduced costs from `source`, stopping at `sink`. Returns
+  /// false if `sink` is unreachable, otherwise updates the potentials.
+  bool shortest_path(SizeType source, SizeType sink);
+  void push(SizeType a, CapacityType delta) {
+    m_residual[a] -= delta;
+    m_residual[m_reverse[a]] += delta;
+  }
+  /// One cost scaling pass: turns an `eps`-optimal flow into an
+  /// `eps / alpha`-optimal one, with costs scaled by `scale`.
+  void refine(CostType eps, CostType scale);
+  /// Global price update: lowers every potential by `eps` times the
+  /// residual distance to the nearest deficit, where an arc is as long as
+  /// its reduced cost in units of `eps`, plus one. Keeps the flow
+  /// `eps`-optimal and turns shortest paths to deficits into admissible
+  /// paths.
+  void price_update(CostType eps, CostType scale);
+
+private:
+  SizeType m_size = 0;
+  /// Edges as added.
+  Sequence<SizeType> m_edge_tails, m_edge_heads;
+  Sequence<CapacityType> m_edge_capacity;
+  Sequence<CostType> m_edge_cost;
+
+  /// Residual graph: arcs of node `u` are `[m_offsets[u], m_offsets[u + 1])`.
+  bool m_built = false;
+  Sequence<SizeType> m_offsets;
+  Sequence<SizeType> m_heads;
+  Sequence<SizeType> m_reverse;
+  Sequence<CapacityType> m_capacity;
+  Sequence<CapacityType> m_residual;
+  Sequence<CostType> m_arc_cost;
+  /// Forward arc of every edge.
+  Sequence<SizeType> m_edge_arc;
+
+  CostType m_cost = 0;
+  bool m_negative_cycle = false;
+  /// Whether every residual arc has a non negative reduced cost.
+  bool m_potentials_valid = false;
+  Sequence<CostType> m_potential;
+
+  /// Dijkstra state, `m_settled` lists the nodes popped from the heap.
+  Sequence<CostType> m_dist;
+  Sequence<SizeType> m_parent_arc;
+  Sequence<SizeType> m_settled;
+  IndexedDaryHeap<CostType> m_heap;
+
+  /// Cost scaling state.
+  Sequence<CapacityType> m_excess;
+  Sequence<SizeType> m_current;
+  Sequence<SizeType> m_queue;
+};
+
+template <typename CapacityT, typename CostT>
+constexpr typename MinCostFlowNetwork<CapacityT, CostT>::SizeType
+    MinCostFlowNetwork<CapacityT, CostT>::npos;
+
+template <typename CapacityT, typename CostT>
+typename MinCostFlowNetwork<CapacityT, CostT>::SizeType
+MinCostFlowNetwork<CapacityT, CostT>::add_edge(SizeType u_i, SizeType v_i,
+                                               CapacityType capacity,
+                                               CostType cost) {
+  m_edge_tails.push_back(u_i);
+  m_edge_heads.push_back(v_i);
+  m_edge_capacity.push_back(capacity);
+  m_edge_cost.push_back(cost);
+  m_built = false;
+  m_potentials_valid = false;
+  return m_edge_tails.size() - 1;
+}
+
+template <typename CapacityT, typename CostT>
+void MinCostFlowNetwork<CapacityT, CostT>::layout() {
+  if (m_built)
+    return;
+  const SizeType num_of_edges = m_edge_tails.size();
+  Sequence<CapacityType> old_flow(num_of_edges, 0);
+  for (SizeType e = 0; e < m_edge_arc.size(); ++e) {
+    old_flow[e] = flow(e);
+  }
+  m_offsets.assign(m_size + 1, 0);
+  for (SizeType e = 0; e < num_of_edges; ++e) {
+    ++m_offsets[m_edge_tails[e] + 1];
+    ++m_offsets[m_edge_heads[e] + 1];
+  }
+  for (SizeType u_i = 0; u_i < m_size; ++u_i) {
+    m_offsets[u_i + 1] += m_offsets[u_i];
+  }
+  m_heads.resize(2 * num_of_edges);
+  m_reverse.resize(2 * num_of_edges);
+  m_capacity.resize(2 * num_of_edges);
+  m_residual.resize(2 * num_of_edges);
+  m_arc_cost.resize(2 * num_of_edges);
+  m_edge_arc.resize(num_of_edges);
+  Sequence<SizeType> position(m_offsets.begin(), m_offsets.end() - 1);
+  for (SizeType e = 0; e < num_of_edges; ++e) {
+    SizeType a = position[m_edge_tails[e]]++;
+    SizeType b = position[m_edge_heads[e]]++;
+    m_heads[a] = m_edge_heads[e];
+    m_heads[b] = m_edge_tails[e];
+    m_reverse[a] = b;
+    m_reverse[b] = a;
+    m_capacity[a] = m_edge_capacity[e];
+    m_capacity[b] = 0;
+    m_residual[a] = m_edge_capacity[e] - old_flow[e];
+    m_residual[b] = old_flow[e];
+    m_arc_cost[a] = m_edge_cost[e];
+    m_arc_cost[b] = -m_edge_cost[e];
+    m_edge_arc[e] = a;
+  }
+  m_built = true;
+}
+
+template <typename CapacityT, typename CostT>
+void MinCostFlowNetwork<CapacityT, CostT>::reset() {
+  layout();
+  m_residual = m_capacity;
+  m_cost = 0;
+  m_potentials_valid = false;
+}
+
+template <typename CapacityT, typename CostT>
+bool MinCostFlowNetwork<CapacityT, CostT>::update_potentials() {
+  if (m_potentials_valid)
+    return true;
+  const SizeType n = m_size;
+  m_potential.resize(n, 0);
+  bool valid = true;
+  for (SizeType u_i = 0; u_i < n && valid; ++u_i) {
+    for (SizeType a = m_offsets[u_i]; a < m_offsets[u_i + 1]; ++a) {
+      if (m_residual[a] > 0 && m_arc_cost[a] + m_potential[u_i] -
+                                       m_potential[m_heads[a]] <
+                                   0) {
+        valid = false;
+        break;
+      }
+    }
+  }
+  if (!valid) {
+    // Bellman-Ford from a virtual node linked to every node at cost 0, with
+    // a queue of the nodes whose distance changed. A shortest path of `n`
+    // arcs or more must contain a negative cycle.
+    m_potential.assign(n, 0);
+    Sequence<SizeType> queue(n), num_of_arcs(n, 0);
+    Sequence<bool> in_queue(n, true);
+    for (SizeType v_i = 0; v_i < n; ++v_i) {
+      queue[v_i] = v_i;
+    }
+    for (SizeType head = 0; head < queue.size(); ++head) {
+      SizeType u_i = queue[head];
+      in_queue[u_i] = false;
+      for (SizeType a = m_offsets[u_i]; a < m_offsets[u_i + 1]; ++a) {
+        SizeType v_i = m_heads[a];
+        CostType temp = m_potential[u_i] + m_arc_cost[a];
+        if (m_residual[a] > 0 && temp < m_potential[v_i]) {
+          m_potential[v_i] = temp;
+          num_of_arcs[v_i] = num_of_arcs[u_i] + 1;
+          if (num_of_arcs[v_i] >= n) {
+            m_negative_cycle = true;
+            return false;
+          }
+          if (!in_queue[v_i]) {
+            in_queue[v_i] = true;
+            queue.push_back(v_i);
+          }
+        }
+      }
+    }
+  }
+  m_negative_cycle = false;
+  m_potentials_valid = true;
+  return true;
+}
+
+template <typename CapacityT, typename CostT>
+bool MinCostFlowNetwork<CapacityT, CostT>::shortest_path(SizeType source,
+                                                         SizeType sink) {
+  const CostType inf = std::numeric_limits<CostType>::max();
+  m_dist.assign(m_size, inf);
+  m_parent_arc.assign(m_size, npos);
+  m_settled.clear();
+  if (m_heap.capacity() != m_size)
+    m_heap.reset(m_size);
+  else
+    m_heap.clear();
+  m_dist[source] = 0;
+  m_heap.push(source, 0);
+  while (!m_heap.empty()) {
+    SizeType u_i = m_heap.top();
+    m_heap.pop();
+    m_settled.push_back(u_i);
+    if (u_i == sink)
+      break;
+    for (SizeType a = m_offsets[u_i]; a < m_offsets[u_i + 1]; ++a) {
+      if (m_residual[a] == 0)
+        continue;
+      SizeType v_i = m_heads[a];
+      CostType temp_dist = m_dist[u_i] + m_arc_cost[a] + m_potential[u_i] -
+                           m_potential[v_i];
+      if (temp_dist < m_dist[v_i]) {
+        m_dist[v_i] = temp_dist;
+        m_parent_arc[v_i] = a;
+        m_heap.push_or_decrease(v_i, temp_dist);
+      }
+    }
+  }
+  if (m_dist[sink] == inf)
+    return false;
+  // Raising every potential by min(dist, dist[sink]) keeps reduced costs
+  // non negative and makes those of the path to `sink` zero. Lowering all
+  // potentials by dist[sink] afterwards changes no reduced cost, and leaves
+  // only the settled nodes to update.
+  for (SizeType v_i : m_settled) {
+    m_potential[v_i] += m_dist[v_i] - m_dist[sink];
+  }
+  return true;
+}
+
+template <typename CapacityT, typename CostT>
+typename MinCostFlowNetwork<CapacityT, CostT>::CapacityType
+MinCostFlowNetwork<CapacityT, CostT>::augment(SizeType source, SizeType sink,
+                                              CapacityType limit) {
+  layout();
+  CapacityType total = 0;
+  if (source == sink || !update_potentials())
+    return total;
+  while (total < limit && shortest_path(source, sink)) {
+    CapacityType delta = limit - total;
+    for (SizeType v_i = sink; v_i != source;
+         v_i = m_heads[m_reverse[m_parent_arc[v_i]]]) {
+      delta = std::min(delta, m_residual[m_parent_arc[v_i]]);
+    }
+    for (SizeType v_i = sink; v_i != source;
+         v_i = m_heads[m_reverse[m_parent_arc[v_i]]]) {
+      SizeType a = m_parent_arc[v_i];
+      push(a, delta);
+      m_cost += delta * m_arc_cost[a];
+    }
+    total += delta;
+  }
+  return total;
+}
+
+template <typename CapacityT, typename CostT>
+void MinCostFlowNetwork<CapacityT, CostT>::refine(CostType eps,
+                                                  CostType scale) {
+  const SizeType n = m_size;
+  auto reduced_cost = [&](SizeType u_i, SizeType a) {
+    return scale * m_arc_cost[a] + m_potential[u_i] - m_potential[m_heads[a]];
+  };
+  // Saturating every arc of negative reduced cost makes the flow 0-optimal,
+  // at the price of excesses and deficits.
+  m_excess.assign(n, 0);
+  for (SizeType u_i = 0; u_i < n; ++u_i) {
+    for (SizeType a = m_offsets[u_i]; a < m_offsets[u_i + 1]; ++a) {
+      if (m_residual[a] > 0 && reduced_cost(u_i, a) < 0) {
+        m_excess[u_i] -= m_residual[a];
+        m_excess[m_heads[a]] += m_residual[a];
+        push(a, m_residual[a]);
+      }
+    }
+  }
+  price_update(eps, scale);
+  m_queue.clear();
+  for (SizeType v_i = 0; v_i < n; ++v_i) {
+    if (m_excess[v_i] > 0)
+      m_queue.push_back(v_i);
+  }
+  SizeType relabels = 0;
+  // FIFO push-relabel along admissible arcs, i.e. of negative reduced cost.
+  // A relabel lowers the potential of a node just enough to make one of its
+  // arcs admissible, keeping every reduced cost at least -eps.
+  for (SizeType head = 0; head < m_queue.size(); ++head) {
+    SizeType u_i = m_queue[head];
+    while (m_excess[u_i] > 0) {
+      SizeType& a = m_current[u_i];
+      if (a == m_offsets[u_i + 1]) {
+        CostType best = std::numeric_limits<CostType>::lowest();
+        for (SizeType b = m_offsets[u_i]; b < m_offsets[u_i + 1]; ++b) {
+          if (m_residual[b] > 0)
+            best = std::max(best, m_potential[m_heads[b]] -
+                                      scale * m_arc_cost[b]);
+        }
+        m_potential[u_i] = best - eps;
+        a = m_offsets[u_i];
+        if (++relabels == n) {
+          price_update(eps, scale);
+          relabels = 0;
+        }
+        continue;
+      }
+      if (m_residual[a] > 0 && reduced_cost(u_i, a) < 0) {
+        SizeType v_i = m_heads[a];
+        CapacityType delta = std::min(m_excess[u_i], m_residual[a]);
+        bool was_inactive = m_excess[v_i] <= 0;
+        push(a, delta);
+        m_excess[u_i] -= delta;
+        m_excess[v_i] += delta;
+        if (was_inactive && m_excess[v_i] > 0)
+          m_queue.push_back(v_i);
+        if (m_excess[u_i] == 0)
+          break;
+      }
+      ++a;
+    }
+  }
+}
+
+template <typename CapacityT, typename CostT>
+void MinCostFlowNetwork<CapacityT, CostT>::price_update(CostType eps,
+                                                        CostType scale) {
+  const SizeType n = m_size;
+  const CostType inf = std::numeric_limits<CostType>::max();
+  m_dist.assign(n, inf);
+  if (m_heap.capacity() != n)
+    m_heap.reset(n);
+  else
+    m_heap.clear();
+  SizeType num_of_active = 0;
+  for (SizeType v_i = 0; v_i < n; ++v_i) {
+    if (m_excess[v_i] < 0) {
+      m_dist[v_i] = 0;
+      m_heap.push(v_i, 0);
+    } else if (m_excess[v_i] > 0) {
+      ++num_of_active;
+    }
+  }
+  // Dijkstra backwards from the deficits, until every node with excess is
+  // reached. Nodes farther away are lowered as much as the last one.
+  CostType last = 0;
+  while (!m_heap.empty() && num_of_active > 0) {
+    SizeType w_i = m_heap.top();
+    last = m_heap.top_key();
+    m_heap.pop();
+    if (m_excess[w_i] > 0)
+      --num_of_active;
+    for (SizeType b = m_offsets[w_i]; b < m_offsets[w_i + 1]; ++b) {
+      SizeType a = m_reverse[b], u_i = m_heads[b];
+      if (m_residual[a] == 0)
+        continue;
+      CostType reduced_cost =
+          scale * m_arc_cost[a] + m_potential[u_i] - m_potential[w_i];
+      // Floor of `reduced_cost / eps`, which is at least -1.
+      CostType length = reduced_cost >= 0 ? reduced_cost / eps + 1 : 0;
+      if (last + length < m_dist[u_i]) {
+        m_dist[u_i] = last + length;
+        m_heap.push_or_decrease(u_i, m_dist[u_i]);
+      }
+    }
+  }
+  for (SizeType v_i = 0; v_i < n; ++v_i) {
+    m_potential[v_i] -= eps * std::min(m_dist[v_i], last);
+  }
+  m_current.assign(m_offsets.begin(), m_offsets.end() - 1);
+}
+
+template <typename CapacityT, typename CostT>
+typename MinCostFlowNetwork<CapacityT, CostT>::CapacityType
+MinCostFlowNetwork<CapacityT, CostT>::cost_scaling(SizeType source,
+                                                   SizeType sink) {
+  static_assert(std::is_integral<CostType>::value,
+                "dragon::MinCostFlowNetwork::cost_scaling: CostT must be an "
+                "integral type");
+  const SizeType alpha = 8;
+  reset();
+  CapacityType value = 0;
+  if (source != sink) {
+    // Any maximum flow is a valid starting point.
+    FlowNetwork<CapacityType> network(m_size);
+    for (SizeType e = 0; e < m_edge_tails.size(); ++e) {
+      network.add_edge(m_edge_tails[e], m_edge_heads[e], m_edge_capacity[e]);
+    }
+    value = network.push_relabel(source, sink);
+    for (SizeType e = 0; e < m_edge_tails.size(); ++e) {
+      push(m_edge_arc[e], network.flow(e));
+    }
+  }
+
+  // With costs scaled by n + 1, a 1-optimal flow is 1 / (n + 1)-optimal for
+  // the original costs, hence optimal.
+  const CostType scale = static_cast<CostType>(m_size + 1);
+  CostType eps = 0;
+  for (auto cost : m_edge_cost) {
+    eps = std::max(eps, static_cast<CostType>(cost < 0 ? -cost : cost));
+  }
+  eps *= scale;
+  m_potential.assign(m_size, 0);
+  while (eps > 1) {
+    eps = std::max(static_cast<CostType>(eps / alpha), CostType(1));
+    refine(eps, scale);
+  }
+
+  m_cost = 0;
+  for (SizeType e = 0; e < m_edge_tails.size(); ++e) {
+    m_cost += flow(e) * m_edge_cost[e];
+  }
+  // The potentials are only eps-feasible, `augment` recomputes them.
+  m_potentials_valid = false;
+  return value;
+}
+
+} // namespace dragon
+
+#endif
@@ -1,76 +1,158 @@
 #ifndef DRAGON_GRAPH_MIN_SPANNING_TREE_HPP
 #define DRAGON_GRAPH_MIN_SPANNING_TREE_HPP
 
+#include "dragon/core/thread-pool.hpp"
 #include "dragon/ds/disjoint_set_union.hpp"
+#include "dragon/ds/indexed-d-ary-heap.hpp"
+#include "dragon/graph/connected_components.hpp"
 #include "dragon/graph/graph.hpp"
+#include "dragon/sorting/radix-sort.hpp"
 #include "dragon/tree/tree.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <random>
 #include <set>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace dragon {
 
-template <typename GraphT>
-auto prim(const GraphT& graph, typename GraphT::SizeType root = GraphT::npos) {
-  using ValueType = typename GraphT::ValueType;
-  using EdgeValueType = typename GraphT::EdgeValueType;
+/**
+ * Minimum spanning tree with Prim's algorithm in O(E log V): the tree grows
+ * from `root`, and an indexed d-ary heap holds the lightest known edge into
+ * every node next to the tree. Nodes already in the tree are marked in a
+ * bitmap, so their edges are skipped without touching the heap, and no
+ * operation of the main loop allocates.
+ *
+ * @param heap priority queue, resized to the graph if needed and left
+ * empty, so that repeated calls reuse its storage.
+ * @param root root of the returned tree, root of the graph by default.
+ * @returns the minimum spanning tree, an empty tree if the graph is not
+ * connected.
+ */
+template <typename GraphT, std::size_t Arity>
+Tree<typename GraphT::ValueType, typename GraphT::EdgeValueType>
+prim(const GraphT& graph,
+     IndexedDaryHeap<typename GraphT::EdgeValueType, Arity>& heap,
+     typename GraphT::SizeType root = GraphT::npos) {
   using SizeType = typename GraphT::SizeType;
-
-  const EdgeValueType inf_weight = std::numeric_limits<EdgeValueType>::max();
-
-  if (root == GraphT::npos) {
+  using TreeType =
+      Tree<typename GraphT::ValueType, typename GraphT::EdgeValueType>;
+  const SizeType sz = graph.size();
+  if (root == GraphT::npos)
     root = graph.root();
-  }
+  if (sz == 0)
+    return TreeType(0);
+  if (heap.capacity() != sz)
+    heap.reset(sz);
+  else
+    heap.clear();
 
-  // use set as the priority queue for finding safe edge at each iteration.
-  std::set<std::pair<EdgeValueType, SizeType>> setpq;
-  for (auto u_i = 0U; u_i < graph.size(); ++u_i) {
-    setpq.insert({inf_weight, u_i});
+  TreeType tree(sz, root);
+  tree[root].parent = root;
+  std::vector<SizeType> parent(sz);
+  std::vector<bool> in_tree(sz, false);
+  SizeType num_of_nodes = 0;
+  heap.push(root, typename GraphT::EdgeValueType());
+  while (!heap.empty()) {
+    const SizeType u_i = heap.top();
+    const auto weight = heap.top_key();
+    heap.pop();
+    in_tree[u_i] = true;
+    ++num_of_nodes;
+    if (u_i != root) {
+      tree[u_i].parent = parent[u_i];
+      tree.add_undirected_edge(u_i, parent[u_i], weight);
+    }
+    for (auto edge : graph[u_i].edges) {
+      const SizeType v_i = edge.first;
+      if (in_tree[v_i])
+        continue;
+      if (heap.push_or_decrease(v_i, edge.second))
+        parent[v_i] = u_i;
+    }
   }
+  if (num_of_nodes != sz)
+    return TreeType(0);
+  return tree;
+}
 
-  // Make root weight = 0 in the priority queue.
-  setpq.erase({inf_weight, root});
-  setpq.insert({0, root});
+/// Same as above, with a heap of its own.
+template <typename GraphT>
+Tree<typename GraphT::ValueType, typename GraphT::EdgeValueType>
+prim(const GraphT& graph, typename GraphT::SizeType root = GraphT::npos) {
+  IndexedDaryHeap<typename GraphT::EdgeValueType> heap(graph.size());
+  return prim(graph, heap, root);
+}
 
-  std::vector<EdgeValueType> min_weight(graph.size(), inf_weight);
-  min_weight[root] = 0;
+/**
+ * Minimum spanning tree with Prim's algorithm in O(V^2 + E), for dense
+ * graphs: instead of a heap, the lightest edge into every node out of the
+ * tree is kept in a plain array, which is scanned linearly for the next
+ * node. With E close to V^2 this beats every heap, whose updates cost more
+ * than the scans.
+ *
+ * @param root root of the returned tree, root of the graph by default.
+ * @returns the minimum spanning tree, an empty tree if the graph is not
+ * connected.
+ */
+template <typename GraphT>
+Tree<typename GraphT::ValueType, typename GraphT::EdgeValueType>
+dense_prim(const GraphT& graph,
+           typename GraphT::SizeType root = GraphT::npos) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  using TreeType = Tree<typename GraphT::ValueType, EdgeValueType>;
+  const SizeType sz = graph.size();
+  if (root == GraphT::npos)
+    root = graph.root();
+  if (sz == 0)
+    return TreeType(0);
 
-  // tree to represent the minimum spanning tree
-  Tree<ValueType, EdgeValueType> tree(graph.size(), root);
+  TreeType tree(sz, root);
   tree[root].parent = root;
-
-  while (!setpq.empty()) {
-    // index of the next node to insert.
-    SizeType u_i = setpq.begin()->second;
-    setpq.erase(setpq.begin());
-
-    // Given graph is not fully connected.
-    // Return empty tree to denote that the minimum spanning tree cannot be
-    // formed.
-    if (min_weight[u_i] == inf_weight) {
-      return Tree<ValueType, EdgeValueType>(0);
+  // Nodes out of the tree, `min_weight` is only meaningful for the nodes
+  // with a parent.
+  std::vector<SizeType> remaining(sz), parent(sz, GraphT::npos);
+  for (SizeType v_i = 0; v_i < sz; ++v_i) {
+    remaining[v_i] = v_i;
+  }
+  std::vector<EdgeValueType> min_weight(sz);
+  std::vector<bool> in_tree(sz, false);
+  parent[root] = root;
+  min_weight[root] = EdgeValueType();
+  while (!remaining.empty()) {
+    SizeType best = GraphT::npos;
+    for (SizeType i = 0; i < remaining.size(); ++i) {
+      const SizeType v_i = remaining[i];
+      if (parent[v_i] != GraphT::npos &&
+          (best == GraphT::npos ||
+           min_weight[v_i] < min_weight[remaining[best]]))
+        best = i;
     }
-
-    const auto& u = graph[u_i];
-    for (auto edge : u.edges) {
-      auto v_i = edge.first;
-      if (!setpq.count({min_weight[v_i], v_i}))
+    if (best == GraphT::npos)
+      return TreeType(0);
+    const SizeType u_i = remaining[best];
+    remaining[best] = remaining.back();
+    remaining.pop_back();
+    in_tree[u_i] = true;
+    if (u_i != root) {
+      tree[u_i].parent = parent[u_i];
+      tree.add_undirected_edge(u_i, parent[u_i], min_weight[u_i]);
+    }
+    for (auto edge : graph[u_i].edges) {
+      const SizeType v_i = edge.first;
+      if (in_tree[v_i])
         continue;
-      if (edge.second < min_weight[v_i]) {
-        setpq.erase({min_weight[v_i], v_i});
+      if (parent[v_i] == GraphT::npos || edge.second < min_weight[v_i]) {
+        parent[v_i] = u_i;
         min_weight[v_i] = edge.second;
-        setpq.insert({min_weight[v_i], v_i});
-        tree[v_i].parent = u_i;
       }
     }
   }
-
-  for (auto u_i = 0U; u_i < graph.size(); ++u_i) {
-    tree.add_undirected_edge(u_i, tree[u_i].parent, min_weight[u_i]);
-  }
-  tree[root].edges.erase(root);
   return tree;
 }
 
@@ -120,6 +202,367 @@ auto kruskal(const GraphT& graph,
   return tree;
 }
 
+namespace details {
+template <typename SizeT, typename EdgeValueT> struct MSTEdge {
+  SizeT u_i, v_i;
+  EdgeValueT weight;
+};
+
+/**
+ * Collects the edges of `graph` into a flat vector, once per pair of nodes
+ * with `u_i < v_i`. An undirected edge stored in both directions is kept
+ * once, with the smaller of its two weights, and self loops are dropped.
+ *
+ * Instead of looking every reverse edge up, the edges are bucketed by their
+ * smaller end with a counting sort, and duplicates are merged bucket by
+ * bucket in O(V + E).
+ */
+template <typename GraphT>
+std::vector<MSTEdge<typename GraphT::SizeType, typename GraphT::EdgeValueType>>
+mst_edges(const GraphT& graph) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeType = MSTEdge<SizeType, typename GraphT::EdgeValueType>;
+  const SizeType sz = graph.size();
+  std::vector<EdgeType> all;
+  std::vector<SizeType> offsets(sz + 1, 0);
+  for (const auto& u : graph) {
+    const SizeType u_i = u.index();
+    for (auto edge : u.edges) {
+      const SizeType v_i = edge.first;
+      if (u_i == v_i)
+        continue;
+      EdgeType normalized{std::min(u_i, v_i), std::max(u_i, v_i),
+                          edge.second};
+      all.push_back(normalized);
+      ++offsets[normalized.u_i + 1];
+    }
+  }
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    offsets[u_i + 1] += offsets[u_i];
+  }
+  std::vector<EdgeType> bucketed(all.size());
+  {
+    std::vector<SizeType> position(offsets.begin(), offsets.end() - 1);
+    for (const auto& edge : all) {
+      bucketed[position[edge.u_i]++] = edge;
+    }
+  }
+
+  // `slot[v]` is the index in `edges` of the last edge kept towards `v`.
+  // Indices only grow, so a slot below the start of the current bucket is
+  // stale.
+  std::vector<SizeType> slot(sz, GraphT::npos);
+  std::vector<EdgeType> edges;
+  edges.reserve(all.size());
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    const SizeType first = edges.size();
+    for (SizeType i = offsets[u_i]; i < offsets[u_i + 1]; ++i) {
+      const EdgeType& edge = bucketed[i];
+      SizeType& kept = slot[edge.v_i];
+      if (kept != GraphT::npos && kept >= first) {
+        if (edge.weight < edges[kept].weight)
+          edges[kept].weight = edge.weight;
+      } else {
+        kept = edges.size();
+        edges.push_back(edge);
+      }
+    }
+  }
+  return edges;
+}
+
+/// Sorts arithmetic weights with a radix sort.
+template <typename EdgeIteratorT>
+void mst_sort(EdgeIteratorT first, EdgeIteratorT last,
+              std::true_type /* arithmetic */) {
+  using EdgeType = typename std::iterator_traits<EdgeIteratorT>::value_type;
+  radix_sort(first, last, [](const EdgeType& edge) { return edge.weight; });
+}
+
+template <typename EdgeIteratorT>
+void mst_sort(EdgeIteratorT first, EdgeIteratorT last,
+              std::false_type /* arithmetic */) {
+  using EdgeType = typename std::iterator_traits<EdgeIteratorT>::value_type;
+  std::sort(first, last, [](const EdgeType& lhs, const EdgeType& rhs) {
+    return lhs.weight < rhs.weight;
+  });
+}
+
+template <typename EdgeIteratorT>
+void mst_sort(EdgeIteratorT first, EdgeIteratorT last) {
+  using EdgeType = typename std::iterator_traits<EdgeIteratorT>::value_type;
+  mst_sort(first, last,
+           std::is_arithmetic<decltype(std::declval<EdgeType>().weight)>());
+}
+
+/**
+ * Sorts the edges of `[first, last)` and adds those that join two trees of
+ * `dsu` to `tree_edges`, stopping once the spanning forest is complete.
+ */
+template <typename EdgeIteratorT, typename EdgeT, typename SizeT>
+void mst_kruskal_range(EdgeIteratorT first, EdgeIteratorT last,
+                       IndexedDisjointSetUnion<SizeT>& dsu,
+                       std::vector<EdgeT>& tree_edges) {
+  mst_sort(first, last);
+  for (; first != last && dsu.num_of_sets() > 1; ++first) {
+    if (dsu.join(first->u_i, first->v_i))
+      tree_edges.push_back(*first);
+  }
+}
+
+/// Builds the tree returned by the Kruskal variants, empty if `tree_edges`
+/// do not span the graph.
+template <typename GraphT, typename EdgeT>
+Tree<typename GraphT::ValueType, typename GraphT::EdgeValueType>
+mst_tree(const GraphT& graph, typename GraphT::SizeType root,
+         const std::vector<EdgeT>& tree_edges) {
+  using TreeType =
+      Tree<typename GraphT::ValueType, typename GraphT::EdgeValueType>;
+  if (root == GraphT::npos)
+    root = graph.root();
+  if (graph.size() == 0 || tree_edges.size() != graph.size() - 1)
+    return TreeType(0);
+  TreeType tree(graph.size(), root);
+  for (const auto& edge : tree_edges) {
+    tree.add_undirected_edge(edge.u_i, edge.v_i, edge.weight);
+  }
+  return tree;
+}
+} // namespace details
+
+/**
+ * Minimum spanning tree with Kruskal's algorithm on flat arrays. Same result
+ * as `kruskal`, much faster: the edges are collected once per node pair
+ * into a vector, sorted by weight (radix sort for arithmetic weights), and
+ * merged with an `IndexedDisjointSetUnion`.
+ *
+ * @param graph undirected graph, edges may be stored in one or both
+ * directions.
+ * @param root root of the returned tree, root of the graph by default.
+ * @returns the minimum spanning tree, an empty tree if the graph is not
+ * connected.
+ */
+template <typename GraphT>
+Tree<typename GraphT::ValueType, typename GraphT::EdgeValueType>
+flat_kruskal(const GraphT& graph,
+             typename GraphT::SizeType root = GraphT::npos) {
+  using SizeType = typename GraphT::SizeType;
+  auto edges = details::mst_edges(graph);
+  IndexedDisjointSetUnion<SizeType> dsu(graph.size());
+  std::vector<typename decltype(edges)::value_type> tree_edges;
+  details::mst_kruskal_range(edges.begin(), edges.end(), dsu, tree_edges);
+  return details::mst_tree(graph, root, tree_edges);
+}
+
+/**
+ * Minimum spanning tree with filter-Kruskal (Osipov, Sanders and Singler):
+ * like `flat_kruskal`, but instead of sorting every edge, edges are
+ * quicksort-partitioned around random pivot weights. The light part is
+ * handled first, then edges of the heavy part whose ends are already
+ * connected are filtered out before it is processed. On dense graphs most
+ * heavy edges are filtered without ever being sorted.
+ *
+ * @param graph undirected graph, edges may be stored in one or both
+ * directions.
+ * @param root root of the returned tree, root of the graph by default.
+ * @returns the minimum spanning tree, an empty tree if the graph is not
+ * connected.
+ */
+template <typename GraphT>
+Tree<typename GraphT::ValueType, typename GraphT::EdgeValueType>
+filter_kruskal(const GraphT& graph,
+               typename GraphT::SizeType root = GraphT::npos) {
+  using SizeType = typename GraphT::SizeType;
+  auto edges = details::mst_edges(graph);
+  using EdgeType = typename decltype(edges)::value_type;
+  using EdgeIteratorType = typename decltype(edges)::iterator;
+  struct Range {
+    EdgeIteratorType first, last;
+    bool filter;
+  };
+  // Ranges up to this size are sorted directly.
+  const SizeType threshold = std::max<SizeType>(graph.size(), 1024);
+
+  IndexedDisjointSetUnion<SizeType> dsu(graph.size());
+  std::vector<EdgeType> tree_edges;
+  std::mt19937_64 rng(edges.size());
+  std::vector<Range> ranges = {{edges.begin(), edges.end(), false}};
+  while (!ranges.empty() && dsu.num_of_sets() > 1) {
+    Range range = ranges.back();
+    ranges.pop_back();
+    if (range.filter) {
+      range.last = std::remove_if(
+          range.first, range.last,
+          [&](const EdgeType& edge) {
+            return dsu.in_same_set(edge.u_i, edge.v_i);
+          });
+    }
+    const auto sz = static_cast<SizeType>(range.last - range.first);
+    if (sz <= threshold) {
+      details::mst_kruskal_range(range.first, range.last, dsu, tree_edges);
+      continue;
+    }
+    // Median of three random weights as pivot.
+    std::uniform_int_distribution<SizeType> position(0, sz - 1);
+    auto a = range.first[position(rng)].weight;
+    auto b = range.first[position(rng)].weight;
+    auto c = range.first[position(rng)].weight;
+    auto pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+    auto middle = std::partition(
+        range.first, range.last,
+        [&](const EdgeType& edge) { return !(pivot < edge.weight); });
+    if (middle == range.last) {
+      // Mostly equal weights, no progress.
+      details::mst_kruskal_range(range.first, range.last, dsu, tree_edges);
+      continue;
+    }
+    ranges.push_back({middle, range.last, true});
+    ranges.push_back({range.first, middle, false});
+  }
+  return details::mst_tree(graph, root, tree_edges);
+}
+
+/**
+ * Parallel minimum spanning tree with Boruvka's algorithm. Same result as
+ * `kruskal` when the edge weights are distinct, otherwise one of the
+ * minimum spanning trees.
+ *
+ * The edges are copied once into flat per-node arrays. Each round then
+ * finds, in parallel, the lightest edge leaving every component: every node
+ * scans its edges, drops the ones inside its own component, and offers its
+ * lightest remaining edge to its component with a compare-and-swap. Ties
+ * are broken by node indices, so the chosen edges never close a cycle. The
+ * components are then contracted along the chosen edges with the lock free
+ * union-find of `connected_components`. There are at most log2(V) rounds.
+ *
+ * @param graph undirected graph, i.e. every edge `u -> v` comes with
+ * `v -> u` of the same weight, as `Graph::add_undirected_edge` stores them.
+ * @param pool threads to run on.
+ * @param root root of the returned tree, root of the graph by default.
+ * @returns the minimum spanning tree, an empty tree if the graph is not
+ * connected.
+ */
+template <typename GraphT>
+Tree<typename GraphT::ValueType, typename GraphT::EdgeValueType>
+boruvka(const GraphT& graph, ThreadPool& pool,
+        typename GraphT::SizeType root = GraphT::npos) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  using EdgeType = details::MSTEdge<SizeType, EdgeValueType>;
+  const SizeType sz = graph.size();
+  const SizeType npos = GraphT::npos;
+
+  // Flat copy of the adjacency. The live edges of `u` are
+  // `[offsets[u], last[u])`, edges inside a component are swapped out.
+  std::vector<SizeType> offsets(sz + 1, 0);
+  for (SizeType u_i = 0; u_i < sz; ++u_i) {
+    offsets[u_i + 1] = offsets[u_i] + graph[u_i].edges.size();
+  }
+  std::vector<SizeType> targets(offsets[sz]);
+  std::vector<EdgeValueType> weights(offsets[sz]);
+  std::vector<SizeType> last(offsets.begin() + 1, offsets.end());
+  pool.parallel_for(0, sz, [&](SizeType u_i, SizeType) {
+    SizeType a = offsets[u_i];
+    for (auto edge : graph[u_i].edges) {
+      targets[a] = edge.first;
+      weights[a] = edge.second;
+      ++a;
+    }
+  });
+
+  std::vector<std::atomic<SizeType>> comp(sz), best(sz);
+  pool.parallel_for(0, sz, [&](SizeType v_i, SizeType) {
+    comp[v_i].store(v_i, std::memory_order_relaxed);
+  });
+  // Lightest edge `u -> lightest[u]` of every node out of its component,
+  // `best[c]` is the node holding the lightest edge out of component `c`.
+  std::vector<SizeType> lightest(sz);
+  std::vector<EdgeValueType> lightest_weight(sz);
+  auto lighter = [&](SizeType u_i, SizeType v_i, const EdgeValueType& w,
+                     SizeType x_i) {
+    const SizeType y_i = lightest[x_i];
+    const EdgeValueType& w2 = lightest_weight[x_i];
+    if (w < w2 || w2 < w)
+      return w < w2;
+    const SizeType low = std::min(u_i, v_i), low2 = std::min(x_i, y_i);
+    if (low != low2)
+      return low < low2;
+    return std::max(u_i, v_i) < std::max(x_i, y_i);
+  };
+
+  std::vector<std::vector<EdgeType>> chosen(pool.size());
+  std::vector<EdgeType> tree_edges;
+  while (true) {
+    pool.parallel_for(0, sz, [&](SizeType c, SizeType) {
+      best[c].store(npos, std::memory_order_relaxed);
+    });
+    pool.parallel_for(0, sz, [&](SizeType u_i, SizeType) {
+      const SizeType c = comp[u_i].load(std::memory_order_relaxed);
+      lightest[u_i] = npos;
+      for (SizeType a = offsets[u_i]; a < last[u_i];) {
+        const SizeType v_i = targets[a];
+        if (comp[v_i].load(std::memory_order_relaxed) == c) {
+          --last[u_i];
+          targets[a] = targets[last[u_i]];
+          weights[a] = weights[last[u_i]];
+          continue;
+        }
+        if (lightest[u_i] == npos ||
+            lighter(u_i, v_i, weights[a], u_i)) {
+          lightest[u_i] = v_i;
+          lightest_weight[u_i] = weights[a];
+        }
+        ++a;
+      }
+      if (lightest[u_i] == npos)
+        return;
+      SizeType current = best[c].load(std::memory_order_acquire);
+      while ((current == npos ||
+              lighter(u_i, lightest[u_i], lightest_weight[u_i], current)) &&
+             !best[c].compare_exchange_weak(current, u_i,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+      }
+    });
+
+    // When two components chose the same edge, the smaller one keeps it.
+    pool.parallel_for(0, sz, [&](SizeType c, SizeType thread_index) {
+      const SizeType u_i = best[c].load(std::memory_order_relaxed);
+      if (u_i == npos)
+        return;
+      const SizeType v_i = lightest[u_i];
+      const SizeType other = comp[v_i].load(std::memory_order_relaxed);
+      const SizeType x_i = best[other].load(std::memory_order_relaxed);
+      if (other < c && x_i == v_i && lightest[x_i] == u_i)
+        return;
+      chosen[thread_index].push_back({u_i, v_i, lightest_weight[u_i]});
+    });
+    const SizeType first = tree_edges.size();
+    for (auto& edges : chosen) {
+      tree_edges.insert(tree_edges.end(), edges.begin(), edges.end());
+      edges.clear();
+    }
+    if (tree_edges.size() == first)
+      break;
+    pool.parallel_for(first, tree_edges.size(), [&](SizeType e, SizeType) {
+      details::afforest_link(comp, tree_edges[e].u_i, tree_edges[e].v_i);
+    });
+    details::afforest_compress(comp, pool);
+  }
+  return details::mst_tree(graph, root, tree_edges);
+}
+
+/**
+ * Same as above, running on a temporary pool with one thread per hardware
+ * thread.
+ */
+template <typename GraphT>
+Tree<typename GraphT::ValueType, typename GraphT::EdgeValueType>
+boruvka(const GraphT& graph, typename GraphT::SizeType root = GraphT::npos) {
+  ThreadPool pool;
+  return boruvka(graph, pool, root);
+}
+
 } // namespace dragon
 
 #endif
\ No newline at end of file
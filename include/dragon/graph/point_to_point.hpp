@@ -0,0 +1,317 @@
+#ifndef DRAGON_GRAPH_POINT_TO_POINT_HPP
+#define DRAGON_GRAPH_POINT_TO_POINT_HPP
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "dragon/ds/indexed-d-ary-heap.hpp"
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+
+/**
+ * `PointToPointQuery` answers many source to target shortest path queries on
+ * the same graph with non-negative edge weights.
+ *
+ * All scratch state (distances, parents, heaps) is allocated once in the
+ * constructor. Distances are timestamped with the query they were written
+ * by, so a query never clears them and costs O(visited nodes) instead of
+ * O(graph.size()).
+ *
+ * The graph must outlive the query object and must not change while it is in
+ * use.
+ *
+ * @param GraphT `Graph` or any type with the same read interface.
+ */
+template <typename GraphT> class PointToPointQuery {
+public:
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+
+  static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+  static constexpr EdgeValueType inf_weight =
+      std::numeric_limits<EdgeValueType>::max();
+
+private:
+  template <typename T> using Sequence = std::vector<T>;
+
+  /// Scratch state of one search direction.
+  struct Search {
+    explicit Search(SizeType sz)
+        : dist(sz), parent(sz), stamp(sz, 0), heap(sz) {}
+    Sequence<EdgeValueType> dist;
+    Sequence<SizeType> parent;
+    Sequence<SizeType> stamp;
+    IndexedDaryHeap<EdgeValueType> heap;
+  };
+
+public:
+  /**
+   * Prepares queries on `graph`. Builds a reverse adjacency in flat arrays,
+   * used by the backward half of bidirectional searches.
+   */
+  explicit PointToPointQuery(const GraphT& graph);
+
+  PointToPointQuery(const PointToPointQuery&) = default;
+  PointToPointQuery(PointToPointQuery&&) noexcept = default;
+  PointToPointQuery& operator=(const PointToPointQuery&) = delete;
+  PointToPointQuery& operator=(PointToPointQuery&&) = delete;
+  ~PointToPointQuery() = default;
+
+  /**
+   * Dijkstra's algorithm from `source`, stopped as soon as `target` is
+   * settled.
+   *
+   * @returns shortest path weight, `inf_weight` if `target` is unreachable.
+   */
+  EdgeValueType djikstra(SizeType source, SizeType target);
+
+  /**
+   * Bidirectional Dijkstra: a forward search from `source` and a backward
+   * search from `target` alternate, always advancing the side with the
+   * smaller smallest key, and stop once the two smallest keys add up to at
+   * least the best `source` -> `target` path seen so far.
+   *
+   * @returns shortest path weight, `inf_weight` if `target` is unreachable.
+   */
+  EdgeValueType bidirectional_djikstra(SizeType source, SizeType target);
+
+  /**
+   * A* search from `source` to `target`. `heuristic(v)` must return a lower
+   * bound on the weight of the shortest path from `v` to `target`
+   * (admissible). A consistent heuristic settles every node at most once;
+   * an admissible but inconsistent one may reopen nodes.
+   *
+   * @returns shortest path weight, `inf_weight` if `target` is unreachable.
+   */
+  template <typename HeuristicT>
+  EdgeValueType a_star(SizeType source, SizeType target, HeuristicT heuristic);
+
+  /**
+   * Returns the nodes of the shortest path found by the last query, from
+   * source to target, or an empty vector if the target was unreachable.
+   */
+  Sequence<SizeType> path() const;
+
+  /// Returns the number of nodes settled by the last query.
+  SizeType num_of_settled() const { return m_num_of_settled; }
+
+private:
+  void start_query(SizeType source, SizeType target);
+  bool reached(const Search& search, SizeType v_i) const {
+    return search.stamp[v_i] == m_query;
+  }
+  EdgeValueType dist(const Search& search, SizeType v_i) const {
+    return reached(search, v_i) ? search.dist[v_i] : inf_weight;
+  }
+  /// Lowers the distance of `v_i` to `d`, returns true on improvement.
+  bool relax(Search& search, SizeType u_i, SizeType v_i, EdgeValueType d,
+             EdgeValueType key);
+  /// Settles the top node of the backward search.
+  void settle_backward(EdgeValueType& best);
+
+private:
+  const GraphT& m_graph;
+  /// Reverse adjacency: in-edges of node `v` are in
+  /// `[m_reverse_offsets[v], m_reverse_offsets[v + 1])`.
+  Sequence<SizeType> m_reverse_offsets;
+  Sequence<SizeType> m_reverse_sources;
+  Sequence<EdgeValueType> m_reverse_weights;
+
+  Search m_forward;
+  Search m_backward;
+  /// Current query id, scratch entries with another stamp are stale.
+  SizeType m_query = 0;
+
+  SizeType m_source = npos, m_target = npos;
+  /// Node where the two searches of the last query met, `npos` if none.
+  SizeType m_meet = npos;
+  bool m_last_bidirectional = false;
+  SizeType m_num_of_settled = 0;
+};
+
+template <typename GraphT>
+constexpr typename PointToPointQuery<GraphT>::SizeType
+    PointToPointQuery<GraphT>::npos;
+template <typename GraphT>
+constexpr typename PointToPointQuery<GraphT>::EdgeValueType
+    PointToPointQuery<GraphT>::inf_weight;
+
+template <typename GraphT>
+PointToPointQuery<GraphT>::PointToPointQuery(const GraphT& graph)
+    : m_graph(graph), m_reverse_offsets(graph.size() + 1, 0),
+      m_forward(graph.size()), m_backward(graph.size()) {
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      ++m_reverse_offsets[edge.first + 1];
+    }
+  }
+  for (SizeType v_i = 0; v_i < graph.size(); ++v_i) {
+    m_reverse_offsets[v_i + 1] += m_reverse_offsets[v_i];
+  }
+  m_reverse_sources.resize(m_reverse_offsets.back());
+  m_reverse_weights.resize(m_reverse_offsets.back());
+  Sequence<SizeType> position(m_reverse_offsets.begin(),
+                              m_reverse_offsets.end() - 1);
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      SizeType pos = position[edge.first]++;
+      m_reverse_sources[pos] = u.index();
+      m_reverse_weights[pos] = edge.second;
+    }
+  }
+}
+
+template <typename GraphT>
+void PointToPointQuery<GraphT>::start_query(SizeType source, SizeType target) {
+  ++m_query;
+  m_forward.heap.clear();
+  m_backward.heap.clear();
+  m_source = source;
+  m_target = target;
+  m_meet = npos;
+  m_num_of_settled = 0;
+}
+
+template <typename GraphT>
+bool PointToPointQuery<GraphT>::relax(Search& search, SizeType u_i,
+                                      SizeType v_i, EdgeValueType d,
+                                      EdgeValueType key) {
+  if (reached(search, v_i) && !(d < search.dist[v_i]))
+    return false;
+  search.stamp[v_i] = m_query;
+  search.dist[v_i] = d;
+  search.parent[v_i] = u_i;
+  if (search.heap.contains(v_i))
+    search.heap.decrease_key(v_i, key);
+  else
+    search.heap.push(v_i, key);
+  return true;
+}
+
+template <typename GraphT>
+typename PointToPointQuery<GraphT>::EdgeValueType
+PointToPointQuery<GraphT>::djikstra(SizeType source, SizeType target) {
+  start_query(source, target);
+  m_last_bidirectional = false;
+  relax(m_forward, npos, source, 0, 0);
+  while (!m_forward.heap.empty()) {
+    SizeType u_i = m_forward.heap.top();
+    m_forward.heap.pop();
+    ++m_num_of_settled;
+    if (u_i == target)
+      return m_forward.dist[u_i];
+    EdgeValueType d = m_forward.dist[u_i];
+    for (auto edge : m_graph[u_i].edges) {
+      relax(m_forward, u_i, edge.first, d + edge.second, d + edge.second);
+    }
+  }
+  return inf_weight;
+}
+
+template <typename GraphT>
+template <typename HeuristicT>
+typename PointToPointQuery<GraphT>::EdgeValueType
+PointToPointQuery<GraphT>::a_star(SizeType source, SizeType target,
+                                  HeuristicT heuristic) {
+  start_query(source, target);
+  m_last_bidirectional = false;
+  relax(m_forward, npos, source, 0, heuristic(source));
+  while (!m_forward.heap.empty()) {
+    SizeType u_i = m_forward.heap.top();
+    m_forward.heap.pop();
+    ++m_num_of_settled;
+    if (u_i == target)
+      return m_forward.dist[u_i];
+    EdgeValueType d = m_forward.dist[u_i];
+    for (auto edge : m_graph[u_i].edges) {
+      EdgeValueType temp_dist = d + edge.second;
+      relax(m_forward, u_i, edge.first, temp_dist,
+            temp_dist + heuristic(edge.first));
+    }
+  }
+  return inf_weight;
+}
+
+template <typename GraphT>
+void PointToPointQuery<GraphT>::settle_backward(EdgeValueType& best) {
+  SizeType v_i = m_backward.heap.top();
+  m_backward.heap.pop();
+  ++m_num_of_settled;
+  EdgeValueType d = m_backward.dist[v_i];
+  for (SizeType e = m_reverse_offsets[v_i]; e < m_reverse_offsets[v_i + 1];
+       ++e) {
+    SizeType u_i = m_reverse_sources[e];
+    EdgeValueType temp_dist = d + m_reverse_weights[e];
+    if (relax(m_backward, v_i, u_i, temp_dist, temp_dist) &&
+        reached(m_forward, u_i) && m_forward.dist[u_i] + temp_dist < best) {
+      best = m_forward.dist[u_i] + temp_dist;
+      m_meet = u_i;
+    }
+  }
+}
+
+template <typename GraphT>
+typename PointToPointQuery<GraphT>::EdgeValueType
+PointToPointQuery<GraphT>::bidirectional_djikstra(SizeType source,
+                                                  SizeType target) {
+  start_query(source, target);
+  m_last_bidirectional = true;
+  relax(m_forward, npos, source, 0, 0);
+  relax(m_backward, npos, target, 0, 0);
+  EdgeValueType best = inf_weight;
+  if (source == target) {
+    m_meet = source;
+    best = 0;
+  }
+
+  while (!m_forward.heap.empty() && !m_backward.heap.empty()) {
+    EdgeValueType forward_key = m_forward.heap.top_key();
+    EdgeValueType backward_key = m_backward.heap.top_key();
+    // Any path through unsettled nodes weighs at least the sum of the two
+    // smallest keys.
+    if (best != inf_weight && !(forward_key + backward_key < best))
+      break;
+    if (backward_key < forward_key) {
+      settle_backward(best);
+      continue;
+    }
+    SizeType u_i = m_forward.heap.top();
+    m_forward.heap.pop();
+    ++m_num_of_settled;
+    EdgeValueType d = m_forward.dist[u_i];
+    for (auto edge : m_graph[u_i].edges) {
+      SizeType v_i = edge.first;
+      EdgeValueType temp_dist = d + edge.second;
+      if (relax(m_forward, u_i, v_i, temp_dist, temp_dist) &&
+          reached(m_backward, v_i) && temp_dist + m_backward.dist[v_i] < best) {
+        best = temp_dist + m_backward.dist[v_i];
+        m_meet = v_i;
+      }
+    }
+  }
+  return best;
+}
+
+template <typename GraphT>
+std::vector<typename PointToPointQuery<GraphT>::SizeType>
+PointToPointQuery<GraphT>::path() const {
+  Sequence<SizeType> nodes;
+  SizeType last = m_last_bidirectional ? m_meet : m_target;
+  if (last == npos || !reached(m_forward, last))
+    return nodes;
+  for (SizeType u_i = last; u_i != npos; u_i = m_forward.parent[u_i]) {
+    nodes.push_back(u_i);
+  }
+  std::reverse(nodes.begin(), nodes.end());
+  if (m_last_bidirectional) {
+    for (SizeType v_i = m_backward.parent[m_meet]; v_i != npos;
+         v_i = m_backward.parent[v_i]) {
+      nodes.push_back(v_i);
+    }
+  }
+  return nodes;
+}
+
+} // namespace dragon
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef DRAGON_GRAPH_REORDERING_HPP
+#define DRAGON_GRAPH_REORDERING_HPP
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+
+/// Vertex orders computed by `vertex_order`.
+enum class VertexOrder {
+  /// Reverse Cuthill-McKee, keeps neighbours close, low bandwidth.
+  reverse_cuthill_mckee,
+  /// Decreasing degree, packs the hubs of power-law graphs together.
+  degree_descending,
+  /// Breadth first search order from the root.
+  bfs,
+  /// Depth first search preorder from the root.
+  dfs
+};
+
+namespace details {
+/**
+ * Breadth first order of the nodes reachable from `source` and not yet
+ * `visited`, appended to `order`. With `by_degree`, the neighbours of each
+ * node are visited by increasing degree, as Cuthill-McKee does.
+ */
+template <typename GraphT>
+void bfs_order(const GraphT& graph, typename GraphT::SizeType source,
+               bool by_degree, std::vector<bool>& visited,
+               std::vector<typename GraphT::SizeType>& order) {
+  using SizeType = typename GraphT::SizeType;
+  auto degree = [&](SizeType v_i) { return graph[v_i].edges.size(); };
+  visited[source] = true;
+  order.push_back(source);
+  for (SizeType head = order.size() - 1; head < order.size(); ++head) {
+    const SizeType first = order.size();
+    for (auto edge : graph[order[head]].edges) {
+      if (!visited[edge.first]) {
+        visited[edge.first] = true;
+        order.push_back(edge.first);
+      }
+    }
+    if (by_degree) {
+      std::stable_sort(order.begin() + first, order.end(),
+                       [&](SizeType a, SizeType b) {
+                         return degree(a) < degree(b);
+                       });
+    }
+  }
+}
+
+/**
+ * Depth first preorder of the nodes reachable from `source` and not yet
+ * `visited`, appended to `order`, with an explicit stack of edge iterators.
+ */
+template <typename GraphT>
+void dfs_order(const GraphT& graph, typename GraphT::SizeType source,
+               std::vector<bool>& visited,
+               std::vector<typename GraphT::SizeType>& order) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeIteratorType = decltype(graph[source].edges.begin());
+  std::vector<std::pair<SizeType, EdgeIteratorType>> stack;
+  visited[source] = true;
+  order.push_back(source);
+  stack.emplace_back(source, graph[source].edges.begin());
+  while (!stack.empty()) {
+    const SizeType u_i = stack.back().first;
+    auto& it = stack.back().second;
+    if (it == graph[u_i].edges.end()) {
+      stack.pop_back();
+      continue;
+    }
+    const SizeType v_i = (it++)->first;
+    if (visited[v_i])
+      continue;
+    visited[v_i] = true;
+    order.push_back(v_i);
+    stack.emplace_back(v_i, graph[v_i].edges.begin());
+  }
+}
+} // namespace details
+
+/**
+ * Computes a new order of the nodes of `graph` that makes traversals touch
+ * memory more sequentially.
+ *
+ * Searches follow out-edges. They start from the root, then from every
+ * node left unvisited, in index order, or by increasing degree for
+ * Cuthill-McKee, whose result is finally reversed. Degree ties keep index
+ * order.
+ *
+ * @returns the nodes in their new order, i.e. the old index of every new
+ * index.
+ */
+template <typename GraphT>
+std::vector<typename GraphT::SizeType> vertex_order(const GraphT& graph,
+                                                    VertexOrder order) {
+  using SizeType = typename GraphT::SizeType;
+  const SizeType sz = graph.size();
+  std::vector<SizeType> nodes(sz);
+  std::iota(nodes.begin(), nodes.end(), SizeType(0));
+  auto degree = [&](SizeType v_i) { return graph[v_i].edges.size(); };
+  if (order == VertexOrder::degree_descending) {
+    std::stable_sort(nodes.begin(), nodes.end(), [&](SizeType a, SizeType b) {
+      return degree(b) < degree(a);
+    });
+    return nodes;
+  }
+
+  std::vector<SizeType> old_index;
+  old_index.reserve(sz);
+  std::vector<bool> visited(sz, false);
+  if (order == VertexOrder::reverse_cuthill_mckee) {
+    // Low degree nodes are a cheap stand-in for peripheral nodes.
+    std::stable_sort(nodes.begin(), nodes.end(), [&](SizeType a, SizeType b) {
+      return degree(a) < degree(b);
+    });
+  } else if (sz > 0) {
+    std::swap(nodes[0], nodes[graph.root()]);
+    std::sort(nodes.begin() + 1, nodes.end());
+  }
+  for (SizeType source : nodes) {
+    if (visited[source])
+      continue;
+    if (order == VertexOrder::dfs)
+      details::dfs_order(graph, source, visited, old_index);
+    else
+      details::bfs_order(graph, source,
+                         order == VertexOrder::reverse_cuthill_mckee,
+                         visited, old_index);
+  }
+  if (order == VertexOrder::reverse_cuthill_mckee)
+    std::reverse(old_index.begin(), old_index.end());
+  return old_index;
+}
+
+/**
+ * Copy of `graph` where the node of old index `old_index[i]` gets index
+ * `i`, with its value and out-edges. The root follows its node.
+ *
+ * @param new_index the new index of every old index, inverse of
+ * `old_index`.
+ */
+template <typename ValueT, typename EdgeValueT>
+Graph<ValueT, EdgeValueT>
+relabel(const Graph<ValueT, EdgeValueT>& graph,
+        const std::vector<std::size_t>& old_index,
+        const std::vector<std::size_t>& new_index) {
+  const std::size_t sz = graph.size();
+  Graph<ValueT, EdgeValueT> relabeled(sz, sz > 0 ? new_index[graph.root()]
+                                                 : graph.root());
+  for (std::size_t u_i = 0; u_i < sz; ++u_i) {
+    const auto& u = graph[old_index[u_i]];
+    relabeled[u_i].value = u.value;
+    for (auto edge : u.edges) {
+      relabeled.add_directed_edge(u_i, new_index[edge.first], edge.second);
+    }
+  }
+  return relabeled;
+}
+
+/**
+ * Same as above for a `CSRGraph`, rows are built in place and re-sorted by
+ * their new targets.
+ */
+template <typename ValueT, typename EdgeValueT>
+CSRGraph<ValueT, EdgeValueT>
+relabel(const CSRGraph<ValueT, EdgeValueT>& graph,
+        const std::vector<std::size_t>& old_index,
+        const std::vector<std::size_t>& new_index) {
+  const std::size_t sz = graph.size();
+  std::vector<std::size_t> offsets(sz + 1, 0), targets(graph.num_edges());
+  std::vector<EdgeValueT> weights(graph.num_edges());
+  std::vector<ValueT> values(sz);
+  std::vector<std::pair<std::size_t, EdgeValueT>> row;
+  for (std::size_t u_i = 0; u_i < sz; ++u_i) {
+    const auto& u = graph[old_index[u_i]];
+    values[u_i] = u.value;
+    row.clear();
+    for (auto edge : u.edges) {
+      row.emplace_back(new_index[edge.first], edge.second);
+    }
+    std::sort(row.begin(), row.end(), [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    });
+    std::size_t a = offsets[u_i];
+    for (const auto& edge : row) {
+      targets[a] = edge.first;
+      weights[a] = edge.second;
+      ++a;
+    }
+    offsets[u_i + 1] = a;
+  }
+  return CSRGraph<ValueT, EdgeValueT>(
+      std::move(offsets), std::move(targets), std::move(weights),
+      std::move(values), sz > 0 ? new_index[graph.root()] : graph.root());
+}
+
+/**
+ * Relabels the nodes of `graph` in the given `order`, see `vertex_order`,
+ * for faster traversals of the result.
+ *
+ * @param new_index receives the new index of every old index.
+ * @param old_index receives the old index of every new index.
+ * @returns the relabeled graph.
+ */
+template <typename GraphT>
+GraphT reorder(const GraphT& graph, VertexOrder order,
+               std::vector<typename GraphT::SizeType>& new_index,
+               std::vector<typename GraphT::SizeType>& old_index) {
+  old_index = vertex_order(graph, order);
+  new_index.resize(old_index.size());
+  for (typename GraphT::SizeType i = 0; i < old_index.size(); ++i) {
+    new_index[old_index[i]] = i;
+  }
+  return relabel(graph, old_index, new_index);
+}
+
+} // namespace dragon
+
+#endif
@@ -1,47 +1,338 @@
 #ifndef DRAGON_GRAPH_SHORTEST_PATH_HPP
 #define DRAGON_GRAPH_SHORTEST_PATH_HPP
+#include <algorithm>
+#include <deque>
+#include <functional>
 #include <limits>
+#include <queue>
 #include <set>
+#include <type_traits>
 #include <utility>
 #include <vector>
+#include "dragon/ds/indexed-d-ary-heap.hpp"
+#include "dragon/ds/radix-heap.hpp"
 #include "dragon/graph/graph.hpp"
 
 namespace dragon {
-template <typename GraphT>
+/**
+ * Priority queue policies for `djikstra`.
+ *
+ * A policy provides `Queue<KeyT>`, constructible from the number of nodes,
+ * with the following members:
+ * - `empty()`
+ * - `push(v_i, old_key, key)`, called whenever the tentative distance of
+ * node `v_i` drops from `old_key` to `key`.
+ * - `pop()`, removes and returns the (key, node) pair with the smallest key.
+ * A popped key may be stale, i.e. larger than the current distance of its
+ * node, in which case `djikstra` skips it.
+ */
+
+/// Balanced binary search tree, every update is an erase and an insert.
+struct SetQueue {
+  template <typename KeyT> class Queue {
+  public:
+    using SizeType = std::size_t;
+    explicit Queue(SizeType) {}
+    bool empty() const { return m_set.empty(); }
+    void push(SizeType v_i, const KeyT& old_key, const KeyT& key) {
+      m_set.erase({old_key, v_i});
+      m_set.insert({key, v_i});
+    }
+    std::pair<KeyT, SizeType> pop() {
+      auto top = *m_set.begin();
+      m_set.erase(m_set.begin());
+      return top;
+    }
+
+  private:
+    std::set<std::pair<KeyT, SizeType>> m_set;
+  };
+};
+
+/**
+ * Indexed d-ary heap with decrease-key, every node is in the queue at most
+ * once and no operation allocates.
+ */
+template <std::size_t Arity = 4> struct DaryHeapQueue {
+  template <typename KeyT> class Queue {
+  public:
+    using SizeType = std::size_t;
+    explicit Queue(SizeType sz) : m_heap(sz) {}
+    bool empty() const { return m_heap.empty(); }
+    void push(SizeType v_i, const KeyT&, const KeyT& key) {
+      m_heap.push_or_decrease(v_i, key);
+    }
+    std::pair<KeyT, SizeType> pop() {
+      std::pair<KeyT, SizeType> top(m_heap.top_key(), m_heap.top());
+      m_heap.pop();
+      return top;
+    }
+
+  private:
+    IndexedDaryHeap<KeyT, Arity> m_heap;
+  };
+};
+
+/**
+ * Binary heap with lazy deletion: an update pushes a new entry and leaves the
+ * old one in place to be skipped when popped. Only reachable nodes are ever
+ * pushed.
+ */
+struct LazyBinaryHeapQueue {
+  template <typename KeyT> class Queue {
+  public:
+    using SizeType = std::size_t;
+    using EntryType = std::pair<KeyT, SizeType>;
+    explicit Queue(SizeType) {}
+    bool empty() const { return m_heap.empty(); }
+    void push(SizeType v_i, const KeyT&, const KeyT& key) {
+      m_heap.emplace(key, v_i);
+    }
+    EntryType pop() {
+      auto top = m_heap.top();
+      m_heap.pop();
+      return top;
+    }
+
+  private:
+    std::priority_queue<EntryType, std::vector<EntryType>,
+                        std::greater<EntryType>>
+        m_heap;
+  };
+};
+
+/**
+ * Computes weights of shortest paths from `source` to every node of a graph
+ * with non-negative edge weights. Unreachable nodes get
+ * `std::numeric_limits<EdgeValueType>::max()`.
+ *
+ * @param source index of the source node, `npos` for the root.
+ * @param QueuePolicyT priority queue used to pick the next node, one of
+ * `DaryHeapQueue<Arity>`, `LazyBinaryHeapQueue` or `SetQueue`, selected by
+ * passing an instance, e.g. `djikstra(graph, source, SetQueue{})`.
+ */
+template <typename GraphT, typename QueuePolicyT>
 std::vector<typename GraphT::EdgeValueType>
-djikstra(const GraphT& graph, typename GraphT::SizeType source = GraphT::npos) {
-  using SizeType = typename GraphT::SizeType;
+djikstra(const GraphT& graph, typename GraphT::SizeType source,
+         QueuePolicyT) {
   using EdgeValueType = typename GraphT::EdgeValueType;
+  using QueueType = typename QueuePolicyT::template Queue<EdgeValueType>;
   if (source == GraphT::npos)
     source = graph.root();
   const auto inf_weight = std::numeric_limits<EdgeValueType>::max();
   std::vector<EdgeValueType> shortest_paths_weight(graph.size(), inf_weight);
   shortest_paths_weight[source] = 0;
-  std::set<std::pair<EdgeValueType, SizeType>> priority_q;
-  for (auto i = 0U; i < shortest_paths_weight.size(); ++i) {
-    priority_q.insert({shortest_paths_weight[i], i});
-  }
+  QueueType priority_q(graph.size());
+  priority_q.push(source, inf_weight, 0);
   while (!priority_q.empty()) {
-    auto top = *priority_q.begin();
-    if (top.first == inf_weight) {
-      break;
+    auto top = priority_q.pop();
+    if (shortest_paths_weight[top.second] < top.first) {
+      continue;
     }
-    priority_q.erase(priority_q.begin());
     const auto& u = graph[top.second];
     for (auto edge : u.edges) {
       auto v_i = edge.first;
       auto temp_dist = top.first + edge.second;
       auto& cur_dist = shortest_paths_weight[v_i];
       if (temp_dist < cur_dist) {
-        priority_q.erase({cur_dist, v_i});
+        priority_q.push(v_i, cur_dist, temp_dist);
+        cur_dist = temp_dist;
+      }
+    }
+  }
+  return shortest_paths_weight;
+}
+
+/// Same as above with a `DaryHeapQueue<>`.
+template <typename GraphT>
+std::vector<typename GraphT::EdgeValueType>
+djikstra(const GraphT& graph, typename GraphT::SizeType source = GraphT::npos) {
+  return djikstra(graph, source, DaryHeapQueue<>{});
+}
+
+/**
+ * Computes weights of shortest paths from `source` on a graph whose edge
+ * weights are all 0 or 1, in O(V + E), using a double ended queue in place
+ * of a priority queue.
+ */
+template <typename GraphT>
+std::vector<typename GraphT::EdgeValueType>
+zero_one_bfs(const GraphT& graph,
+             typename GraphT::SizeType source = GraphT::npos) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  if (source == GraphT::npos)
+    source = graph.root();
+  const auto inf_weight = std::numeric_limits<EdgeValueType>::max();
+  std::vector<EdgeValueType> shortest_paths_weight(graph.size(), inf_weight);
+  shortest_paths_weight[source] = 0;
+  std::deque<std::pair<EdgeValueType, SizeType>> dq;
+  dq.emplace_back(0, source);
+  while (!dq.empty()) {
+    auto top = dq.front();
+    dq.pop_front();
+    if (shortest_paths_weight[top.second] < top.first) {
+      continue;
+    }
+    for (auto edge : graph[top.second].edges) {
+      auto temp_dist = top.first + edge.second;
+      auto& cur_dist = shortest_paths_weight[edge.first];
+      if (temp_dist < cur_dist) {
+        cur_dist = temp_dist;
+        if (edge.second == 0)
+          dq.emplace_front(temp_dist, edge.first);
+        else
+          dq.emplace_back(temp_dist, edge.first);
+      }
+    }
+  }
+  return shortest_paths_weight;
+}
+
+/**
+ * Dial's algorithm: computes weights of shortest paths from `source` on a
+ * graph with integral edge weights in `[0, max_weight]`.
+ *
+ * All tentative distances lie within `max_weight` of the distance being
+ * settled, so a circular array of `max_weight + 1` buckets replaces the
+ * priority queue. Runs in O(V + E + D) where `D` is the largest finite
+ * distance.
+ */
+template <typename GraphT>
+std::vector<typename GraphT::EdgeValueType>
+dial_djikstra(const GraphT& graph, typename GraphT::EdgeValueType max_weight,
+              typename GraphT::SizeType source = GraphT::npos) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  static_assert(std::is_integral<EdgeValueType>::value,
+                "dragon::dial_djikstra requires integral edge weights");
+  if (source == GraphT::npos)
+    source = graph.root();
+  const auto inf_weight = std::numeric_limits<EdgeValueType>::max();
+  std::vector<EdgeValueType> shortest_paths_weight(graph.size(), inf_weight);
+  shortest_paths_weight[source] = 0;
+
+  const auto num_of_buckets = static_cast<SizeType>(max_weight) + 1;
+  std::vector<std::vector<SizeType>> buckets(num_of_buckets);
+  buckets[0].push_back(source);
+  SizeType pending = 1;
+  for (EdgeValueType cur = 0; pending != 0; ++cur) {
+    auto& bucket = buckets[static_cast<SizeType>(cur) % num_of_buckets];
+    // Zero weight edges append to the bucket being scanned.
+    for (SizeType i = 0; i < bucket.size(); ++i) {
+      SizeType u_i = bucket[i];
+      // Entries whose node has since moved to a smaller distance are stale.
+      if (shortest_paths_weight[u_i] != cur)
+        continue;
+      for (auto edge : graph[u_i].edges) {
+        auto temp_dist = cur + edge.second;
+        auto& cur_dist = shortest_paths_weight[edge.first];
+        if (temp_dist < cur_dist) {
+          cur_dist = temp_dist;
+          buckets[static_cast<SizeType>(temp_dist) % num_of_buckets].push_back(
+              edge.first);
+          ++pending;
+        }
+      }
+    }
+    pending -= bucket.size();
+    bucket.clear();
+  }
+  return shortest_paths_weight;
+}
+
+/**
+ * Computes weights of shortest paths from `source` on a graph with
+ * non-negative integral edge weights, using a `RadixHeap` as the priority
+ * queue. Every operation is amortized O(bits(EdgeValueType)) regardless of
+ * the number of nodes.
+ */
+template <typename GraphT>
+std::vector<typename GraphT::EdgeValueType>
+radix_djikstra(const GraphT& graph,
+               typename GraphT::SizeType source = GraphT::npos) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  static_assert(std::is_integral<EdgeValueType>::value,
+                "dragon::radix_djikstra requires integral edge weights");
+  using KeyType = std::make_unsigned_t<EdgeValueType>;
+  if (source == GraphT::npos)
+    source = graph.root();
+  const auto inf_weight = std::numeric_limits<EdgeValueType>::max();
+  std::vector<EdgeValueType> shortest_paths_weight(graph.size(), inf_weight);
+  shortest_paths_weight[source] = 0;
+  RadixHeap<KeyType, SizeType> heap;
+  heap.push(0, source);
+  while (!heap.empty()) {
+    auto top = heap.pop();
+    auto dist = static_cast<EdgeValueType>(top.first);
+    if (shortest_paths_weight[top.second] < dist) {
+      continue;
+    }
+    for (auto edge : graph[top.second].edges) {
+      auto temp_dist = dist + edge.second;
+      auto& cur_dist = shortest_paths_weight[edge.first];
+      if (temp_dist < cur_dist) {
         cur_dist = temp_dist;
-        priority_q.insert({cur_dist, v_i});
+        heap.push(static_cast<KeyType>(temp_dist), edge.first);
       }
     }
   }
   return shortest_paths_weight;
 }
 
+namespace details {
+/// Largest edge weight for which `shortest_paths` picks Dial's algorithm.
+constexpr std::size_t dial_max_weight = 1024;
+
+template <typename GraphT>
+std::vector<typename GraphT::EdgeValueType>
+shortest_paths_impl(const GraphT& graph, typename GraphT::SizeType source,
+                    std::true_type /*is_integral*/) {
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  EdgeValueType max_weight = 0;
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      if (max_weight < edge.second)
+        max_weight = edge.second;
+    }
+  }
+  if (max_weight <= 1)
+    return zero_one_bfs(graph, source);
+  if (static_cast<std::size_t>(max_weight) <= dial_max_weight)
+    return dial_djikstra(graph, max_weight, source);
+  return radix_djikstra(graph, source);
+}
+
+template <typename GraphT>
+std::vector<typename GraphT::EdgeValueType>
+shortest_paths_impl(const GraphT& graph, typename GraphT::SizeType source,
+                    std::false_type /*is_integral*/) {
+  return djikstra(graph, source);
+}
+} // namespace details
+
+/**
+ * Computes weights of shortest paths from `source` to every node of a graph
+ * with non-negative edge weights, picking the fastest applicable algorithm.
+ *
+ * For integral `EdgeValueType` the edge weights are scanned once, then:
+ * - weights in {0, 1} use `zero_one_bfs`,
+ * - weights up to `details::dial_max_weight` use `dial_djikstra`,
+ * - larger weights use `radix_djikstra`.
+ * Other weight types use `djikstra`. The result is always the same as
+ * `djikstra`'s.
+ */
+template <typename GraphT>
+std::vector<typename GraphT::EdgeValueType>
+shortest_paths(const GraphT& graph,
+               typename GraphT::SizeType source = GraphT::npos) {
+  if (source == GraphT::npos)
+    source = graph.root();
+  return details::shortest_paths_impl(
+      graph, source, std::is_integral<typename GraphT::EdgeValueType>());
+}
+
 template <class GraphT>
 bool bellman_ford(const GraphT& graph,
                   std::vector<typename GraphT::EdgeValueType>& shortest_path_wt,
@@ -81,6 +372,127 @@ bool bellman_ford(const GraphT& graph,
   }
   return true;
 }
+
+namespace details {
+/**
+ * Returns the nodes of a cycle of the parent pointer graph `parent`, in edge
+ * order (`parent[cycle[i + 1]] == cycle[i]`), or an empty vector if the
+ * parent pointers form a forest. Runs in O(parent.size()).
+ */
+template <typename SizeT>
+std::vector<SizeT> find_parent_cycle(const std::vector<SizeT>& parent,
+                                     SizeT npos) {
+  // `walk[u]` is the index of the first walk that reached `u`, plus one.
+  std::vector<SizeT> walk(parent.size(), 0);
+  for (SizeT s_i = 0; s_i < parent.size(); ++s_i) {
+    SizeT u_i = s_i;
+    while (u_i != npos && walk[u_i] == 0) {
+      walk[u_i] = s_i + 1;
+      u_i = parent[u_i];
+    }
+    if (u_i == npos || walk[u_i] != s_i + 1)
+      continue;
+    // The walk started at `s_i` came back to `u_i`, which lies on a cycle.
+    std::vector<SizeT> cycle;
+    SizeT v_i = u_i;
+    do {
+      cycle.push_back(v_i);
+      v_i = parent[v_i];
+    } while (v_i != u_i);
+    std::reverse(cycle.begin(), cycle.end());
+    return cycle;
+  }
+  return {};
+}
+} // namespace details
+
+/**
+ * Queue based Bellman-Ford, also known as the shortest path faster
+ * algorithm. Only out-edges of nodes whose distance changed since they were
+ * last scanned are relaxed, so the run stops as soon as distances converge
+ * instead of always doing `graph.size() - 1` passes over every edge.
+ *
+ * Every node remembers the number of edges of the walk its tentative
+ * distance comes from. A walk of `graph.size()` edges or more repeats a
+ * node, which triggers a search for a cycle in the parent pointer graph; any
+ * such cycle has negative weight. Searches are spaced at least
+ * `graph.size()` relaxations apart, so they cost O(1) amortized per
+ * relaxation.
+ *
+ * @param graph graph whose edge weights may be negative.
+ * @param shortest_path_wt receives shortest path weights from `source`,
+ * `std::numeric_limits<EdgeValueType>::max()` for unreachable nodes. Its
+ * contents are unspecified if a negative cycle is found.
+ * @param negative_cycle receives the nodes of a negative weight cycle in edge
+ * order (`cycle[0] -> cycle[1] -> ... -> cycle[0]`), or is left empty.
+ * @param source index of the source node, root of the graph by default.
+ * @returns false if a negative weight cycle is reachable from `source`.
+ */
+template <class GraphT>
+bool spfa(const GraphT& graph,
+          std::vector<typename GraphT::EdgeValueType>& shortest_path_wt,
+          std::vector<typename GraphT::SizeType>& negative_cycle,
+          typename GraphT::SizeType source = GraphT::npos) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+
+  if (source == GraphT::npos) {
+    source = graph.root();
+  }
+  const SizeType sz = graph.size();
+  EdgeValueType inf_wt = std::numeric_limits<EdgeValueType>::max();
+  shortest_path_wt.assign(sz, inf_wt);
+  shortest_path_wt[source] = 0;
+  negative_cycle.clear();
+
+  std::vector<SizeType> parent(sz, GraphT::npos);
+  // Number of edges on the walk that gave the current tentative distance.
+  std::vector<SizeType> walk_length(sz, 0);
+  std::vector<bool> in_queue(sz, false);
+  std::deque<SizeType> queue;
+  queue.push_back(source);
+  in_queue[source] = true;
+  SizeType relaxations_since_search = sz;
+
+  while (!queue.empty()) {
+    SizeType u_i = queue.front();
+    queue.pop_front();
+    in_queue[u_i] = false;
+    for (auto edge : graph[u_i].edges) {
+      SizeType v_i = edge.first;
+      auto temp_wt = shortest_path_wt[u_i] + edge.second;
+      if (!(temp_wt < shortest_path_wt[v_i]))
+        continue;
+      shortest_path_wt[v_i] = temp_wt;
+      parent[v_i] = u_i;
+      walk_length[v_i] = walk_length[u_i] + 1;
+      ++relaxations_since_search;
+      if (walk_length[v_i] >= sz && relaxations_since_search >= sz) {
+        relaxations_since_search = 0;
+        negative_cycle = details::find_parent_cycle(parent, GraphT::npos);
+        if (!negative_cycle.empty())
+          return false;
+      }
+      if (!in_queue[v_i]) {
+        in_queue[v_i] = true;
+        queue.push_back(v_i);
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Same as above, for callers that only need to know whether a negative
+ * cycle exists.
+ */
+template <class GraphT>
+bool spfa(const GraphT& graph,
+          std::vector<typename GraphT::EdgeValueType>& shortest_path_wt,
+          typename GraphT::SizeType source = GraphT::npos) {
+  std::vector<typename GraphT::SizeType> negative_cycle;
+  return spfa(graph, shortest_path_wt, negative_cycle, source);
+}
 } // namespace dragon
 
 #endif
\ No newline at end of file
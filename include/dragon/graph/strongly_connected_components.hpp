@@ -0,0 +1,155 @@
+#ifndef DRAGON_GRAPH_STRONGLY_CONNECTED_COMPONENTS_HPP
+#define DRAGON_GRAPH_STRONGLY_CONNECTED_COMPONENTS_HPP
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+
+/**
+ * Strongly connected components of a directed graph with Tarjan's
+ * algorithm, in O(V + E).
+ *
+ * The depth first search keeps its own stack of (node, next edge) frames
+ * instead of recursing, so it handles graphs with millions of nodes and
+ * arbitrarily long paths. It keeps its state in local arrays and never
+ * touches `Node::color`, so the graph is only read.
+ *
+ * @param graph directed graph.
+ * @param sizes receives the number of nodes of each component.
+ * @returns the component of every node. Components are numbered in
+ * topological order of the condensation: every edge `u -> v` has
+ * `component[u] <= component[v]`.
+ */
+template <typename GraphT>
+std::vector<typename GraphT::SizeType>
+strongly_connected_components(const GraphT& graph,
+                              std::vector<typename GraphT::SizeType>& sizes) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeIteratorType = decltype(graph[0].edges.begin());
+  struct Frame {
+    SizeType node;
+    EdgeIteratorType next, last;
+  };
+  const SizeType npos = std::numeric_limits<SizeType>::max();
+  const SizeType sz = graph.size();
+
+  // `index[v]` is the discovery time of `v`, `low[v]` the smallest
+  // discovery time reachable from its search subtree through nodes still on
+  // `stack`. Once its component is known, `low[v]` holds it instead.
+  std::vector<SizeType> index(sz, npos), low(sz);
+  std::vector<bool> on_stack(sz, false);
+  std::vector<SizeType> stack;
+  std::vector<Frame> frames;
+  SizeType counter = 0, num_of_components = 0;
+  sizes.clear();
+
+  auto discover = [&](SizeType v_i) {
+    index[v_i] = low[v_i] = counter++;
+    stack.push_back(v_i);
+    on_stack[v_i] = true;
+    const auto& edges = graph[v_i].edges;
+    frames.push_back({v_i, edges.begin(), edges.end()});
+  };
+
+  for (SizeType s = 0; s < sz; ++s) {
+    if (index[s] != npos)
+      continue;
+    discover(s);
+    while (!frames.empty()) {
+      Frame& frame = frames.back();
+      SizeType u_i = frame.node;
+      if (frame.next != frame.last) {
+        SizeType v_i = frame.next->first;
+        ++frame.next;
+        if (index[v_i] == npos)
+          discover(v_i);
+        else if (on_stack[v_i])
+          low[u_i] = std::min(low[u_i], index[v_i]);
+        continue;
+      }
+      frames.pop_back();
+      if (!frames.empty()) {
+        SizeType p_i = frames.back().node;
+        low[p_i] = std::min(low[p_i], low[u_i]);
+      }
+      if (low[u_i] != index[u_i])
+        continue;
+      // `u_i` is the root of a component, whose nodes lie above it.
+      sizes.push_back(0);
+      SizeType v_i;
+      do {
+        v_i = stack.back();
+        stack.pop_back();
+        on_stack[v_i] = false;
+        low[v_i] = num_of_components;
+        ++sizes.back();
+      } while (v_i != u_i);
+      ++num_of_components;
+    }
+  }
+
+  // Tarjan's algorithm completes components in reverse topological order.
+  std::reverse(sizes.begin(), sizes.end());
+  for (auto& c : low) {
+    c = num_of_components - 1 - c;
+  }
+  return low;
+}
+
+/**
+ * Builds the condensation of `graph`: a DAG with one node per strongly
+ * connected component, whose value is the number of nodes of the component,
+ * and one edge `a -> b` whenever some edge of `graph` leads from component
+ * `a` to component `b`. Parallel edges are merged into one with the
+ * smallest weight, and edges inside a component are dropped.
+ *
+ * @param component component of every node, as returned by
+ * `strongly_connected_components`.
+ * @param num_of_components number of components.
+ */
+template <typename GraphT>
+Graph<typename GraphT::SizeType, typename GraphT::EdgeValueType>
+condensation(const GraphT& graph,
+             const std::vector<typename GraphT::SizeType>& component,
+             typename GraphT::SizeType num_of_components) {
+  using SizeType = typename GraphT::SizeType;
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  Graph<SizeType, EdgeValueType> dag(
+      num_of_components, graph.size() == 0 ? 0 : component[graph.root()]);
+  for (auto& node : dag) {
+    node.value = 0;
+  }
+  for (const auto& u : graph) {
+    SizeType a = component[u.index()];
+    ++dag[a].value;
+    for (auto edge : u.edges) {
+      SizeType b = component[edge.first];
+      if (a == b)
+        continue;
+      auto it = dag[a].edges.find(b);
+      if (it == dag[a].edges.end())
+        dag[a].edges.emplace(b, edge.second);
+      else if (edge.second < it->second)
+        it->second = edge.second;
+    }
+  }
+  return dag;
+}
+
+/**
+ * Same as above, computing the components first.
+ */
+template <typename GraphT>
+Graph<typename GraphT::SizeType, typename GraphT::EdgeValueType>
+condensation(const GraphT& graph) {
+  std::vector<typename GraphT::SizeType> sizes;
+  auto component = strongly_connected_components(graph, sizes);
+  return condensation(graph, component, sizes.size());
+}
+
+} // namespace dragon
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef DRAGON_GRAPH_TOPOLOGICAL_SORT_HPP
+#define DRAGON_GRAPH_TOPOLOGICAL_SORT_HPP
+#include <atomic>
+#include <vector>
+#include "dragon/core/thread-pool.hpp"
+#include "dragon/graph/graph.hpp"
+
+namespace dragon {
+
+/**
+ * Topological sort with Kahn's algorithm in O(V + E): nodes are output once
+ * all their predecessors are, starting from nodes without in-edges.
+ *
+ * @param graph directed graph.
+ * @param order receives the nodes in topological order: every edge
+ * `u -> v` has `u` before `v`. If the graph has a cycle, it only receives the
+ * nodes that do not depend on any cycle.
+ * @returns false if the graph has a cycle.
+ */
+template <typename GraphT>
+bool topological_sort(const GraphT& graph,
+                      std::vector<typename GraphT::SizeType>& order) {
+  using SizeType = typename GraphT::SizeType;
+  const SizeType sz = graph.size();
+  std::vector<SizeType> in_degree(sz, 0);
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      ++in_degree[edge.first];
+    }
+  }
+  order.clear();
+  order.reserve(sz);
+  for (SizeType v_i = 0; v_i < sz; ++v_i) {
+    if (in_degree[v_i] == 0)
+      order.push_back(v_i);
+  }
+  // `order` doubles as the queue of nodes whose in-edges are all done.
+  for (SizeType head = 0; head < order.size(); ++head) {
+    for (auto edge : graph[order[head]].edges) {
+      if (--in_degree[edge.first] == 0)
+        order.push_back(edge.first);
+    }
+  }
+  return order.size() == sz;
+}
+
+/**
+ * Level synchronous parallel topological sort. Level 0 holds the nodes
+ * without in-edges, and level `l + 1` the nodes whose last predecessor is on
+ * level `l`, i.e. the nodes of a level only depend on earlier levels and can
+ * be processed concurrently. Each level is expanded in parallel on `pool`,
+ * with atomic in-degree counters.
+ *
+ * @param graph directed graph.
+ * @param order receives the nodes level by level, each level in no
+ * particular order. Partial if the graph has a cycle.
+ * @param levels receives the offsets of the levels in `order`: level `l` is
+ * `order[levels[l]]` to `order[levels[l + 1] - 1]`, and `levels.back()` is
+ * `order.size()`.
+ * @param pool threads to run on.
+ * @returns false if the graph has a cycle.
+ */
+template <typename GraphT>
+bool topological_sort(const GraphT& graph,
+                      std::vector<typename GraphT::SizeType>& order,
+                      std::vector<typename GraphT::SizeType>& levels,
+                      ThreadPool& pool) {
+  using SizeType = typename GraphT::SizeType;
+  const SizeType sz = graph.size();
+  std::vector<std::atomic<SizeType>> in_degree(sz);
+  pool.parallel_for(0, sz, [&](SizeType v_i, SizeType) {
+    in_degree[v_i].store(0, std::memory_order_relaxed);
+  });
+  pool.parallel_for(0, sz, [&](SizeType u_i, SizeType) {
+    for (auto edge : graph[u_i].edges) {
+      in_degree[edge.first].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  std::vector<std::vector<SizeType>> local(pool.size());
+  order.clear();
+  order.reserve(sz);
+  levels.assign(1, 0);
+  auto append_level = [&]() {
+    for (auto& nodes : local) {
+      order.insert(order.end(), nodes.begin(), nodes.end());
+      nodes.clear();
+    }
+    if (order.size() != levels.back())
+      levels.push_back(order.size());
+  };
+  pool.parallel_for(0, sz, [&](SizeType v_i, SizeType thread_index) {
+    if (in_degree[v_i].load(std::memory_order_relaxed) == 0)
+      local[thread_index].push_back(v_i);
+  });
+  append_level();
+  for (SizeType l = 0; l + 1 < levels.size(); ++l) {
+    const SizeType first = levels[l];
+    pool.parallel_for(0, levels[l + 1] - first, [&](SizeType i,
+                                                    SizeType thread_index) {
+      for (auto edge : graph[order[first + i]].edges) {
+        if (in_degree[edge.first].fetch_sub(1, std::memory_order_acq_rel) ==
+            1)
+          local[thread_index].push_back(edge.first);
+      }
+    });
+    append_level();
+  }
+  return order.size() == sz;
+}
+
+/**
+ * Same as above, running on a temporary pool with one thread per hardware
+ * thread.
+ */
+template <typename GraphT>
+bool topological_sort(const GraphT& graph,
+                      std::vector<typename GraphT::SizeType>& order,
+                      std::vector<typename GraphT::SizeType>& levels) {
+  ThreadPool pool;
+  return topological_sort(graph, order, levels, pool);
+}
+
+} // namespace dragon
+
+#endif
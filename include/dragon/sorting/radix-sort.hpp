@@ -0,0 +1,135 @@
+#ifndef DRAGON_SORTING_RADIX_SORT_HPP
+#define DRAGON_SORTING_RADIX_SORT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "dragon/core/constants.hpp"
+#include "dragon/core/utils.hpp"
+
+namespace dragon {
+namespace details {
+/// Unsigned integer type as wide as `T`.
+template <typename T>
+using RadixKeyType = typename std::conditional<
+    sizeof(T) <= 4,
+    typename std::conditional<sizeof(T) <= 2,
+                              typename std::conditional<sizeof(T) <= 1,
+                                                        std::uint8_t,
+                                                        std::uint16_t>::type,
+                              std::uint32_t>::type,
+    std::uint64_t>::type;
+
+/// Maps unsigned integers to themselves.
+template <typename T>
+RadixKeyType<T> radix_key(T key, std::true_type /* integral */,
+                          std::false_type /* signed */) {
+  return static_cast<RadixKeyType<T>>(key);
+}
+
+/// Maps signed integers to unsigned ones of the same order, by flipping the
+/// sign bit.
+template <typename T>
+RadixKeyType<T> radix_key(T key, std::true_type /* integral */,
+                          std::true_type /* signed */) {
+  using KeyT = RadixKeyType<T>;
+  return static_cast<KeyT>(static_cast<KeyT>(key) ^
+                           (KeyT(1) << (sizeof(T) * bits_in_byte - 1)));
+}
+
+/// Maps IEEE 754 floating point numbers to unsigned integers of the same
+/// order: negative numbers have all their bits flipped, positive ones only
+/// their sign bit.
+template <typename T, typename SignedT>
+RadixKeyType<T> radix_key(T key, std::false_type /* integral */,
+                          SignedT /* signed */) {
+  using KeyT = RadixKeyType<T>;
+  static_assert(sizeof(KeyT) == sizeof(T),
+                "dragon::radix_sort: unsupported floating point type");
+  const KeyT sign = KeyT(1) << (sizeof(T) * bits_in_byte - 1);
+  KeyT bits;
+  std::memcpy(&bits, &key, sizeof(T));
+  return (bits & sign) != 0 ? static_cast<KeyT>(~bits) : (bits | sign);
+}
+
+template <typename T> RadixKeyType<T> radix_key(T key) {
+  return radix_key(key, std::is_integral<T>(), std::is_signed<T>());
+}
+} // namespace details
+
+/**
+ * Sorts the range [first, last) by increasing key with a least significant
+ * digit radix sort, in O(n * sizeof(key)) time and O(n) extra space, while
+ * maintaining relative ordering of equivalent elements (sort is stable).
+ *
+ * Keys are processed one byte at a time, and passes on bytes that are the
+ * same for all keys are skipped, so narrow key ranges sort faster.
+ *
+ * @param first range begin iterator
+ * @param last range end iterator
+ * @param extract_key extract comparison key from values, key should be of
+ * integral or floating point type
+ */
+template <typename RandomIterator,
+          typename ExtractKey = details::Identity<
+              typename std::iterator_traits<RandomIterator>::value_type>>
+void radix_sort(
+    RandomIterator first, RandomIterator last,
+    ExtractKey extract_key = details::Identity<
+        typename std::iterator_traits<RandomIterator>::value_type>()) {
+  using ValueType = typename std::iterator_traits<RandomIterator>::value_type;
+  using KeyType = typename std::decay<decltype(extract_key(*first))>::type;
+  static_assert(std::is_arithmetic<KeyType>::value,
+                "dragon::radix_sort: keys must be integral or floating point");
+  using RadixType = details::RadixKeyType<KeyType>;
+  constexpr std::size_t digit_bits = details::bits_in_byte;
+  constexpr std::size_t num_of_passes = sizeof(RadixType);
+  constexpr std::size_t num_of_buckets = std::size_t(1) << digit_bits;
+  constexpr std::size_t mask = num_of_buckets - 1;
+
+  const auto sz = static_cast<std::size_t>(std::distance(first, last));
+  if (sz < 2)
+    return;
+  std::vector<RadixType> keys(sz), keys_buffer(sz);
+  std::vector<ValueType> values(std::make_move_iterator(first),
+                                std::make_move_iterator(last));
+  std::vector<ValueType> values_buffer(sz);
+  for (std::size_t i = 0; i < sz; ++i) {
+    keys[i] = details::radix_key<KeyType>(extract_key(values[i]));
+  }
+
+  // Histograms of every byte, in one pass over the keys.
+  std::vector<std::size_t> count(num_of_passes * num_of_buckets, 0);
+  for (auto key : keys) {
+    for (std::size_t pass = 0; pass < num_of_passes; ++pass) {
+      ++count[pass * num_of_buckets + ((key >> (pass * digit_bits)) & mask)];
+    }
+  }
+  for (std::size_t pass = 0; pass < num_of_passes; ++pass) {
+    std::size_t* bucket = &count[pass * num_of_buckets];
+    const std::size_t shift = pass * digit_bits;
+    if (bucket[(keys[0] >> shift) & mask] == sz)
+      continue;
+    std::size_t offset = 0;
+    for (std::size_t b = 0; b < num_of_buckets; ++b) {
+      std::size_t bucket_size = bucket[b];
+      bucket[b] = offset;
+      offset += bucket_size;
+    }
+    for (std::size_t i = 0; i < sz; ++i) {
+      std::size_t position = bucket[(keys[i] >> shift) & mask]++;
+      keys_buffer[position] = keys[i];
+      values_buffer[position] = std::move(values[i]);
+    }
+    keys.swap(keys_buffer);
+    values.swap(values_buffer);
+  }
+  std::move(values.begin(), values.end(), first);
+}
+
+} // namespace dragon
+
+#endif
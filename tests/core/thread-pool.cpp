@@ -0,0 +1,31 @@
+#include "catch2/catch.hpp"
+#include "dragon/core/thread-pool.hpp"
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+TEST_CASE("thread pool run", "[core][thread_pool]") {
+  dragon::ThreadPool pool(4);
+  REQUIRE(pool.size() == 4);
+
+  std::vector<int> seen(pool.size(), 0);
+  for (int i = 0; i < 100; ++i) {
+    pool.run([&](std::size_t thread_index) { ++seen[thread_index]; });
+  }
+  REQUIRE(seen == std::vector<int>(pool.size(), 100));
+}
+
+TEST_CASE("thread pool parallel for", "[core][thread_pool]") {
+  for (std::size_t threads : {1, 3}) {
+    dragon::ThreadPool pool(threads);
+    std::vector<int> values(10007, 0);
+    pool.parallel_for(0, values.size(), [&](std::size_t i, std::size_t) {
+      values[i] = static_cast<int>(i % 7);
+    });
+    std::atomic<long long> sum(0);
+    pool.parallel_for(
+        0, values.size(), [&](std::size_t i, std::size_t) { sum += values[i]; },
+        16);
+    REQUIRE(sum == std::accumulate(values.begin(), values.end(), 0LL));
+  }
+}
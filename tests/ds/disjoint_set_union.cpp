@@ -25,4 +25,29 @@ TEST_CASE("disjoint_set_union basic", "[ds][disjoint_set_union]") {
     REQUIRE(dsu.in_same_set(2, 8));
     REQUIRE_FALSE(dsu.in_same_set(1, 8));
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("indexed_disjoint_set_union basic", "[ds][disjoint_set_union]") {
+  dragon::IndexedDisjointSetUnion<> dsu(11);
+  REQUIRE(dsu.size() == 11);
+  REQUIRE(dsu.num_of_sets() == 11);
+
+  for (std::size_t i = 3; i <= 9; i += 2) {
+    REQUIRE(dsu.join(i - 2, i));
+  }
+  for (std::size_t i = 2; i <= 10; i += 2) {
+    REQUIRE(dsu.join(i - 2, i));
+  }
+  REQUIRE_FALSE(dsu.join(1, 9));
+  REQUIRE(dsu.num_of_sets() == 2);
+  REQUIRE(dsu.in_same_set(1, 9));
+  REQUIRE(dsu.in_same_set(2, 8));
+  REQUIRE_FALSE(dsu.in_same_set(1, 8));
+  REQUIRE(dsu.set_size(3) == 5);
+  REQUIRE(dsu.set_size(10) == 6);
+  REQUIRE(dsu.find(0) == dsu.find(10));
+
+  dsu.reset(3);
+  REQUIRE(dsu.num_of_sets() == 3);
+  REQUIRE_FALSE(dsu.in_same_set(0, 1));
+}
@@ -0,0 +1,58 @@
+#include "catch2/catch.hpp"
+#include "dragon/ds/indexed-d-ary-heap.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST_CASE("indexed d-ary heap basic", "[ds][indexed_d_ary_heap]") {
+  dragon::IndexedDaryHeap<int, 3> heap(6);
+  heap.push(0, 50);
+  heap.push(1, 20);
+  heap.push(2, 40);
+  heap.push(3, 10);
+  heap.push(4, 30);
+
+  REQUIRE(heap.size() == 5);
+  REQUIRE(heap.top() == 3);
+  REQUIRE(heap.top_key() == 10);
+  REQUIRE_FALSE(heap.contains(5));
+
+  heap.decrease_key(0, 5);
+  REQUIRE(heap.top() == 0);
+  REQUIRE_FALSE(heap.push_or_decrease(2, 45));
+  REQUIRE(heap.key(2) == 40);
+  REQUIRE(heap.push_or_decrease(5, 15));
+
+  std::vector<std::size_t> order;
+  while (!heap.empty()) {
+    order.push_back(heap.top());
+    heap.pop();
+  }
+  REQUIRE(order == std::vector<std::size_t>{0, 3, 5, 1, 4, 2});
+
+  heap.push(2, 7);
+  heap.clear();
+  REQUIRE(heap.empty());
+  REQUIRE_FALSE(heap.contains(2));
+}
+
+TEST_CASE("indexed d-ary heap sorts", "[ds][indexed_d_ary_heap]") {
+  std::mt19937 rng(7);
+  std::vector<int> keys(1000);
+  for (auto& key : keys)
+    key = static_cast<int>(rng() % 10000);
+
+  dragon::IndexedDaryHeap<int, 8> heap(keys.size());
+  for (auto i = 0U; i < keys.size(); ++i)
+    heap.push(i, keys[i] + 10000);
+  for (auto i = 0U; i < keys.size(); ++i)
+    heap.decrease_key(i, keys[i]);
+
+  std::vector<int> popped;
+  while (!heap.empty()) {
+    popped.push_back(heap.top_key());
+    heap.pop();
+  }
+  std::sort(keys.begin(), keys.end());
+  REQUIRE(popped == keys);
+}
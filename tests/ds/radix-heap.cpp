@@ -0,0 +1,37 @@
+#include "catch2/catch.hpp"
+#include "dragon/ds/radix-heap.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST_CASE("radix heap monotone", "[ds][radix_heap]") {
+  dragon::RadixHeap<unsigned, int> heap;
+  heap.push(5, 0);
+  heap.push(3, 1);
+  heap.push(9, 2);
+  REQUIRE(heap.size() == 3);
+  REQUIRE(heap.pop() == std::make_pair(3U, 1));
+
+  // Keys not smaller than the last popped key may be pushed at any time.
+  heap.push(3, 3);
+  heap.push(4, 4);
+  REQUIRE(heap.pop().first == 3);
+  REQUIRE(heap.pop().first == 4);
+  REQUIRE(heap.pop().first == 5);
+  REQUIRE(heap.pop().first == 9);
+  REQUIRE(heap.empty());
+}
+
+TEST_CASE("radix heap sorts", "[ds][radix_heap]") {
+  std::mt19937_64 rng(11);
+  std::vector<unsigned long long> keys(2000);
+  dragon::RadixHeap<unsigned long long, std::size_t> heap;
+  for (auto i = 0U; i < keys.size(); ++i) {
+    keys[i] = rng();
+    heap.push(keys[i], i);
+  }
+  std::sort(keys.begin(), keys.end());
+  for (auto key : keys) {
+    REQUIRE(heap.pop().first == key);
+  }
+}
@@ -0,0 +1,81 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/all_pairs_shortest_path.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/shortest_path.hpp"
+#include <limits>
+#include <random>
+#include <vector>
+
+TEST_CASE("johnson basic", "[graph][all_pairs_shortest_path]") {
+  dragon::Graph<int, int> graph(5, 0);
+  graph.add_directed_edge(0, 1, 4);
+  graph.add_directed_edge(0, 2, 1);
+  graph.add_directed_edge(2, 1, -2);
+  graph.add_directed_edge(1, 3, 3);
+  graph.add_directed_edge(3, 2, 2);
+
+  dragon::ThreadPool pool(2);
+  std::vector<int> distances;
+  REQUIRE(dragon::johnson(graph, distances, pool));
+  const int inf = std::numeric_limits<int>::max();
+  std::vector<int> expected{0,   -1,  1,   2,   inf, // from 0
+                            inf, 0,   5,   3,   inf, // from 1
+                            inf, -2,  0,   1,   inf, // from 2
+                            inf, 0,   2,   0,   inf, // from 3
+                            inf, inf, inf, inf, 0};
+  REQUIRE(distances == expected);
+}
+
+TEST_CASE("johnson negative cycle", "[graph][all_pairs_shortest_path]") {
+  dragon::Graph<int, int> graph(4, 0);
+  graph.add_directed_edge(0, 1, 1);
+  graph.add_directed_edge(1, 2, -3);
+  graph.add_directed_edge(2, 1, 1);
+  graph.add_directed_edge(2, 3, 1);
+
+  dragon::ThreadPool pool(2);
+  std::vector<int> distances{1, 2, 3};
+  std::vector<std::size_t> cycle;
+  REQUIRE_FALSE(dragon::johnson(graph, distances, cycle, pool));
+  REQUIRE(distances.empty());
+  REQUIRE(cycle.size() == 2);
+  int weight = 0;
+  for (std::size_t i = 0; i < cycle.size(); ++i) {
+    weight += graph[cycle[i]].edges.at(cycle[(i + 1) % cycle.size()]);
+  }
+  REQUIRE(weight < 0);
+}
+
+TEST_CASE("johnson random", "[graph][all_pairs_shortest_path]") {
+  std::mt19937 rng(31);
+  const std::size_t sz = 150;
+  // Weights derived from node potentials keep negative edges without
+  // creating negative cycles.
+  std::vector<long long> height(sz);
+  for (auto& h : height) {
+    h = rng() % 50;
+  }
+  std::vector<dragon::CSRGraph<int, long long>::Edge> edges;
+  for (std::size_t i = 0; i + 1 < sz; ++i) {
+    edges.push_back({i, i + 1, 10 + height[i + 1] - height[i]});
+  }
+  for (auto i = 0U; i < 4 * sz; ++i) {
+    std::size_t u = rng() % sz, v = rng() % sz;
+    auto w = static_cast<long long>(rng() % 20) + height[v] - height[u];
+    edges.push_back({u, v, w});
+  }
+  dragon::CSRGraph<int, long long> graph(sz, edges);
+
+  for (std::size_t threads : {1, 3}) {
+    dragon::ThreadPool pool(threads);
+    std::vector<long long> distances;
+    REQUIRE(dragon::johnson(graph, distances, pool));
+    REQUIRE(distances.size() == sz * sz);
+    for (std::size_t u_i = 0; u_i < sz; ++u_i) {
+      std::vector<long long> expected;
+      REQUIRE(dragon::spfa(graph, expected, u_i));
+      REQUIRE(std::equal(expected.begin(), expected.end(),
+                         distances.begin() + u_i * sz));
+    }
+  }
+}
@@ -0,0 +1,74 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/batched_shortest_path.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/shortest_path.hpp"
+#include <mutex>
+#include <random>
+#include <vector>
+
+TEST_CASE("batched djikstra matrix", "[graph][batched_shortest_path]") {
+  dragon::Graph<int, int> graph(7, 0);
+  graph.add_directed_edge(0, 1, 1);
+  graph.add_directed_edge(0, 3, 2);
+  graph.add_directed_edge(1, 2, 4);
+  graph.add_directed_edge(2, 3, 8);
+  graph.add_directed_edge(3, 4, 5);
+  graph.add_directed_edge(4, 5, 7);
+  graph.add_directed_edge(5, 3, 6);
+
+  dragon::ThreadPool pool(3);
+  std::vector<std::size_t> sources{0, 1, 2, 3, 4, 5, 6, 0};
+  std::vector<int> matrix(sources.size() * graph.size(), -1);
+  dragon::batched_djikstra(graph, sources, matrix.data(), pool);
+  for (std::size_t i = 0; i < sources.size(); ++i) {
+    std::vector<int> row(matrix.begin() + i * graph.size(),
+                         matrix.begin() + (i + 1) * graph.size());
+    REQUIRE(row == dragon::djikstra(graph, sources[i]));
+  }
+}
+
+TEST_CASE("batched djikstra random", "[graph][batched_shortest_path]") {
+  std::mt19937 rng(23);
+  const std::size_t sz = 500;
+  std::vector<dragon::CSRGraph<int, long long>::Edge> edges;
+  for (auto i = 0U; i < 4 * sz; ++i) {
+    std::size_t u = rng() % sz, v = rng() % sz;
+    edges.push_back({u, v, static_cast<long long>(rng() % 100)});
+  }
+  dragon::CSRGraph<int, long long> graph(sz, edges);
+  std::vector<std::size_t> sources;
+  for (auto i = 0U; i < 64; ++i) {
+    sources.push_back(rng() % sz);
+  }
+  std::vector<std::vector<long long>> expected;
+  for (auto source : sources) {
+    expected.push_back(dragon::djikstra(graph, source));
+  }
+
+  for (std::size_t threads : {1, 4}) {
+    dragon::ThreadPool pool(threads);
+    std::vector<long long> matrix(sources.size() * sz);
+    dragon::batched_djikstra(graph, sources, matrix.data(), pool);
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+      REQUIRE(std::equal(expected[i].begin(), expected[i].end(),
+                         matrix.begin() + i * sz));
+    }
+
+    std::vector<std::vector<long long>> streamed(sources.size());
+    std::vector<std::size_t> calls(pool.size(), 0);
+    dragon::batched_djikstra(
+        graph, sources,
+        [&](std::size_t i, const std::vector<long long>& dist,
+            std::size_t thread_index) {
+          streamed[i] = dist;
+          ++calls[thread_index];
+        },
+        pool);
+    REQUIRE(streamed == expected);
+    std::size_t total = 0;
+    for (auto c : calls) {
+      total += c;
+    }
+    REQUIRE(total == sources.size());
+  }
+}
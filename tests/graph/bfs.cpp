@@ -0,0 +1,108 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/bfs.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace {
+template <typename GraphT>
+std::vector<std::size_t> serial_bfs(const GraphT& graph, std::size_t source) {
+  const auto npos = dragon::BreadthFirstSearch<GraphT>::npos;
+  std::vector<std::size_t> depth(graph.size(), npos);
+  std::queue<std::size_t> queue;
+  depth[source] = 0;
+  queue.push(source);
+  while (!queue.empty()) {
+    auto u_i = queue.front();
+    queue.pop();
+    for (auto edge : graph[u_i].edges) {
+      if (depth[edge.first] == npos) {
+        depth[edge.first] = depth[u_i] + 1;
+        queue.push(edge.first);
+      }
+    }
+  }
+  return depth;
+}
+
+template <typename GraphT>
+void check(const GraphT& graph, dragon::BreadthFirstSearch<GraphT>& search,
+           std::size_t source) {
+  const auto npos = dragon::BreadthFirstSearch<GraphT>::npos;
+  auto expected = serial_bfs(graph, source);
+  search.run(source);
+  std::size_t reached = 0;
+  for (std::size_t v_i = 0; v_i < graph.size(); ++v_i) {
+    REQUIRE(search.depth(v_i) == expected[v_i]);
+    auto u_i = search.parent(v_i);
+    if (v_i == source || expected[v_i] == npos) {
+      REQUIRE(u_i == npos);
+    } else {
+      REQUIRE(graph[u_i].edges.count(v_i) == 1);
+      REQUIRE(expected[u_i] + 1 == expected[v_i]);
+    }
+    reached += expected[v_i] != npos;
+  }
+  REQUIRE(search.num_of_reached() == reached);
+}
+} // namespace
+
+TEST_CASE("bfs basic", "[graph][bfs]") {
+  dragon::Graph<int, int> graph(6, 0);
+  graph.add_directed_edge(0, 1);
+  graph.add_directed_edge(0, 2);
+  graph.add_directed_edge(1, 3);
+  graph.add_directed_edge(2, 3);
+  graph.add_directed_edge(3, 0);
+  graph.add_directed_edge(5, 4);
+
+  dragon::ThreadPool pool(2);
+  std::vector<std::size_t> parent;
+  auto depth = dragon::bfs(graph, parent, pool);
+  const auto npos = dragon::Graph<int, int>::npos;
+  REQUIRE(depth == std::vector<std::size_t>{0, 1, 1, 2, npos, npos});
+  REQUIRE(parent[0] == npos);
+  REQUIRE(parent[1] == 0);
+  REQUIRE(parent[2] == 0);
+  REQUIRE((parent[3] == 1 || parent[3] == 2));
+  REQUIRE(parent[4] == npos);
+
+  depth = dragon::bfs(graph, parent, pool, 5);
+  REQUIRE(depth == std::vector<std::size_t>{npos, npos, npos, npos, 1, 0});
+  REQUIRE(parent[4] == 5);
+}
+
+TEST_CASE("bfs random", "[graph][bfs]") {
+  std::mt19937 rng(41);
+  const std::size_t sz = 3000;
+  // Hub heavy edges make the middle levels huge, which triggers bottom-up
+  // steps; a long tail brings top-down steps back.
+  std::vector<dragon::CSRGraph<int, int>::Edge> edges;
+  dragon::Graph<int, int> graph(sz, 0);
+  auto add = [&](std::size_t u, std::size_t v) {
+    edges.push_back({u, v, 1});
+    graph.add_directed_edge(u, v);
+  };
+  for (auto i = 0U; i < 20 * sz; ++i) {
+    add(rng() % (sz / 2), rng() % (sz / 2));
+  }
+  for (std::size_t i = sz / 2; i + 1 < sz - 10; ++i) {
+    add(i, i + 1);
+  }
+  add(0, sz / 2);
+  dragon::CSRGraph<int, int> csr_graph(sz, edges);
+
+  for (std::size_t threads : {1, 4}) {
+    dragon::ThreadPool pool(threads);
+    dragon::BreadthFirstSearch<dragon::CSRGraph<int, int>> csr_search(csr_graph,
+                                                                     pool);
+    dragon::BreadthFirstSearch<dragon::Graph<int, int>> search(graph, pool);
+    for (std::size_t source : {0, 7, 1600, 2995}) {
+      check(csr_graph, csr_search, source);
+      check(graph, search, source);
+    }
+    csr_search.run(0);
+    REQUIRE(csr_search.num_of_bottom_up_steps() > 0);
+  }
+}
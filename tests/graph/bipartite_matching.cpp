@@ -0,0 +1,88 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/bipartite_matching.hpp"
+#include "dragon/graph/max_flow.hpp"
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+TEST_CASE("hopcroft karp basic", "[graph][bipartite_matching]") {
+  // Greedy matches left 0 with right 0 and left 2 with right 1, the only
+  // augmenting path then goes through both pairs.
+  std::vector<std::pair<std::size_t, std::size_t>> edges = {
+      {0, 0}, {0, 1}, {1, 0}, {2, 1}, {2, 2}};
+  std::vector<std::size_t> left_mate, right_mate;
+  // Node counts given as literals, the index type comes from `edges`.
+  REQUIRE(dragon::hopcroft_karp(3, 3, edges, left_mate, right_mate) == 3);
+  REQUIRE(left_mate == std::vector<std::size_t>{1, 0, 2});
+  REQUIRE(right_mate == std::vector<std::size_t>{1, 0, 2});
+
+  REQUIRE(dragon::hopcroft_karp<std::size_t>(0, 0, {}, left_mate,
+                                             right_mate) == 0);
+  REQUIRE(dragon::hopcroft_karp<std::size_t>(2, 3, {}, left_mate,
+                                             right_mate) == 0);
+  REQUIRE(left_mate == std::vector<std::size_t>(2, dragon::Graph<int>::npos));
+}
+
+TEST_CASE("hopcroft karp graph", "[graph][bipartite_matching]") {
+  // Even cycle 0 - 1 - 2 - 3 - 4 - 5 - 0, and an isolated node 6.
+  dragon::Graph<int> graph(7, 0);
+  for (std::size_t v_i = 0; v_i < 6; ++v_i) {
+    graph.add_undirected_edge(v_i, (v_i + 1) % 6);
+  }
+  std::vector<bool> left;
+  REQUIRE(dragon::bipartition(graph, left));
+  REQUIRE(left ==
+          std::vector<bool>{true, false, true, false, true, false, true});
+  std::vector<std::size_t> mate;
+  REQUIRE(dragon::hopcroft_karp(graph, left, mate) == 3);
+  for (std::size_t v_i = 0; v_i < 6; ++v_i) {
+    REQUIRE(mate[v_i] != graph.npos);
+    REQUIRE(mate[mate[v_i]] == v_i);
+    REQUIRE(graph[v_i].edges.count(mate[v_i]) == 1);
+  }
+  REQUIRE(mate[6] == graph.npos);
+
+  // Odd cycle.
+  graph.add_undirected_edge(0, 2);
+  REQUIRE_FALSE(dragon::bipartition(graph, left));
+}
+
+TEST_CASE("hopcroft karp random", "[graph][bipartite_matching]") {
+  std::mt19937 rng(61);
+  for (int round = 0; round < 30; ++round) {
+    const std::size_t num_of_left = rng() % 80, num_of_right = rng() % 80;
+    const std::size_t num_of_edges =
+        num_of_left == 0 || num_of_right == 0 ? 0 : rng() % (4 * num_of_left);
+    std::vector<std::pair<std::size_t, std::size_t>> edges;
+    std::set<std::pair<std::size_t, std::size_t>> edge_set;
+    dragon::FlowNetwork<int> network(num_of_left + num_of_right + 2);
+    const std::size_t source = num_of_left + num_of_right, sink = source + 1;
+    for (std::size_t e = 0; e < num_of_edges; ++e) {
+      edges.emplace_back(rng() % num_of_left, rng() % num_of_right);
+      edge_set.insert(edges.back());
+      network.add_edge(edges.back().first, num_of_left + edges.back().second,
+                       1);
+    }
+    for (std::size_t l = 0; l < num_of_left; ++l) {
+      network.add_edge(source, l, 1);
+    }
+    for (std::size_t r = 0; r < num_of_right; ++r) {
+      network.add_edge(num_of_left + r, sink, 1);
+    }
+
+    std::vector<std::size_t> left_mate, right_mate;
+    std::size_t matched = dragon::hopcroft_karp(num_of_left, num_of_right,
+                                                edges, left_mate, right_mate);
+    REQUIRE(matched == static_cast<std::size_t>(network.dinic(source, sink)));
+    std::size_t count = 0;
+    for (std::size_t l = 0; l < num_of_left; ++l) {
+      if (left_mate[l] == dragon::Graph<int>::npos)
+        continue;
+      ++count;
+      REQUIRE(edge_set.count({l, left_mate[l]}) == 1);
+      REQUIRE(right_mate[left_mate[l]] == l);
+    }
+    REQUIRE(count == matched);
+  }
+}
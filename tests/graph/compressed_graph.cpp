@@ -0,0 +1,105 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/bfs.hpp"
+#include "dragon/graph/compressed_graph.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/reordering.hpp"
+#include "dragon/graph/shortest_path.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+TEST_CASE("varint encoding", "[graph][compressed_graph]") {
+  std::vector<std::uint64_t> values = {0,          1,   127, 128, 300,
+                                       1ULL << 35, ~0ULL};
+  std::vector<std::uint8_t> bytes;
+  for (auto value : values) {
+    dragon::details::varint_write(bytes, value);
+  }
+  REQUIRE(bytes.size() == 1 + 1 + 1 + 2 + 2 + 6 + 10);
+  const std::uint8_t* data = bytes.data();
+  for (auto value : values) {
+    REQUIRE(dragon::details::varint_read(data) == value);
+  }
+  REQUIRE(data == bytes.data() + bytes.size());
+
+  for (std::int64_t value : {0LL, -1LL, 1LL, -64LL, 63LL, -(1LL << 40)}) {
+    REQUIRE(dragon::details::zigzag_decode(
+                dragon::details::zigzag_encode(value)) == value);
+  }
+  REQUIRE(dragon::details::zigzag_encode(-1) == 1);
+  REQUIRE(dragon::details::zigzag_encode(1) == 2);
+}
+
+TEST_CASE("compressed graph basic", "[graph][compressed_graph]") {
+  dragon::Graph<int, int> graph(6, 2);
+  for (int i = 0; i < 6; ++i)
+    graph[i].value = 10 * i;
+  graph.add_directed_edge(0, 3, 2);
+  graph.add_directed_edge(0, 1, 1);
+  graph.add_directed_edge(1, 2, -4);
+  graph.add_directed_edge(2, 3, 8);
+  graph.add_directed_edge(3, 4, 5);
+  graph.add_directed_edge(4, 5, 700);
+  // First targets below their source are stored as negative gaps.
+  graph.add_directed_edge(5, 0, 6);
+  graph.add_directed_edge(5, 3, -600);
+
+  dragon::CompressedGraph<int, int> compressed(graph);
+
+  REQUIRE(compressed.size() == 6);
+  REQUIRE(compressed.num_edges() == 8);
+  REQUIRE(compressed.root() == 2);
+  REQUIRE(compressed[4].value == 40);
+  REQUIRE(compressed.degree(0) == 2);
+  REQUIRE(compressed[0].edges.begin()->first == 1);
+  REQUIRE(compressed[0].edges.at(3) == 2);
+  REQUIRE(compressed[0].edges.count(2) == 0);
+  REQUIRE_THROWS_AS(compressed[0].edges.at(2), std::out_of_range);
+  REQUIRE(compressed[5].edges.at(3) == -600);
+  for (const auto& u : compressed) {
+    const auto& edges = graph[u.index()].edges;
+    REQUIRE(u.edges.size() == edges.size());
+    REQUIRE(std::equal(u.edges.begin(), u.edges.end(), edges.begin(),
+                       [](const auto& a, const auto& b) {
+                         return a.first == b.first && a.second == b.second;
+                       }));
+  }
+
+  REQUIRE(dragon::CompressedGraph<int, int>(3).degree(1) == 0);
+  REQUIRE(dragon::CompressedGraph<int, int>(3).num_edges() == 0);
+}
+
+TEST_CASE("compressed graph floating point weights",
+          "[graph][compressed_graph]") {
+  dragon::Graph<int, double> graph(3);
+  graph.add_undirected_edge(0, 2, 0.25);
+  graph.add_undirected_edge(1, 2, -1.5);
+  dragon::CompressedGraph<int, double> compressed(graph);
+
+  REQUIRE(compressed[2].edges.at(0) == 0.25);
+  REQUIRE(compressed[2].edges.at(1) == -1.5);
+  REQUIRE(compressed[1].edges.begin()->second == -1.5);
+}
+
+TEST_CASE("compressed graph traversals", "[graph][compressed_graph]") {
+  std::mt19937 rng(29);
+  const std::size_t sz = 500;
+  std::uniform_int_distribution<std::size_t> node(0, sz - 1);
+  std::uniform_int_distribution<int> weight(1, 1000);
+  dragon::Graph<int> graph(sz);
+  for (std::size_t i = 0; i < 4 * sz; ++i) {
+    graph.add_directed_edge(node(rng), node(rng), weight(rng));
+  }
+  dragon::CSRGraph<int> csr_graph(graph);
+  dragon::CompressedGraph<int> compressed(csr_graph);
+  REQUIRE(compressed.num_edges() == csr_graph.num_edges());
+  REQUIRE(compressed.num_bytes() <
+          csr_graph.num_edges() * (sizeof(std::size_t) + sizeof(int)));
+
+  REQUIRE(dragon::djikstra(compressed) == dragon::djikstra(csr_graph));
+  std::vector<std::size_t> parent;
+  REQUIRE(dragon::bfs(compressed, parent) == dragon::bfs(csr_graph, parent));
+  REQUIRE(dragon::vertex_order(compressed, dragon::VertexOrder::dfs) ==
+          dragon::vertex_order(csr_graph, dragon::VertexOrder::dfs));
+}
@@ -0,0 +1,84 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/connected_components.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+/// Labels by repeated depth first searches, numbered by smallest node.
+template <typename GraphT>
+std::vector<std::size_t> serial_components(const GraphT& graph) {
+  const auto npos = GraphT::npos;
+  std::vector<std::size_t> component(graph.size(), npos), stack;
+  std::size_t next = 0;
+  for (std::size_t s = 0; s < graph.size(); ++s) {
+    if (component[s] != npos)
+      continue;
+    component[s] = next;
+    stack.push_back(s);
+    while (!stack.empty()) {
+      auto u_i = stack.back();
+      stack.pop_back();
+      for (auto edge : graph[u_i].edges) {
+        if (component[edge.first] == npos) {
+          component[edge.first] = next;
+          stack.push_back(edge.first);
+        }
+      }
+    }
+    ++next;
+  }
+  return component;
+}
+} // namespace
+
+TEST_CASE("connected components basic", "[graph][connected_components]") {
+  dragon::Graph<int, int> graph(7, 0);
+  graph.add_undirected_edge(0, 4);
+  graph.add_undirected_edge(4, 2);
+  graph.add_undirected_edge(1, 5);
+  graph.add_undirected_edge(3, 3);
+
+  dragon::ThreadPool pool(2);
+  std::vector<std::size_t> sizes;
+  auto component = dragon::connected_components(graph, sizes, pool);
+  REQUIRE(component == std::vector<std::size_t>{0, 1, 0, 2, 0, 1, 3});
+  REQUIRE(sizes == std::vector<std::size_t>{3, 2, 1, 1});
+}
+
+TEST_CASE("connected components random", "[graph][connected_components]") {
+  std::mt19937 rng(53);
+  const std::size_t sz = 5000;
+  dragon::Graph<int, int> graph(sz, 0);
+  std::vector<dragon::CSRGraph<int, int>::Edge> edges;
+  // A large component over half the nodes, many small ones elsewhere.
+  auto add = [&](std::size_t u, std::size_t v) {
+    graph.add_undirected_edge(u, v);
+    edges.push_back({u, v, 1});
+    edges.push_back({v, u, 1});
+  };
+  for (auto i = 0U; i < 3 * sz; ++i) {
+    add(rng() % (sz / 2), rng() % (sz / 2));
+  }
+  for (auto i = 0U; i < sz / 3; ++i) {
+    std::size_t u = sz / 2 + rng() % (sz / 2);
+    add(u, std::min(sz - 1, u + rng() % 4));
+  }
+  dragon::CSRGraph<int, int> csr_graph(sz, edges);
+  auto expected = serial_components(graph);
+
+  for (std::size_t threads : {1, 4}) {
+    dragon::ThreadPool pool(threads);
+    std::vector<std::size_t> sizes, csr_sizes;
+    auto component = dragon::connected_components(graph, sizes, pool);
+    REQUIRE(component == expected);
+    REQUIRE(dragon::connected_components(csr_graph, csr_sizes, pool) ==
+            expected);
+    REQUIRE(csr_sizes == sizes);
+    std::vector<std::size_t> expected_sizes(sizes.size(), 0);
+    for (auto c : expected) {
+      ++expected_sizes[c];
+    }
+    REQUIRE(sizes == expected_sizes);
+  }
+}
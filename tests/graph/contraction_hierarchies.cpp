@@ -0,0 +1,87 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/contraction_hierarchies.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/shortest_path.hpp"
+#include <random>
+#include <vector>
+
+template <typename GraphT>
+void check_queries(const GraphT& graph, std::size_t witness_settle_limit) {
+  using EdgeValueType = typename GraphT::EdgeValueType;
+  dragon::ContractionHierarchy<EdgeValueType> ch(graph, witness_settle_limit);
+  REQUIRE(ch.size() == graph.size());
+
+  for (std::size_t s = 0; s < graph.size(); s += 7) {
+    auto expected = dragon::djikstra(graph, s);
+    for (std::size_t t = 0; t < graph.size(); t += 5) {
+      REQUIRE(ch.query(s, t) == expected[t]);
+      auto nodes = ch.path();
+      if (expected[t] == ch.inf_weight) {
+        REQUIRE(nodes.empty());
+        continue;
+      }
+      REQUIRE(nodes.front() == s);
+      REQUIRE(nodes.back() == t);
+      EdgeValueType wt = 0;
+      for (auto i = 0U; i + 1 < nodes.size(); ++i) {
+        wt += graph[nodes[i]].edges.at(nodes[i + 1]);
+      }
+      REQUIRE(wt == expected[t]);
+    }
+  }
+}
+
+TEST_CASE("contraction hierarchies basic", "[graph][contraction_hierarchies]") {
+  dragon::Graph<int, int> graph(6, 0);
+  graph.add_directed_edge(0, 1, 1);
+  graph.add_directed_edge(0, 3, 2);
+  graph.add_directed_edge(1, 2, 4);
+  graph.add_directed_edge(2, 3, 8);
+  graph.add_directed_edge(3, 4, 5);
+  graph.add_directed_edge(4, 5, 7);
+  graph.add_directed_edge(5, 3, 6);
+
+  dragon::ContractionHierarchy<int> ch(graph);
+  REQUIRE(ch.query(0, 5) == 14);
+  REQUIRE(ch.path() == std::vector<std::size_t>{0, 3, 4, 5});
+  REQUIRE(ch.query(5, 0) == ch.inf_weight);
+  REQUIRE(ch.path().empty());
+  REQUIRE(ch.query(2, 2) == 0);
+  REQUIRE(ch.path() == std::vector<std::size_t>{2});
+}
+
+TEST_CASE("contraction hierarchies random",
+          "[graph][contraction_hierarchies]") {
+  std::mt19937 rng(31);
+  SECTION("sparse directed graph") {
+    const std::size_t sz = 300;
+    dragon::Graph<int, long long> graph(sz, 0);
+    for (auto i = 0U; i < 3 * sz; ++i) {
+      graph.add_directed_edge(rng() % sz, rng() % sz, rng() % 50);
+    }
+    check_queries(graph, 500);
+    // Tiny witness searches add superfluous shortcuts but stay exact.
+    check_queries(graph, 2);
+  }
+
+  SECTION("road-like grid") {
+    const std::size_t side = 20;
+    std::vector<dragon::CSRGraph<int, int>::Edge> edges;
+    for (std::size_t r = 0; r < side; ++r) {
+      for (std::size_t c = 0; c < side; ++c) {
+        std::size_t u = r * side + c;
+        int w1 = 1 + static_cast<int>(rng() % 20);
+        int w2 = 1 + static_cast<int>(rng() % 20);
+        if (c + 1 < side) {
+          edges.push_back({u, u + 1, w1});
+          edges.push_back({u + 1, u, w1});
+        }
+        if (r + 1 < side) {
+          edges.push_back({u, u + side, w2});
+          edges.push_back({u + side, u, w2});
+        }
+      }
+    }
+    check_queries(dragon::CSRGraph<int, int>(side * side, edges), 500);
+  }
+}
@@ -0,0 +1,76 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/min_spanning_tree.hpp"
+#include "dragon/graph/shortest_path.hpp"
+#include <vector>
+
+TEST_CASE("csr graph basic", "[graph][csr_graph]") {
+  dragon::Graph<int, int> graph(6, 0);
+  for (int i = 0; i < 6; ++i)
+    graph[i].value = 10 * i;
+  graph.add_directed_edge(0, 3, 2);
+  graph.add_directed_edge(0, 1, 1);
+  graph.add_directed_edge(1, 2, 4);
+  graph.add_directed_edge(2, 3, 8);
+  graph.add_directed_edge(3, 4, 5);
+  graph.add_directed_edge(4, 5, 7);
+  graph.add_directed_edge(5, 3, 6);
+
+  dragon::CSRGraph<int, int> csr_graph(graph);
+
+  REQUIRE(csr_graph.size() == 6);
+  REQUIRE(csr_graph.num_edges() == 7);
+  REQUIRE(csr_graph.root() == 0);
+  REQUIRE(csr_graph[4].value == 40);
+  REQUIRE(csr_graph[0].edges.size() == 2);
+  REQUIRE(csr_graph[0].edges.begin()->first == 1);
+  REQUIRE(csr_graph[0].edges.at(3) == 2);
+  REQUIRE(csr_graph[0].edges.count(2) == 0);
+  REQUIRE_THROWS_AS(csr_graph[0].edges.at(2), std::out_of_range);
+
+  SECTION("built from edge list") {
+    std::vector<dragon::CSRGraph<int, int>::Edge> edges = {
+        {5, 3, 6}, {0, 3, 9}, {3, 4, 5}, {1, 2, 4},
+        {2, 3, 8}, {4, 5, 7}, {0, 1, 1}, {0, 3, 2}};
+    dragon::CSRGraph<int, int> from_edges(6, edges);
+
+    REQUIRE(from_edges.offsets() == csr_graph.offsets());
+    REQUIRE(from_edges.targets() == csr_graph.targets());
+    // The last weight given for the duplicated edge 0 -> 3 wins.
+    REQUIRE(from_edges.weights() == csr_graph.weights());
+  }
+
+  SECTION("shortest path") {
+    std::vector<int> graph_wt, csr_wt;
+    REQUIRE(dragon::bellman_ford(graph, graph_wt));
+    REQUIRE(dragon::bellman_ford(csr_graph, csr_wt));
+    REQUIRE(csr_wt == graph_wt);
+    REQUIRE(dragon::djikstra(csr_graph) == dragon::djikstra(graph));
+  }
+}
+
+TEST_CASE("csr graph min spanning tree", "[graph][csr_graph]") {
+  dragon::Graph<int> graph(5);
+  graph.add_undirected_edge(0, 1, 1);
+  graph.add_undirected_edge(0, 3, 2);
+  graph.add_undirected_edge(0, 2, 10);
+  graph.add_undirected_edge(1, 2, 11);
+  graph.add_undirected_edge(1, 4, 3);
+  graph.add_undirected_edge(2, 3, 12);
+  graph.add_undirected_edge(2, 4, 13);
+  graph.add_undirected_edge(3, 4, 4);
+  dragon::CSRGraph<int> csr_graph(graph);
+
+  auto tree_weight = [](const auto& tree) {
+    int wt = 0;
+    for (const auto& node : tree) {
+      for (auto edge : node.edges) {
+        wt += edge.second;
+      }
+    }
+    return wt / 2;
+  };
+
+  REQUIRE(tree_weight(dragon::prim(csr_graph)) == 16);
+  REQUIRE(tree_weight(dragon::kruskal(csr_graph)) == 16);
+}
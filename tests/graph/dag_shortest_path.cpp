@@ -0,0 +1,82 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/dag_shortest_path.hpp"
+#include "dragon/graph/shortest_path.hpp"
+#include <limits>
+#include <random>
+#include <vector>
+
+TEST_CASE("dag shortest and longest paths", "[graph][dag_shortest_path]") {
+  dragon::Graph<int, int> graph(6, 0);
+  graph.add_directed_edge(0, 1, 5);
+  graph.add_directed_edge(0, 2, 3);
+  graph.add_directed_edge(1, 3, 6);
+  graph.add_directed_edge(1, 2, 2);
+  graph.add_directed_edge(2, 4, 4);
+  graph.add_directed_edge(2, 5, 2);
+  graph.add_directed_edge(2, 3, 7);
+  graph.add_directed_edge(3, 4, -1);
+  graph.add_directed_edge(4, 5, -2);
+
+  const auto npos = dragon::Graph<int, int>::npos;
+  std::vector<int> dist;
+  std::vector<std::size_t> parent;
+  REQUIRE(dragon::dag_shortest_paths(graph, dist, parent));
+  REQUIRE(dist == std::vector<int>{0, 5, 3, 10, 7, 5});
+  REQUIRE(parent == std::vector<std::size_t>{npos, 0, 0, 2, 2, 2});
+
+  REQUIRE(dragon::dag_shortest_paths(graph, dist, parent, 1));
+  const int inf = std::numeric_limits<int>::max();
+  REQUIRE(dist == std::vector<int>{inf, 0, 2, 6, 5, 3});
+
+  REQUIRE(dragon::dag_longest_paths(graph, dist, parent));
+  REQUIRE(dist == std::vector<int>{0, 5, 7, 14, 13, 11});
+  REQUIRE(parent == std::vector<std::size_t>{npos, 0, 1, 2, 3, 4});
+
+  std::vector<std::size_t> path;
+  int length = 0;
+  REQUIRE(dragon::critical_path(graph, path, length));
+  REQUIRE(length == 14);
+  REQUIRE(path == std::vector<std::size_t>{0, 1, 2, 3});
+
+  graph.add_directed_edge(5, 1, 1);
+  REQUIRE_FALSE(dragon::dag_shortest_paths(graph, dist, parent));
+  REQUIRE_FALSE(dragon::dag_longest_paths(graph, dist, parent));
+  REQUIRE_FALSE(dragon::critical_path(graph, path, length));
+  REQUIRE(length == 14);
+}
+
+TEST_CASE("dag shortest paths random", "[graph][dag_shortest_path]") {
+  std::mt19937 rng(73);
+  const std::size_t sz = 500;
+  dragon::Graph<int, long long> graph(sz, 0);
+  for (std::size_t i = 0; i + 1 < sz; ++i) {
+    graph.add_directed_edge(i, i + 1, 50);
+  }
+  for (auto i = 0U; i < 4 * sz; ++i) {
+    std::size_t a = rng() % sz, b = rng() % sz;
+    if (a < b)
+      graph.add_directed_edge(a, b, static_cast<long long>(rng() % 100) - 20);
+  }
+  std::vector<long long> dist, expected;
+  std::vector<std::size_t> parent;
+  REQUIRE(dragon::dag_shortest_paths(graph, dist, parent));
+  REQUIRE(dragon::spfa(graph, expected));
+  REQUIRE(dist == expected);
+  for (std::size_t v_i = 1; v_i < sz; ++v_i) {
+    REQUIRE(dist[parent[v_i]] + graph[parent[v_i]].edges.at(v_i) ==
+            dist[v_i]);
+  }
+
+  // Longest paths are shortest paths of the negated graph.
+  dragon::Graph<int, long long> negated(sz, 0);
+  for (const auto& u : graph) {
+    for (auto edge : u.edges) {
+      negated.add_directed_edge(u.index(), edge.first, -edge.second);
+    }
+  }
+  REQUIRE(dragon::dag_longest_paths(graph, dist, parent));
+  REQUIRE(dragon::spfa(negated, expected));
+  for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+    REQUIRE(dist[v_i] == -expected[v_i]);
+  }
+}
@@ -0,0 +1,67 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/delta_stepping.hpp"
+#include "dragon/graph/shortest_path.hpp"
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("delta stepping basic", "[graph][delta_stepping]") {
+  dragon::Graph<int, int> graph(7, 0);
+  graph.add_directed_edge(0, 1, 1);
+  graph.add_directed_edge(0, 3, 2);
+  graph.add_directed_edge(1, 2, 4);
+  graph.add_directed_edge(2, 3, 8);
+  graph.add_directed_edge(3, 4, 5);
+  graph.add_directed_edge(4, 5, 7);
+  graph.add_directed_edge(5, 3, 6);
+
+  dragon::ThreadPool pool(2);
+  auto expected = dragon::djikstra(graph);
+  for (int delta : {1, 3, 100}) {
+    REQUIRE(dragon::delta_stepping(graph, delta, pool) == expected);
+  }
+  // Node 6 is unreachable.
+  REQUIRE(expected[6] == std::numeric_limits<int>::max());
+  REQUIRE_THROWS_AS(dragon::delta_stepping(graph, 0, pool),
+                    std::invalid_argument);
+}
+
+TEST_CASE("delta stepping sparse buckets", "[graph][delta_stepping]") {
+  // Distances span a billion buckets of width 1, nearly all of them empty.
+  dragon::Graph<int, int> graph(4, 0);
+  graph.add_directed_edge(0, 1, 1000000000);
+  graph.add_directed_edge(0, 2, 3);
+  graph.add_directed_edge(2, 1, 999999990);
+  graph.add_directed_edge(1, 3, 1);
+
+  dragon::ThreadPool pool(2);
+  REQUIRE(dragon::delta_stepping(graph, 1, pool) ==
+          std::vector<int>{0, 999999993, 3, 999999994});
+}
+
+TEST_CASE("delta stepping random", "[graph][delta_stepping]") {
+  std::mt19937 rng(17);
+  const std::size_t sz = 2000;
+  std::vector<dragon::CSRGraph<int, long long>::Edge> int_edges;
+  std::vector<dragon::CSRGraph<int, double>::Edge> real_edges;
+  for (auto i = 0U; i < 5 * sz; ++i) {
+    std::size_t u = rng() % sz, v = rng() % sz;
+    auto w = rng() % 1000;
+    int_edges.push_back({u, v, static_cast<long long>(w)});
+    real_edges.push_back({u, v, w / 7.0});
+  }
+  dragon::CSRGraph<int, long long> int_graph(sz, int_edges);
+  dragon::CSRGraph<int, double> real_graph(sz, real_edges);
+  auto int_expected = dragon::djikstra(int_graph);
+  auto real_expected = dragon::djikstra(real_graph);
+
+  for (std::size_t threads : {1, 4}) {
+    dragon::ThreadPool pool(threads);
+    REQUIRE(dragon::delta_stepping(int_graph, 1LL, pool) == int_expected);
+    REQUIRE(dragon::delta_stepping(int_graph, 250LL, pool) == int_expected);
+    REQUIRE(dragon::delta_stepping(int_graph, 5000LL, pool, 9) ==
+            dragon::djikstra(int_graph, 9));
+    REQUIRE(dragon::delta_stepping(real_graph, 20.0, pool) == real_expected);
+  }
+}
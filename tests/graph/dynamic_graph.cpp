@@ -0,0 +1,133 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/dynamic_graph.hpp"
+#include "dragon/graph/graph.hpp"
+#include "dragon/graph/shortest_path.hpp"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+template <typename GraphT>
+std::vector<std::map<std::size_t, int>> adjacency(const GraphT& graph) {
+  std::vector<std::map<std::size_t, int>> edges(graph.size());
+  for (const auto& u : graph) {
+    edges[u.index()].insert(u.edges.begin(), u.edges.end());
+  }
+  return edges;
+}
+} // namespace
+
+TEST_CASE("dynamic graph basic", "[graph][dynamic_graph]") {
+  dragon::DynamicGraph<int> graph(5, 1);
+  graph[3].value = 30;
+  graph.add_directed_edge(0, 1, 4);
+  graph.add_undirected_edge(1, 2, 7);
+  graph.add_directed_edge(0, 1, 5);
+  graph.add_directed_edge(0, 3);
+
+  REQUIRE(graph.size() == 5);
+  REQUIRE(graph.root() == 1);
+  REQUIRE(graph[3].value == 30);
+  REQUIRE(graph.num_edges() == 4);
+  REQUIRE(graph[0].edges.size() == 2);
+  REQUIRE(graph[0].edges.at(1) == 5);
+  REQUIRE(graph[0].edges.at(3) == 1);
+  REQUIRE(graph[2].edges.find(1)->second == 7);
+  REQUIRE(graph[2].edges.count(0) == 0);
+  REQUIRE_THROWS_AS(graph[2].edges.at(0), std::out_of_range);
+
+  graph.remove_undirected_edge(1, 2);
+  graph.remove_directed_edge(0, 4);
+  REQUIRE(graph.num_edges() == 2);
+  REQUIRE(graph[1].edges.empty());
+  REQUIRE(graph[2].edges.empty());
+
+  graph.clear();
+  REQUIRE(graph.size() == 0);
+  REQUIRE(graph.num_edges() == 0);
+}
+
+TEST_CASE("dynamic graph churn", "[graph][dynamic_graph]") {
+  // Few nodes, so rows grow past the linear scan limit and shrink back.
+  std::mt19937 rng(41);
+  const std::size_t sz = 8;
+  std::uniform_int_distribution<std::size_t> node(0, sz - 1);
+  std::uniform_int_distribution<std::size_t> target(0, 200);
+  std::uniform_int_distribution<int> weight(1, 100);
+  dragon::Graph<int> graph(201);
+  dragon::DynamicGraph<int> dynamic(201);
+  for (int i = 0; i < 20000; ++i) {
+    const std::size_t u_i = node(rng), v_i = target(rng);
+    // Insertions dominate early, deletions late.
+    if (std::uniform_int_distribution<int>(0, 20000)(rng) > i) {
+      const int w = weight(rng);
+      graph.add_directed_edge(u_i, v_i, w);
+      dynamic.add_directed_edge(u_i, v_i, w);
+    } else {
+      graph.remove_directed_edge(u_i, v_i);
+      dynamic.remove_directed_edge(u_i, v_i);
+    }
+    if (i % 1000 == 0) {
+      REQUIRE(adjacency(dynamic) == adjacency(graph));
+    }
+  }
+  REQUIRE(adjacency(dynamic) == adjacency(graph));
+  std::size_t num_of_edges = 0;
+  for (const auto& u : graph) {
+    num_of_edges += u.edges.size();
+    for (auto edge : u.edges) {
+      REQUIRE(dynamic[u.index()].edges.at(edge.first) == edge.second);
+    }
+  }
+  REQUIRE(dynamic.num_edges() == num_of_edges);
+}
+
+TEST_CASE("dynamic graph batched updates", "[graph][dynamic_graph]") {
+  using Update = dragon::DynamicGraph<int>::EdgeUpdate;
+  std::mt19937 rng(43);
+  const std::size_t sz = 300;
+  std::uniform_int_distribution<std::size_t> node(0, sz - 1);
+  std::uniform_int_distribution<int> weight(1, 100);
+  dragon::DynamicGraph<int> sequential(sz), batched(sz);
+  dragon::ThreadPool pool(4);
+  for (int batch = 0; batch < 5; ++batch) {
+    std::vector<Update> updates;
+    for (int i = 0; i < 4000; ++i) {
+      // Half of the sources are hubs, to get long runs.
+      std::size_t u_i = i % 2 ? node(rng) : node(rng) % 4;
+      updates.push_back({u_i, node(rng) % 60, weight(rng), i % 3 == 0});
+    }
+    std::stable_sort(updates.begin(), updates.end(),
+                     [](const Update& a, const Update& b) {
+                       return a.from < b.from;
+                     });
+    for (const auto& update : updates) {
+      if (update.remove)
+        sequential.remove_directed_edge(update.from, update.to);
+      else
+        sequential.add_directed_edge(update.from, update.to, update.weight);
+    }
+    batched.apply_updates(updates, pool);
+    REQUIRE(adjacency(batched) == adjacency(sequential));
+    REQUIRE(batched.num_edges() == sequential.num_edges());
+  }
+  batched.apply_updates({});
+  REQUIRE(batched.num_edges() == sequential.num_edges());
+}
+
+TEST_CASE("dynamic graph shortest path", "[graph][dynamic_graph]") {
+  std::mt19937 rng(47);
+  const std::size_t sz = 400;
+  std::uniform_int_distribution<std::size_t> node(0, sz - 1);
+  std::uniform_int_distribution<int> weight(1, 1000);
+  dragon::Graph<int> graph(sz);
+  dragon::DynamicGraph<int> dynamic(sz);
+  for (std::size_t i = 0; i < 6 * sz; ++i) {
+    const std::size_t u_i = node(rng), v_i = node(rng);
+    const int w = weight(rng);
+    graph.add_undirected_edge(u_i, v_i, w);
+    dynamic.add_undirected_edge(u_i, v_i, w);
+  }
+  REQUIRE(dragon::djikstra(dynamic) == dragon::djikstra(graph));
+}
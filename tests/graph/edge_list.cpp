@@ -0,0 +1,148 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/edge_list.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <locale>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("parse edge list", "[graph][edge_list]") {
+  dragon::ThreadPool pool(3);
+  const std::string text = "# comment\n"
+                           "0 1 5\n"
+                           "\n"
+                           "  2\t0 -3 extra columns\r\n"
+                           "% other comment\n"
+                           "1 2\n"
+                           "0 1 7";
+  dragon::EdgeList<int> edges;
+  REQUIRE(dragon::parse_edge_list(text.data(), text.data() + text.size(),
+                                  edges, pool));
+  REQUIRE(edges.size() == 4);
+  REQUIRE(edges.num_of_nodes == 3);
+  REQUIRE(edges.sources == std::vector<std::size_t>{0, 2, 1, 0});
+  REQUIRE(edges.targets == std::vector<std::size_t>{1, 0, 2, 1});
+  REQUIRE(edges.weights == std::vector<int>{5, -3, 1, 7});
+
+  auto csr_graph = dragon::build_csr_graph<int>(edges, pool);
+  REQUIRE(csr_graph.size() == 3);
+  REQUIRE(csr_graph.num_edges() == 3);
+  REQUIRE(csr_graph[0].edges.at(1) == 7);
+  auto graph = dragon::build_graph<int>(edges, pool, 5, 2);
+  REQUIRE(graph.size() == 5);
+  REQUIRE(graph.root() == 2);
+  REQUIRE(graph[0].edges.at(1) == 7);
+  REQUIRE(graph[2].edges.at(0) == -3);
+
+  dragon::EdgeList<double> real_edges;
+  const std::string reals = "0 1 2.5\n1 0 -1e-3\n2 2 .25E+2\n3 0 7\n";
+  REQUIRE(dragon::parse_edge_list(reals.data(), reals.data() + reals.size(),
+                                  real_edges, pool));
+  REQUIRE(real_edges.weights == std::vector<double>{2.5, -0.001, 25.0, 7.0});
+
+  for (const std::string bad : {"0\n", "0 x 1\n", "1 2 3x\n", "a 1\n",
+                                "0 1 e5\n"}) {
+    REQUIRE_FALSE(dragon::parse_edge_list(bad.data(), bad.data() + bad.size(),
+                                          real_edges, pool));
+  }
+
+  dragon::EdgeList<int> empty;
+  REQUIRE(dragon::parse_edge_list(text.data(), text.data(), empty, pool));
+  REQUIRE(empty.size() == 0);
+  REQUIRE(empty.num_of_nodes == 0);
+}
+
+TEST_CASE("parse edge list limits", "[graph][edge_list]") {
+  dragon::ThreadPool pool(2);
+  auto parse = [&](const std::string& text, auto& edges) {
+    return dragon::parse_edge_list(text.data(), text.data() + text.size(),
+                                   edges, pool);
+  };
+
+  // Indices and integral weights that do not fit are malformed.
+  dragon::EdgeList<int> int_edges;
+  for (const std::string bad :
+       {"0 99999999999999999999999 5\n", "18446744073709551615 0\n",
+        "0 1 2147483648\n", "0 1 -2147483649\n",
+        "0 1 99999999999999999999\n"}) {
+    REQUIRE_FALSE(parse(bad, int_edges));
+  }
+  REQUIRE(parse("18446744073709551614 0 -2147483648\n0 1 2147483647\n",
+                int_edges));
+  REQUIRE(int_edges.weights == std::vector<int>{-2147483648, 2147483647});
+  dragon::EdgeList<unsigned> unsigned_edges;
+  REQUIRE_FALSE(parse("0 1 -1\n", unsigned_edges));
+  REQUIRE(parse("0 1 -0\n0 1 4294967295\n", unsigned_edges));
+  REQUIRE(unsigned_edges.weights == std::vector<unsigned>{0, 4294967295U});
+
+  // Floating point weights round like std::strtod in the C locale.
+  const std::vector<std::string> reals = {
+      "0e400", "-0", "0.1", "1e-320", "4.9e-324", "1.7976931348623157e308",
+      "0.0000000000000000000000001", "123456789012345678901234567890",
+      "1234567890123456789012345", "-1.5e30", ".5e-30", "9007199254740993",
+      "3.14159e-5"};
+  std::string text;
+  for (const auto& real : reals) {
+    text += "0 1 " + real + "\n";
+  }
+  dragon::EdgeList<double> real_edges;
+  REQUIRE(parse(text, real_edges));
+  REQUIRE(real_edges.size() == reals.size());
+  for (std::size_t e = 0; e < reals.size(); ++e) {
+    REQUIRE(real_edges.weights[e] == std::strtod(reals[e].c_str(), nullptr));
+  }
+  REQUIRE_FALSE(parse("0 1 1e400\n", real_edges));
+  REQUIRE_FALSE(parse("0 1 -2e308\n", real_edges));
+
+  // Weights that need the slow path ignore a global locale with a decimal
+  // comma.
+  struct DecimalComma : std::numpunct<char> {
+    char do_decimal_point() const override { return ','; }
+  };
+  const std::locale global = std::locale::global(
+      std::locale(std::locale::classic(), new DecimalComma));
+  const bool parsed = parse("0 1 1.5e30\n0 1 1.2345678901234567890123e5\n",
+                            real_edges);
+  std::locale::global(global);
+  REQUIRE(parsed);
+  REQUIRE(real_edges.weights ==
+          std::vector<double>{1.5e30, 1.2345678901234567890123e5});
+}
+
+TEST_CASE("read edge list", "[graph][edge_list]") {
+  // Large enough to be split into several chunks.
+  const std::string path = "dragon_edge_list_test.txt";
+  std::mt19937 rng(31);
+  const std::size_t sz = 5000, num_of_edges = 300000;
+  std::vector<dragon::CSRGraph<int, long long>::Edge> expected_edges;
+  {
+    std::ofstream out(path);
+    for (std::size_t e = 0; e < num_of_edges; ++e) {
+      expected_edges.push_back({rng() % sz, rng() % sz,
+                                static_cast<long long>(rng() % 2000) - 1000});
+      out << expected_edges.back().from << ' ' << expected_edges.back().to
+          << ' ' << expected_edges.back().weight << '\n';
+    }
+  }
+  dragon::ThreadPool pool(4);
+  dragon::EdgeList<long long> edges;
+  REQUIRE(dragon::read_edge_list(path, edges, pool));
+  REQUIRE(edges.size() == num_of_edges);
+  for (std::size_t e = 0; e < num_of_edges; ++e) {
+    REQUIRE(edges.sources[e] == expected_edges[e].from);
+    REQUIRE(edges.targets[e] == expected_edges[e].to);
+    REQUIRE(edges.weights[e] == expected_edges[e].weight);
+  }
+
+  dragon::CSRGraph<int, long long> expected(edges.num_of_nodes,
+                                            expected_edges);
+  auto graph = dragon::build_csr_graph<int>(edges, pool);
+  REQUIRE(graph.offsets() == expected.offsets());
+  REQUIRE(graph.targets() == expected.targets());
+  REQUIRE(graph.weights() == expected.weights());
+
+  REQUIRE_FALSE(dragon::read_edge_list(path + ".missing", edges, pool));
+  std::remove(path.c_str());
+}
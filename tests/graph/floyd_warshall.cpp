@@ -0,0 +1,89 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/floyd_warshall.hpp"
+#include "dragon/graph/shortest_path.hpp"
+#include <random>
+#include <vector>
+
+TEST_CASE("floyd warshall basic", "[graph][floyd_warshall]") {
+  dragon::Graph<int, int> graph(5, 0);
+  graph.add_directed_edge(0, 1, 4);
+  graph.add_directed_edge(0, 2, 1);
+  graph.add_directed_edge(2, 1, -2);
+  graph.add_directed_edge(1, 3, 3);
+  graph.add_directed_edge(3, 2, 2);
+
+  dragon::ThreadPool pool(2);
+  dragon::FloydWarshall<int> fw(graph, pool, true);
+  REQUIRE(fw.size() == 5);
+  REQUIRE(fw.stride() % dragon::details::floyd_warshall_block == 0);
+  REQUIRE_FALSE(fw.has_negative_cycle());
+  REQUIRE(fw(0, 1) == -1);
+  REQUIRE(fw(0, 3) == 2);
+  REQUIRE(fw(1, 2) == 5);
+  REQUIRE(fw(3, 1) == 0);
+  REQUIRE(fw(1, 0) == dragon::FloydWarshall<int>::inf_weight);
+  REQUIRE(fw(4, 4) == 0);
+  REQUIRE(fw.path(0, 3) == std::vector<std::size_t>{0, 2, 1, 3});
+  REQUIRE(fw.path(2, 2) == std::vector<std::size_t>{2});
+  REQUIRE(fw.path(1, 0).empty());
+  REQUIRE(fw.next_hop(1, 0) == dragon::FloydWarshall<int>::npos);
+}
+
+TEST_CASE("floyd warshall negative cycle", "[graph][floyd_warshall]") {
+  dragon::Graph<int, int> graph(3, 0);
+  graph.add_directed_edge(0, 1, 1);
+  graph.add_directed_edge(1, 2, -3);
+  graph.add_directed_edge(2, 1, 1);
+  dragon::ThreadPool pool(1);
+  REQUIRE(dragon::FloydWarshall<int>(graph, pool).has_negative_cycle());
+}
+
+template <typename EdgeValueT>
+void check_random(std::size_t sz, std::size_t threads, unsigned seed) {
+  std::mt19937 rng(seed);
+  // Weights shifted by node potentials keep negative edges without creating
+  // negative cycles. A chain makes every node reachable from node 0.
+  std::vector<int> height(sz);
+  for (auto& h : height) {
+    h = rng() % 40;
+  }
+  dragon::Graph<int, EdgeValueT> graph(sz, 0);
+  auto add = [&](std::size_t u, std::size_t v, int w) {
+    graph.add_directed_edge(u, v,
+                            static_cast<EdgeValueT>(w + height[v] - height[u]));
+  };
+  for (std::size_t i = 0; i + 1 < sz; ++i) {
+    add(i, i + 1, 5);
+  }
+  for (auto i = 0U; i < 3 * sz; ++i) {
+    add(rng() % sz, rng() % sz, rng() % 30);
+  }
+
+  dragon::ThreadPool pool(threads);
+  dragon::FloydWarshall<EdgeValueT> fw(graph, pool, true);
+  REQUIRE_FALSE(fw.has_negative_cycle());
+  for (std::size_t u_i = 0; u_i < sz; u_i += 7) {
+    std::vector<EdgeValueT> expected;
+    REQUIRE(dragon::spfa(graph, expected, u_i));
+    for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+      REQUIRE(fw(u_i, v_i) == expected[v_i]);
+      auto nodes = fw.path(u_i, v_i);
+      if (expected[v_i] == dragon::FloydWarshall<EdgeValueT>::inf_weight) {
+        REQUIRE(nodes.empty());
+        continue;
+      }
+      EdgeValueT weight = 0;
+      for (std::size_t i = 0; i + 1 < nodes.size(); ++i) {
+        weight += graph[nodes[i]].edges.at(nodes[i + 1]);
+      }
+      REQUIRE(weight == expected[v_i]);
+    }
+  }
+}
+
+TEST_CASE("floyd warshall random", "[graph][floyd_warshall]") {
+  check_random<int>(150, 3, 5);
+  check_random<long long>(130, 1, 6);
+  check_random<float>(70, 2, 7);
+  check_random<double>(200, 4, 8);
+}
@@ -0,0 +1,86 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/graph_file.hpp"
+#include "dragon/graph/shortest_path.hpp"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <utility>
+
+TEST_CASE("graph file round trip", "[graph][graph_file]") {
+  const std::string path = "dragon_graph_file_test.bin";
+  std::mt19937 rng(29);
+  const std::size_t sz = 500;
+  dragon::Graph<int, double> graph(sz, 4);
+  for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+    graph[v_i].value = static_cast<int>(v_i) - 7;
+  }
+  for (std::size_t e = 0; e < 4 * sz; ++e) {
+    graph.add_directed_edge(rng() % sz, rng() % sz, 0.5 * (rng() % 100));
+  }
+  REQUIRE(dragon::write_graph_file(path, graph));
+
+  dragon::MappedCSRGraph<int, double> mapped;
+  REQUIRE(mapped.open(path));
+  REQUIRE(mapped.size() == sz);
+  REQUIRE(mapped.root() == 4);
+  std::size_t num_of_edges = 0;
+  for (const auto& u : graph) {
+    num_of_edges += u.edges.size();
+    REQUIRE(mapped[u.index()].value == u.value);
+    REQUIRE(mapped.degree(u.index()) == u.edges.size());
+    for (auto edge : u.edges) {
+      REQUIRE(mapped[u.index()].edges.at(edge.first) == edge.second);
+    }
+  }
+  REQUIRE(mapped.num_edges() == num_of_edges);
+  REQUIRE(dragon::djikstra(mapped) == dragon::djikstra(graph));
+
+  // Written from a CSR graph, the file is the same.
+  dragon::CSRGraph<int, double> csr_graph(graph);
+  const std::string csr_path = "dragon_graph_file_test_csr.bin";
+  REQUIRE(dragon::write_graph_file(csr_path, csr_graph));
+  std::ifstream a(path, std::ios::binary), b(csr_path, std::ios::binary);
+  REQUIRE(std::string(std::istreambuf_iterator<char>(a), {}) ==
+          std::string(std::istreambuf_iterator<char>(b), {}));
+
+  auto moved = std::move(mapped);
+  REQUIRE(mapped.size() == 0);
+  REQUIRE(moved.size() == sz);
+  moved.close();
+  REQUIRE(moved.size() == 0);
+  std::remove(path.c_str());
+  std::remove(csr_path.c_str());
+}
+
+TEST_CASE("graph file rejects", "[graph][graph_file]") {
+  const std::string path = "dragon_graph_file_reject.bin";
+  dragon::Graph<int> graph(3);
+  graph.add_directed_edge(0, 1, 5);
+  REQUIRE(dragon::write_graph_file(path, graph));
+
+  // Other weight type, or missing file.
+  dragon::MappedCSRGraph<int, long long> wrong_weight;
+  REQUIRE_FALSE(wrong_weight.open(path));
+  dragon::MappedCSRGraph<int, float> wrong_kind;
+  REQUIRE_FALSE(wrong_kind.open(path));
+  dragon::MappedCSRGraph<int> mapped;
+  REQUIRE_FALSE(mapped.open(path + ".missing"));
+  REQUIRE(mapped.open(path));
+  REQUIRE(mapped[0].edges.at(1) == 5);
+
+  // Truncated file.
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << "DRAGONG";
+  }
+  REQUIRE_FALSE(mapped.open(path));
+  REQUIRE(mapped.size() == 0);
+
+  dragon::Graph<int> empty;
+  REQUIRE(dragon::write_graph_file(path, empty));
+  REQUIRE(mapped.open(path));
+  REQUIRE(mapped.size() == 0);
+  REQUIRE(mapped.num_edges() == 0);
+  std::remove(path.c_str());
+}
@@ -0,0 +1,98 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/max_flow.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+/// Checks capacity and conservation constraints and that the min cut
+/// capacity equals `value`.
+template <typename CapacityT>
+void check_flow(const dragon::FlowNetwork<CapacityT>& network,
+                const std::vector<std::size_t>& tails,
+                const std::vector<std::size_t>& heads,
+                const std::vector<CapacityT>& capacities, std::size_t source,
+                std::size_t sink, CapacityT value) {
+  std::vector<CapacityT> balance(network.size(), 0);
+  CapacityT cut = 0;
+  auto side = network.min_cut();
+  REQUIRE(side[source]);
+  REQUIRE_FALSE(side[sink]);
+  for (std::size_t e = 0; e < tails.size(); ++e) {
+    CapacityT f = network.flow(e);
+    REQUIRE(f >= 0);
+    REQUIRE(f <= capacities[e]);
+    balance[tails[e]] -= f;
+    balance[heads[e]] += f;
+    if (side[tails[e]] && !side[heads[e]]) {
+      REQUIRE(f == capacities[e]);
+      cut += capacities[e];
+    }
+  }
+  for (std::size_t v_i = 0; v_i < network.size(); ++v_i) {
+    if (v_i == source)
+      REQUIRE(balance[v_i] == -value);
+    else if (v_i == sink)
+      REQUIRE(balance[v_i] == value);
+    else
+      REQUIRE(balance[v_i] == 0);
+  }
+  REQUIRE(cut == value);
+}
+} // namespace
+
+TEST_CASE("max flow basic", "[graph][max_flow]") {
+  // CLRS figure 26.1.
+  dragon::Graph<int, int> graph(6, 0);
+  graph.add_directed_edge(0, 1, 16);
+  graph.add_directed_edge(0, 2, 13);
+  graph.add_directed_edge(1, 3, 12);
+  graph.add_directed_edge(2, 1, 4);
+  graph.add_directed_edge(2, 4, 14);
+  graph.add_directed_edge(3, 2, 9);
+  graph.add_directed_edge(3, 5, 20);
+  graph.add_directed_edge(4, 3, 7);
+  graph.add_directed_edge(4, 5, 4);
+
+  dragon::FlowNetwork<int> network(graph);
+  REQUIRE(network.num_of_edges() == 9);
+  REQUIRE(network.dinic(0, 5) == 23);
+  auto side = network.min_cut();
+  REQUIRE(side == std::vector<bool>{true, true, true, false, true, false});
+  REQUIRE(network.push_relabel(0, 5) == 23);
+  REQUIRE(network.min_cut() == side);
+  REQUIRE(network.dinic(5, 0) == 0);
+  REQUIRE(network.push_relabel(1, 1) == 0);
+
+  SECTION("built from a node count") {
+    dragon::FlowNetwork<int> small(4);
+    small.add_edge(0, 1, 3);
+    small.add_edge(1, 3, 2);
+    small.add_edge(0, 2, 1);
+    small.add_edge(2, 3, 5);
+    REQUIRE(small.size() == 4);
+    REQUIRE(small.dinic(0, 3) == 3);
+  }
+}
+
+TEST_CASE("max flow random", "[graph][max_flow]") {
+  std::mt19937 rng(83);
+  for (int round = 0; round < 20; ++round) {
+    const std::size_t sz = 2 + rng() % 60;
+    const std::size_t num_of_edges = rng() % (6 * sz);
+    dragon::FlowNetwork<long long> network(sz);
+    std::vector<std::size_t> tails, heads;
+    std::vector<long long> capacities;
+    for (std::size_t e = 0; e < num_of_edges; ++e) {
+      tails.push_back(rng() % sz);
+      heads.push_back(rng() % sz);
+      capacities.push_back(rng() % (round % 2 == 0 ? 2 : 1000));
+      REQUIRE(network.add_edge(tails[e], heads[e], capacities[e]) == e);
+    }
+    std::size_t source = rng() % sz;
+    std::size_t sink = (source + 1 + rng() % (sz - 1)) % sz;
+    long long value = network.dinic(source, sink);
+    check_flow(network, tails, heads, capacities, source, sink, value);
+    REQUIRE(network.push_relabel(source, sink) == value);
+    check_flow(network, tails, heads, capacities, source, sink, value);
+  }
+}
@@ -0,0 +1,182 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/max_flow.hpp"
+#include "dragon/graph/min_cost_flow.hpp"
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+using Edge = std::tuple<std::size_t, std::size_t, long long, long long>;
+
+/**
+ * Checks that the flow of `network` is a flow of value `value` from `source`
+ * to `sink` whose cost is `network.cost()`, and that it has minimum cost: the
+ * residual graph has no negative cost cycle.
+ */
+void check_flow(const dragon::MinCostFlowNetwork<long long>& network,
+                const std::vector<Edge>& edges, std::size_t source,
+                std::size_t sink, long long value) {
+  const std::size_t sz = network.size();
+  std::vector<long long> balance(sz, 0);
+  std::vector<Edge> residual;
+  long long cost = 0;
+  for (std::size_t e = 0; e < edges.size(); ++e) {
+    std::size_t u_i, v_i;
+    long long capacity, unit_cost;
+    std::tie(u_i, v_i, capacity, unit_cost) = edges[e];
+    long long f = network.flow(e);
+    REQUIRE(f >= 0);
+    REQUIRE(f <= capacity);
+    balance[u_i] -= f;
+    balance[v_i] += f;
+    cost += f * unit_cost;
+    if (f < capacity)
+      residual.emplace_back(u_i, v_i, 0, unit_cost);
+    if (f > 0)
+      residual.emplace_back(v_i, u_i, 0, -unit_cost);
+  }
+  for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+    if (v_i == source)
+      REQUIRE(balance[v_i] == -value);
+    else if (v_i == sink)
+      REQUIRE(balance[v_i] == value);
+    else
+      REQUIRE(balance[v_i] == 0);
+  }
+  REQUIRE(cost == network.cost());
+  // Bellman-Ford from every node at once: converges within `sz` rounds iff
+  // there is no negative cycle.
+  std::vector<long long> dist(sz, 0);
+  bool changed = true;
+  for (std::size_t round = 0; round <= sz && changed; ++round) {
+    changed = false;
+    for (const auto& arc : residual) {
+      long long temp = dist[std::get<0>(arc)] + std::get<3>(arc);
+      if (temp < dist[std::get<1>(arc)]) {
+        dist[std::get<1>(arc)] = temp;
+        changed = true;
+      }
+    }
+  }
+  REQUIRE_FALSE(changed);
+}
+} // namespace
+
+TEST_CASE("min cost flow basic", "[graph][min_cost_flow]") {
+  dragon::MinCostFlowNetwork<long long> network(4);
+  std::vector<Edge> edges = {Edge{0, 1, 2, 1}, Edge{0, 2, 1, 2},
+                             Edge{1, 2, 1, 1}, Edge{1, 3, 1, 3},
+                             Edge{2, 3, 2, 1}};
+  for (const auto& edge : edges) {
+    network.add_edge(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge),
+                     std::get<3>(edge));
+  }
+  REQUIRE(network.num_of_edges() == 5);
+
+  // Pushing one unit at a time.
+  REQUIRE(network.augment(0, 3, 1) == 1);
+  REQUIRE(network.cost() == 3);
+  check_flow(network, edges, 0, 3, 1);
+  REQUIRE(network.augment(0, 3, 1) == 1);
+  REQUIRE(network.cost() == 6);
+  check_flow(network, edges, 0, 3, 2);
+  REQUIRE(network.augment(0, 3) == 1);
+  REQUIRE(network.cost() == 10);
+  check_flow(network, edges, 0, 3, 3);
+  REQUIRE(network.augment(0, 3) == 0);
+
+  // Adding an edge keeps the flow, and the next augmentation uses it.
+  edges.emplace_back(0, 3, 5, 5);
+  REQUIRE(network.add_edge(0, 3, 5, 5) == 5);
+  REQUIRE(network.augment(0, 3, 2) == 2);
+  REQUIRE(network.cost() == 20);
+  check_flow(network, edges, 0, 3, 5);
+
+  // A cheaper edge makes the current flow suboptimal.
+  edges.emplace_back(0, 3, 1, 1);
+  REQUIRE(network.add_edge(0, 3, 1, 1) == 6);
+  REQUIRE(network.augment(0, 3) == 0);
+  REQUIRE(network.has_negative_cycle());
+
+  REQUIRE(network.successive_shortest_paths(0, 3) == 9);
+  REQUIRE_FALSE(network.has_negative_cycle());
+  REQUIRE(network.cost() == 36);
+  check_flow(network, edges, 0, 3, 9);
+  REQUIRE(network.cost_scaling(0, 3) == 9);
+  REQUIRE(network.cost() == 36);
+  check_flow(network, edges, 0, 3, 9);
+
+  network.reset();
+  REQUIRE(network.cost() == 0);
+  REQUIRE(network.flow(0) == 0);
+  REQUIRE(network.augment(3, 3) == 0);
+}
+
+TEST_CASE("min cost flow negative costs", "[graph][min_cost_flow]") {
+  // Negative costs without negative cycles.
+  dragon::MinCostFlowNetwork<long long> network(4);
+  std::vector<Edge> edges = {Edge{0, 1, 1, -5}, Edge{1, 2, 1, 1},
+                             Edge{0, 2, 1, 0}};
+  for (const auto& edge : edges) {
+    network.add_edge(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge),
+                     std::get<3>(edge));
+  }
+  REQUIRE(network.augment(0, 2, 1) == 1);
+  REQUIRE(network.cost() == -4);
+  REQUIRE_FALSE(network.has_negative_cycle());
+  REQUIRE(network.augment(0, 2) == 1);
+  REQUIRE(network.cost() == -4);
+
+  // A negative cycle stops the successive shortest paths, while cost
+  // scaling cancels it.
+  edges.emplace_back(2, 3, 1, -3);
+  edges.emplace_back(3, 2, 1, 1);
+  network.add_edge(2, 3, 1, -3);
+  network.add_edge(3, 2, 1, 1);
+  REQUIRE(network.successive_shortest_paths(0, 2) == 0);
+  REQUIRE(network.has_negative_cycle());
+  REQUIRE(network.cost_scaling(0, 2) == 2);
+  REQUIRE(network.cost() == -6);
+  check_flow(network, edges, 0, 2, 2);
+}
+
+TEST_CASE("min cost flow random", "[graph][min_cost_flow]") {
+  std::mt19937 rng(29);
+  for (int round = 0; round < 30; ++round) {
+    const std::size_t sz = 2 + rng() % 40;
+    const std::size_t num_of_edges = rng() % (5 * sz);
+    dragon::MinCostFlowNetwork<long long> network(sz);
+    dragon::FlowNetwork<long long> max_flow(sz);
+    std::vector<Edge> edges;
+    for (std::size_t e = 0; e < num_of_edges; ++e) {
+      edges.emplace_back(rng() % sz, rng() % sz,
+                         rng() % (round % 2 == 0 ? 3 : 100), rng() % 50);
+      REQUIRE(network.add_edge(std::get<0>(edges[e]), std::get<1>(edges[e]),
+                               std::get<2>(edges[e]),
+                               std::get<3>(edges[e])) == e);
+      max_flow.add_edge(std::get<0>(edges[e]), std::get<1>(edges[e]),
+                        std::get<2>(edges[e]));
+    }
+    std::size_t source = rng() % sz;
+    std::size_t sink = (source + 1 + rng() % (sz - 1)) % sz;
+    long long value = max_flow.push_relabel(source, sink);
+
+    REQUIRE(network.successive_shortest_paths(source, sink) == value);
+    check_flow(network, edges, source, sink, value);
+    long long cost = network.cost();
+    REQUIRE(network.cost_scaling(source, sink) == value);
+    REQUIRE(network.cost() == cost);
+    check_flow(network, edges, source, sink, value);
+
+    // Raising the flow step by step gives the same costs as starting over.
+    network.reset();
+    long long total = 0;
+    for (long long step = 1 + value / 4; total < value;) {
+      total += network.augment(source, sink, step);
+      check_flow(network, edges, source, sink, total);
+      dragon::MinCostFlowNetwork<long long> copy = network;
+      REQUIRE(copy.successive_shortest_paths(source, sink, total) == total);
+      REQUIRE(copy.cost() == network.cost());
+    }
+  }
+}
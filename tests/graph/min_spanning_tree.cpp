@@ -1,5 +1,7 @@
 #include "catch2/catch.hpp"
+#include "dragon/graph/csr_graph.hpp"
 #include "dragon/graph/min_spanning_tree.hpp"
+#include <random>
 
 TEST_CASE("min spanning tree basic", "[min-spanning-tree][graph]") {
   dragon::Graph<int> graph(5);
@@ -34,4 +36,193 @@ TEST_CASE("min spanning tree basic", "[min-spanning-tree][graph]") {
 
   REQUIRE(prim_wt == 16);
   REQUIRE(kruskal_wt == 16);
-}
\ No newline at end of file
+}
+
+namespace {
+template <typename TreeT>
+typename TreeT::EdgeValueType weight(const TreeT& tree) {
+  typename TreeT::EdgeValueType total = 0;
+  for (const auto& node : tree) {
+    for (auto edge : node.edges) {
+      total += edge.second;
+    }
+  }
+  return total / 2;
+}
+} // namespace
+
+TEST_CASE("flat and filter kruskal", "[min-spanning-tree][graph]") {
+  dragon::Graph<int> graph(5);
+  graph.add_undirected_edge(0, 1, 1);
+  graph.add_undirected_edge(0, 3, 2);
+  graph.add_undirected_edge(0, 2, 10);
+  graph.add_undirected_edge(1, 2, 11);
+  graph.add_undirected_edge(1, 4, 3);
+  graph.add_undirected_edge(2, 3, 12);
+  graph.add_undirected_edge(2, 4, 13);
+  graph.add_undirected_edge(3, 4, 4);
+
+  auto flat_tree = dragon::flat_kruskal(graph);
+  auto filter_tree = dragon::filter_kruskal(graph);
+  REQUIRE(flat_tree.size() == 5);
+  REQUIRE(weight(flat_tree) == 16);
+  REQUIRE(filter_tree.size() == 5);
+  REQUIRE(weight(filter_tree) == 16);
+  REQUIRE(flat_tree[0].edges.count(2) == 1);
+
+  // Edges stored in one direction only, or with a cheaper reverse.
+  dragon::Graph<int> directed(3);
+  directed.add_directed_edge(2, 0, 5);
+  directed.add_directed_edge(1, 2, 7);
+  directed.add_directed_edge(2, 1, 3);
+  directed.add_directed_edge(0, 1, 9);
+  REQUIRE(weight(dragon::flat_kruskal(directed)) == 8);
+  REQUIRE(weight(dragon::filter_kruskal(directed)) == 8);
+  REQUIRE(weight(dragon::kruskal(directed)) == 8);
+
+  // Disconnected graph.
+  dragon::Graph<int> disconnected(4);
+  disconnected.add_undirected_edge(0, 1, 1);
+  disconnected.add_undirected_edge(2, 3, 1);
+  REQUIRE(dragon::flat_kruskal(disconnected).size() == 0);
+  REQUIRE(dragon::filter_kruskal(disconnected).size() == 0);
+}
+
+TEST_CASE("kruskal variants random", "[min-spanning-tree][graph]") {
+  std::mt19937 rng(5);
+  for (int round = 0; round < 10; ++round) {
+    const std::size_t sz = 1 + rng() % 3000;
+    dragon::Graph<int, long long> graph(sz);
+    // A random spanning path keeps the graph connected.
+    for (std::size_t v_i = 1; v_i < sz; ++v_i) {
+      graph.add_undirected_edge(rng() % v_i, v_i, rng() % 1000);
+    }
+    for (std::size_t e = 0; e < 4 * sz; ++e) {
+      graph.add_undirected_edge(rng() % sz, rng() % sz,
+                                round % 2 == 0 ? rng() % 4 : rng() % 100000);
+    }
+    long long expected = weight(dragon::kruskal(graph));
+    auto flat_tree = dragon::flat_kruskal(graph);
+    auto filter_tree = dragon::filter_kruskal(graph);
+    REQUIRE(flat_tree.size() == sz);
+    REQUIRE(filter_tree.size() == sz);
+    REQUIRE(weight(flat_tree) == expected);
+    REQUIRE(weight(filter_tree) == expected);
+  }
+
+  dragon::Graph<int, double> graph(200);
+  for (std::size_t v_i = 1; v_i < 200; ++v_i) {
+    graph.add_undirected_edge(v_i - 1, v_i, 0.5 * (rng() % 100));
+  }
+  for (std::size_t e = 0; e < 2000; ++e) {
+    graph.add_undirected_edge(rng() % 200, rng() % 200, 0.25 * (rng() % 400));
+  }
+  REQUIRE(weight(dragon::filter_kruskal(graph)) ==
+          weight(dragon::kruskal(graph)));
+}
+
+TEST_CASE("boruvka", "[min-spanning-tree][graph]") {
+  dragon::Graph<int> graph(5);
+  graph.add_undirected_edge(0, 1, 1);
+  graph.add_undirected_edge(0, 3, 2);
+  graph.add_undirected_edge(0, 2, 10);
+  graph.add_undirected_edge(1, 2, 11);
+  graph.add_undirected_edge(1, 4, 3);
+  graph.add_undirected_edge(2, 3, 12);
+  graph.add_undirected_edge(2, 4, 13);
+  graph.add_undirected_edge(3, 4, 4);
+  graph.add_undirected_edge(4, 4, 0);
+  auto tree = dragon::boruvka(graph, 2);
+  REQUIRE(tree.size() == 5);
+  REQUIRE(tree.root() == 2);
+  REQUIRE(weight(tree) == 16);
+  REQUIRE(tree[0].edges.count(2) == 1);
+  REQUIRE(weight(dragon::boruvka(dragon::CSRGraph<int>(graph))) == 16);
+
+  dragon::Graph<int> disconnected(4);
+  disconnected.add_undirected_edge(0, 1, 1);
+  disconnected.add_undirected_edge(2, 3, 1);
+  REQUIRE(dragon::boruvka(disconnected).size() == 0);
+  REQUIRE(dragon::boruvka(dragon::Graph<int>(1)).size() == 1);
+
+  // Equal weights everywhere must still give a tree.
+  dragon::ThreadPool pool(4);
+  dragon::Graph<int> cycle(6);
+  for (std::size_t v_i = 0; v_i < 6; ++v_i) {
+    cycle.add_undirected_edge(v_i, (v_i + 1) % 6, 1);
+  }
+  auto cycle_tree = dragon::boruvka(cycle, pool);
+  REQUIRE(cycle_tree.size() == 6);
+  REQUIRE(weight(cycle_tree) == 5);
+}
+
+TEST_CASE("boruvka random", "[min-spanning-tree][graph]") {
+  std::mt19937 rng(23);
+  for (std::size_t threads : {1, 4}) {
+    dragon::ThreadPool pool(threads);
+    for (int round = 0; round < 10; ++round) {
+      const std::size_t sz = 1 + rng() % 3000;
+      dragon::Graph<int, long long> graph(sz);
+      for (std::size_t v_i = 1; v_i < sz; ++v_i) {
+        graph.add_undirected_edge(rng() % v_i, v_i, rng() % 1000);
+      }
+      for (std::size_t e = 0; e < 4 * sz; ++e) {
+        graph.add_undirected_edge(rng() % sz, rng() % sz,
+                                  round % 2 == 0 ? rng() % 4 : rng() % 100000);
+      }
+      auto tree = dragon::boruvka(graph, pool);
+      REQUIRE(tree.size() == sz);
+      REQUIRE(weight(tree) == weight(dragon::kruskal(graph)));
+    }
+  }
+}
+
+TEST_CASE("prim variants", "[min-spanning-tree][graph]") {
+  dragon::Graph<int> graph(5);
+  graph.add_undirected_edge(0, 1, 1);
+  graph.add_undirected_edge(0, 3, 2);
+  graph.add_undirected_edge(0, 2, 10);
+  graph.add_undirected_edge(1, 2, 11);
+  graph.add_undirected_edge(1, 4, 3);
+  graph.add_undirected_edge(2, 3, 12);
+  graph.add_undirected_edge(2, 4, 13);
+  graph.add_undirected_edge(3, 4, 4);
+  auto dense_tree = dragon::dense_prim(graph, 4);
+  REQUIRE(dense_tree.size() == 5);
+  REQUIRE(dense_tree.root() == 4);
+  REQUIRE(dense_tree[4].parent == 4);
+  REQUIRE(dense_tree[2].parent == 0);
+  REQUIRE(weight(dense_tree) == 16);
+
+  dragon::Graph<int> disconnected(4);
+  disconnected.add_undirected_edge(0, 1, 1);
+  disconnected.add_undirected_edge(2, 3, 1);
+  REQUIRE(dragon::prim(disconnected).size() == 0);
+  REQUIRE(dragon::dense_prim(disconnected).size() == 0);
+
+  // One heap reused across graphs of different sizes.
+  dragon::IndexedDaryHeap<int> heap;
+  REQUIRE(weight(dragon::prim(graph, heap)) == 16);
+  REQUIRE(dragon::prim(disconnected, heap).size() == 0);
+  REQUIRE(heap.empty());
+  auto tree = dragon::prim(graph, heap, 3);
+  REQUIRE(tree.root() == 3);
+  REQUIRE(tree[1].parent == 0);
+  REQUIRE(weight(tree) == 16);
+
+  std::mt19937 rng(11);
+  dragon::IndexedDaryHeap<long long, 2> binary_heap;
+  for (int round = 0; round < 10; ++round) {
+    const std::size_t sz = 1 + rng() % 500;
+    dragon::Graph<int, long long> random(sz);
+    for (std::size_t v_i = 1; v_i < sz; ++v_i) {
+      random.add_undirected_edge(rng() % v_i, v_i, rng() % 1000);
+    }
+    for (std::size_t e = 0; e < 8 * sz; ++e) {
+      random.add_undirected_edge(rng() % sz, rng() % sz, rng() % 1000);
+    }
+    long long expected = weight(dragon::kruskal(random));
+    REQUIRE(weight(dragon::prim(random, binary_heap)) == expected);
+    REQUIRE(weight(dragon::dense_prim(random)) == expected);
+  }
+}
@@ -0,0 +1,90 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/point_to_point.hpp"
+#include "dragon/graph/shortest_path.hpp"
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+template <typename GraphT, typename QueryT>
+long long path_weight(const GraphT& graph, const QueryT& query) {
+  auto nodes = query.path();
+  long long wt = 0;
+  for (auto i = 0U; i + 1 < nodes.size(); ++i) {
+    wt += graph[nodes[i]].edges.at(nodes[i + 1]);
+  }
+  return wt;
+}
+
+TEST_CASE("point to point query random", "[graph][point_to_point]") {
+  std::mt19937 rng(23);
+  const std::size_t sz = 500;
+  dragon::Graph<int, long long> graph(sz, 0);
+  for (auto i = 0U; i < 3 * sz; ++i) {
+    graph.add_directed_edge(rng() % sz, rng() % sz, rng() % 100);
+  }
+  dragon::PointToPointQuery<decltype(graph)> query(graph);
+  const auto inf = decltype(query)::inf_weight;
+
+  for (int q = 0; q < 50; ++q) {
+    std::size_t s = rng() % sz, t = rng() % sz;
+    auto expected = dragon::djikstra(graph, s)[t];
+
+    REQUIRE(query.djikstra(s, t) == expected);
+    if (expected != inf) {
+      REQUIRE(path_weight(graph, query) == expected);
+      REQUIRE(query.path().front() == s);
+      REQUIRE(query.path().back() == t);
+    } else {
+      REQUIRE(query.path().empty());
+    }
+
+    REQUIRE(query.bidirectional_djikstra(s, t) == expected);
+    if (expected != inf) {
+      REQUIRE(path_weight(graph, query) == expected);
+      REQUIRE(query.path().front() == s);
+      REQUIRE(query.path().back() == t);
+    } else {
+      REQUIRE(query.path().empty());
+    }
+  }
+
+  REQUIRE(query.bidirectional_djikstra(7, 7) == 0);
+  REQUIRE(query.path() == std::vector<std::size_t>{7});
+}
+
+TEST_CASE("point to point query a star", "[graph][point_to_point]") {
+  // Grid graph where every edge weighs at least 1, so the Manhattan distance
+  // to the target is an admissible heuristic.
+  std::mt19937 rng(29);
+  const std::size_t side = 30;
+  std::vector<dragon::CSRGraph<int, int>::Edge> edges;
+  for (std::size_t r = 0; r < side; ++r) {
+    for (std::size_t c = 0; c < side; ++c) {
+      std::size_t u = r * side + c;
+      if (c + 1 < side) {
+        edges.push_back({u, u + 1, 1 + static_cast<int>(rng() % 9)});
+        edges.push_back({u + 1, u, 1 + static_cast<int>(rng() % 9)});
+      }
+      if (r + 1 < side) {
+        edges.push_back({u, u + side, 1 + static_cast<int>(rng() % 9)});
+        edges.push_back({u + side, u, 1 + static_cast<int>(rng() % 9)});
+      }
+    }
+  }
+  dragon::CSRGraph<int, int> graph(side * side, edges);
+  dragon::PointToPointQuery<decltype(graph)> query(graph);
+
+  for (int q = 0; q < 30; ++q) {
+    std::size_t s = rng() % graph.size(), t = rng() % graph.size();
+    auto manhattan = [&](std::size_t v) {
+      long r = static_cast<long>(v / side) - static_cast<long>(t / side);
+      long c = static_cast<long>(v % side) - static_cast<long>(t % side);
+      return static_cast<int>(std::labs(r) + std::labs(c));
+    };
+    auto expected = dragon::djikstra(graph, s)[t];
+    REQUIRE(query.a_star(s, t, manhattan) == expected);
+    REQUIRE(path_weight(graph, query) == expected);
+    REQUIRE(query.bidirectional_djikstra(s, t) == expected);
+  }
+}
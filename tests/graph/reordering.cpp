@@ -0,0 +1,105 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/reordering.hpp"
+#include "dragon/graph/shortest_path.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST_CASE("vertex order", "[graph][reordering]") {
+  // Star around 3, with the path 3 - 1 - 4 - 0 hanging off it.
+  dragon::Graph<int> graph(6, 2);
+  graph.add_undirected_edge(3, 2);
+  graph.add_undirected_edge(3, 5);
+  graph.add_undirected_edge(3, 1);
+  graph.add_undirected_edge(1, 4);
+  graph.add_undirected_edge(4, 0);
+  using Order = std::vector<std::size_t>;
+  REQUIRE(dragon::vertex_order(graph, dragon::VertexOrder::bfs) ==
+          Order{2, 3, 1, 5, 4, 0});
+  REQUIRE(dragon::vertex_order(graph, dragon::VertexOrder::dfs) ==
+          Order{2, 3, 1, 4, 0, 5});
+  REQUIRE(dragon::vertex_order(graph,
+                               dragon::VertexOrder::degree_descending) ==
+          Order{3, 1, 4, 0, 2, 5});
+  // Cuthill-McKee from 0: 0, 4, 1, 3, then 2 and 5 by degree and index.
+  REQUIRE(dragon::vertex_order(graph,
+                               dragon::VertexOrder::reverse_cuthill_mckee) ==
+          Order{5, 2, 3, 1, 4, 0});
+  REQUIRE(dragon::vertex_order(dragon::Graph<int>(0),
+                               dragon::VertexOrder::bfs)
+              .empty());
+}
+
+TEST_CASE("reverse cuthill mckee bandwidth", "[graph][reordering]") {
+  // A path with shuffled labels, plus an isolated node.
+  const std::size_t sz = 200;
+  std::vector<std::size_t> label(sz);
+  for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+    label[v_i] = v_i;
+  }
+  std::shuffle(label.begin(), label.end(), std::mt19937(3));
+  dragon::Graph<int> graph(sz + 1);
+  for (std::size_t v_i = 1; v_i < sz; ++v_i) {
+    graph.add_undirected_edge(label[v_i - 1], label[v_i]);
+  }
+  std::vector<std::size_t> new_index, old_index;
+  auto relabeled = dragon::reorder(
+      graph, dragon::VertexOrder::reverse_cuthill_mckee, new_index, old_index);
+  std::size_t bandwidth = 0;
+  for (const auto& u : relabeled) {
+    for (auto edge : u.edges) {
+      bandwidth = std::max(bandwidth, edge.first > u.index()
+                                          ? edge.first - u.index()
+                                          : u.index() - edge.first);
+    }
+  }
+  REQUIRE(bandwidth == 1);
+}
+
+TEST_CASE("reorder relabels", "[graph][reordering]") {
+  std::mt19937 rng(17);
+  const std::size_t sz = 300;
+  dragon::Graph<int, long long> graph(sz, 7);
+  std::vector<dragon::CSRGraph<int, long long>::Edge> edges;
+  for (std::size_t e = 0; e < 5 * sz; ++e) {
+    std::size_t u_i = rng() % sz, v_i = rng() % (sz / 3);
+    long long w = rng() % 100;
+    graph.add_directed_edge(u_i, v_i, w);
+    edges.push_back({u_i, v_i, w});
+  }
+  for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+    graph[v_i].value = static_cast<int>(v_i) * 3;
+  }
+  dragon::CSRGraph<int, long long> csr_graph(graph);
+  const auto expected = dragon::djikstra(graph);
+
+  for (auto order : {dragon::VertexOrder::reverse_cuthill_mckee,
+                     dragon::VertexOrder::degree_descending,
+                     dragon::VertexOrder::bfs, dragon::VertexOrder::dfs}) {
+    std::vector<std::size_t> new_index, old_index;
+    auto relabeled = dragon::reorder(graph, order, new_index, old_index);
+    REQUIRE(old_index.size() == sz);
+    REQUIRE(relabeled.root() == new_index[7]);
+    auto csr_relabeled =
+        dragon::reorder(csr_graph, order, new_index, old_index);
+    REQUIRE(csr_relabeled.root() == new_index[7]);
+    REQUIRE(csr_relabeled.num_edges() == csr_graph.num_edges());
+    const auto dist = dragon::djikstra(relabeled);
+    const auto csr_dist = dragon::djikstra(csr_relabeled);
+    for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+      REQUIRE(old_index[new_index[v_i]] == v_i);
+      REQUIRE(relabeled[new_index[v_i]].value == graph[v_i].value);
+      REQUIRE(csr_relabeled[new_index[v_i]].value == graph[v_i].value);
+      REQUIRE(relabeled[new_index[v_i]].edges.size() ==
+              graph[v_i].edges.size());
+      REQUIRE(dist[new_index[v_i]] == expected[v_i]);
+      REQUIRE(csr_dist[new_index[v_i]] == expected[v_i]);
+    }
+    for (const auto& u : csr_relabeled) {
+      REQUIRE(std::is_sorted(csr_relabeled.targets().begin() +
+                                 csr_relabeled.offsets()[u.index()],
+                             csr_relabeled.targets().begin() +
+                                 csr_relabeled.offsets()[u.index() + 1]));
+    }
+  }
+}
@@ -1,5 +1,6 @@
 #include "dragon/graph/shortest_path.hpp"
 #include "catch2/catch.hpp"
+#include <random>
 #include <vector>
 
 TEST_CASE("shortest path basic","[graph][shortest_path]") {
@@ -30,3 +31,127 @@ TEST_CASE("shortest path basic","[graph][shortest_path]") {
   REQUIRE(djikstra_shortest_path_wt[5] == bellman_ford_shortest_path_wt[5]);
   REQUIRE(djikstra_shortest_path_wt[5] == 14);
 }
+
+TEST_CASE("djikstra queue policies", "[graph][shortest_path]") {
+  std::mt19937 rng(3);
+  const std::size_t sz = 300;
+  dragon::Graph<int, long long> graph(sz, 0);
+  for (auto i = 0U; i + 1 < sz; ++i) {
+    graph.add_directed_edge(i, i + 1, 1000);
+  }
+  for (auto i = 0U; i < 3 * sz; ++i) {
+    graph.add_directed_edge(rng() % sz, rng() % sz, rng() % 100);
+  }
+
+  std::vector<long long> expected;
+  REQUIRE(dragon::bellman_ford(graph, expected));
+
+  REQUIRE(dragon::djikstra(graph) == expected);
+  const std::size_t source = graph.root();
+  REQUIRE(dragon::djikstra(graph, source, dragon::SetQueue{}) == expected);
+  REQUIRE(dragon::djikstra(graph, source, dragon::DaryHeapQueue<2>{}) ==
+          expected);
+  REQUIRE(dragon::djikstra(graph, source, dragon::DaryHeapQueue<8>{}) ==
+          expected);
+  REQUIRE(dragon::djikstra(graph, source, dragon::LazyBinaryHeapQueue{}) ==
+          expected);
+  // The graph type can still be given explicitly.
+  REQUIRE(dragon::djikstra<decltype(graph)>(graph, source) == expected);
+}
+
+TEST_CASE("integer shortest paths", "[graph][shortest_path]") {
+  std::mt19937 rng(5);
+  const std::size_t sz = 400;
+  auto make_graph = [&](unsigned max_weight) {
+    dragon::Graph<int, unsigned> graph(sz, 0);
+    for (auto i = 0U; i < 4 * sz; ++i) {
+      graph.add_directed_edge(rng() % sz, rng() % sz, rng() % (max_weight + 1));
+    }
+    return graph;
+  };
+
+  SECTION("zero one weights") {
+    auto graph = make_graph(1);
+    auto expected = dragon::djikstra(graph);
+    REQUIRE(dragon::zero_one_bfs(graph) == expected);
+    REQUIRE(dragon::shortest_paths(graph) == expected);
+  }
+
+  SECTION("small weights") {
+    auto graph = make_graph(255);
+    auto expected = dragon::djikstra(graph);
+    REQUIRE(dragon::dial_djikstra(graph, 255U) == expected);
+    REQUIRE(dragon::radix_djikstra(graph) == expected);
+    REQUIRE(dragon::shortest_paths(graph) == expected);
+    REQUIRE(dragon::shortest_paths(graph, 7) == dragon::djikstra(graph, 7));
+  }
+
+  SECTION("large weights") {
+    auto graph = make_graph(1000000);
+    auto expected = dragon::djikstra(graph);
+    REQUIRE(dragon::radix_djikstra(graph) == expected);
+    REQUIRE(dragon::shortest_paths(graph) == expected);
+  }
+
+  SECTION("floating point weights") {
+    dragon::Graph<int, double> graph(3, 0);
+    graph.add_directed_edge(0, 1, 0.5);
+    graph.add_directed_edge(1, 2, 0.25);
+    graph.add_directed_edge(0, 2, 1.0);
+    REQUIRE(dragon::shortest_paths(graph) == dragon::djikstra(graph));
+  }
+}
+
+TEST_CASE("spfa", "[graph][shortest_path]") {
+  SECTION("matches bellman ford on negative weights") {
+    // Reweighting non-negative weights with node potentials gives negative
+    // edges but no negative cycle.
+    std::mt19937 rng(13);
+    const std::size_t sz = 300;
+    std::vector<int> potential(sz);
+    for (auto& p : potential)
+      p = static_cast<int>(rng() % 1000);
+    dragon::Graph<int, int> graph(sz, 0);
+    auto add_edge = [&](std::size_t u, std::size_t v, int w) {
+      graph.add_directed_edge(u, v, w + potential[u] - potential[v]);
+    };
+    for (auto i = 0U; i + 1 < sz; ++i)
+      add_edge(i, i + 1, 50);
+    for (auto i = 0U; i < 4 * sz; ++i)
+      add_edge(rng() % sz, rng() % sz, static_cast<int>(rng() % 100));
+
+    std::vector<int> expected, actual;
+    std::vector<std::size_t> cycle;
+    REQUIRE(dragon::bellman_ford(graph, expected));
+    REQUIRE(dragon::spfa(graph, actual, cycle));
+    REQUIRE(cycle.empty());
+    REQUIRE(actual == expected);
+  }
+
+  SECTION("extracts negative cycle") {
+    dragon::Graph<int, int> graph(7, 0);
+    graph.add_directed_edge(0, 1, 4);
+    graph.add_directed_edge(1, 2, 1);
+    graph.add_directed_edge(2, 3, -2);
+    graph.add_directed_edge(3, 4, 1);
+    graph.add_directed_edge(4, 2, -1);
+    graph.add_directed_edge(4, 5, 3);
+    graph.add_directed_edge(0, 6, 1);
+
+    std::vector<int> wt;
+    std::vector<std::size_t> cycle;
+    REQUIRE_FALSE(dragon::spfa(graph, wt, cycle));
+    REQUIRE(cycle.size() == 3);
+    int cycle_wt = 0;
+    for (auto i = 0U; i < cycle.size(); ++i) {
+      auto u = cycle[i], v = cycle[(i + 1) % cycle.size()];
+      REQUIRE(graph[u].edges.count(v) == 1);
+      cycle_wt += graph[u].edges.at(v);
+    }
+    REQUIRE(cycle_wt < 0);
+
+    // The cycle is not reachable from node 5.
+    REQUIRE(dragon::spfa(graph, wt, cycle, 5));
+    REQUIRE(cycle.empty());
+  }
+}
@@ -0,0 +1,108 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/strongly_connected_components.hpp"
+#include <random>
+#include <vector>
+
+TEST_CASE("scc basic", "[graph][strongly_connected_components]") {
+  dragon::Graph<int, int> graph(8, 0);
+  graph.add_directed_edge(0, 1, 5);
+  graph.add_directed_edge(1, 2, 1);
+  graph.add_directed_edge(2, 0, 1);
+  graph.add_directed_edge(2, 3, 7);
+  graph.add_directed_edge(1, 3, 4);
+  graph.add_directed_edge(3, 4, 1);
+  graph.add_directed_edge(4, 3, 1);
+  graph.add_directed_edge(5, 4, 2);
+  graph.add_directed_edge(6, 6, 2);
+
+  std::vector<std::size_t> sizes;
+  auto component = dragon::strongly_connected_components(graph, sizes);
+  REQUIRE(sizes.size() == 5);
+  REQUIRE(component[0] == component[1]);
+  REQUIRE(component[1] == component[2]);
+  REQUIRE(component[3] == component[4]);
+  REQUIRE(sizes[component[0]] == 3);
+  REQUIRE(sizes[component[3]] == 2);
+  REQUIRE(sizes[component[5]] == 1);
+  REQUIRE(component[0] < component[3]);
+  REQUIRE(component[5] < component[3]);
+  for (const auto& node : graph) {
+    REQUIRE(node.color == dragon::Graph<int, int>::Color::white);
+  }
+
+  auto dag = dragon::condensation(graph, component, sizes.size());
+  REQUIRE(dag.size() == 5);
+  REQUIRE(dag.root() == component[0]);
+  REQUIRE(dag[component[0]].value == 3);
+  // 2 -> 3 and 1 -> 3 merge into the lighter edge.
+  REQUIRE(dag[component[0]].edges.size() == 1);
+  REQUIRE(dag[component[0]].edges.at(component[3]) == 4);
+  REQUIRE(dag[component[5]].edges.at(component[3]) == 2);
+  REQUIRE(dag[component[3]].edges.empty());
+  REQUIRE(dag[component[6]].edges.empty());
+}
+
+TEST_CASE("scc random", "[graph][strongly_connected_components]") {
+  std::mt19937 rng(61);
+  const std::size_t sz = 120;
+  dragon::Graph<int, int> graph(sz, 0);
+  for (auto i = 0U; i < 2 * sz; ++i) {
+    graph.add_directed_edge(rng() % sz, rng() % sz);
+  }
+  // Reachability closure by repeated search.
+  std::vector<std::vector<bool>> reach(sz, std::vector<bool>(sz, false));
+  for (std::size_t s = 0; s < sz; ++s) {
+    std::vector<std::size_t> stack{s};
+    reach[s][s] = true;
+    while (!stack.empty()) {
+      auto u_i = stack.back();
+      stack.pop_back();
+      for (auto edge : graph[u_i].edges) {
+        if (!reach[s][edge.first]) {
+          reach[s][edge.first] = true;
+          stack.push_back(edge.first);
+        }
+      }
+    }
+  }
+
+  std::vector<std::size_t> sizes;
+  auto component = dragon::strongly_connected_components(graph, sizes);
+  for (std::size_t u_i = 0; u_i < sz; ++u_i) {
+    for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+      bool same = reach[u_i][v_i] && reach[v_i][u_i];
+      REQUIRE((component[u_i] == component[v_i]) == same);
+    }
+    for (auto edge : graph[u_i].edges) {
+      REQUIRE(component[u_i] <= component[edge.first]);
+    }
+  }
+  auto dag = dragon::condensation(graph);
+  REQUIRE(dag.size() == sizes.size());
+  for (const auto& node : dag) {
+    REQUIRE(node.value == sizes[node.index()]);
+    for (auto edge : node.edges) {
+      REQUIRE(node.index() < edge.first);
+    }
+  }
+}
+
+TEST_CASE("scc long path", "[graph][strongly_connected_components]") {
+  // Deep enough to overflow the call stack of a recursive search.
+  const std::size_t sz = 1000000;
+  std::vector<dragon::CSRGraph<int, int>::Edge> edges;
+  for (std::size_t i = 0; i + 1 < sz; ++i) {
+    edges.push_back({i, i + 1, 1});
+  }
+  edges.push_back({sz / 2, 0, 1});
+  dragon::CSRGraph<int, int> graph(sz, edges);
+
+  std::vector<std::size_t> sizes;
+  auto component = dragon::strongly_connected_components(graph, sizes);
+  REQUIRE(sizes.size() == sz / 2);
+  REQUIRE(sizes[0] == sz / 2 + 1);
+  REQUIRE(component[0] == 0);
+  REQUIRE(component[sz / 2] == 0);
+  REQUIRE(component[sz - 1] == sz / 2 - 1);
+}
@@ -0,0 +1,99 @@
+#include "catch2/catch.hpp"
+#include "dragon/graph/csr_graph.hpp"
+#include "dragon/graph/topological_sort.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+template <typename GraphT>
+void check_order(const GraphT& graph, const std::vector<std::size_t>& order) {
+  std::vector<std::size_t> position(graph.size(), graph.size());
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    position[order[i]] = i;
+  }
+  for (const auto& u : graph) {
+    REQUIRE(position[u.index()] < graph.size());
+    for (auto edge : u.edges) {
+      REQUIRE(position[u.index()] < position[edge.first]);
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("topological sort basic", "[graph][topological_sort]") {
+  dragon::Graph<int, int> graph(6, 0);
+  graph.add_directed_edge(5, 2);
+  graph.add_directed_edge(5, 0);
+  graph.add_directed_edge(4, 0);
+  graph.add_directed_edge(4, 1);
+  graph.add_directed_edge(2, 3);
+  graph.add_directed_edge(3, 1);
+
+  std::vector<std::size_t> order, levels;
+  REQUIRE(dragon::topological_sort(graph, order));
+  REQUIRE(order == std::vector<std::size_t>{4, 5, 0, 2, 3, 1});
+
+  dragon::ThreadPool pool(2);
+  REQUIRE(dragon::topological_sort(graph, order, levels, pool));
+  check_order(graph, order);
+  REQUIRE(levels == std::vector<std::size_t>{0, 2, 4, 5, 6});
+
+  graph.add_directed_edge(1, 5);
+  REQUIRE_FALSE(dragon::topological_sort(graph, order));
+  REQUIRE(order == std::vector<std::size_t>{4});
+  REQUIRE_FALSE(dragon::topological_sort(graph, order, levels, pool));
+  REQUIRE(order == std::vector<std::size_t>{4});
+}
+
+TEST_CASE("topological sort random", "[graph][topological_sort]") {
+  std::mt19937 rng(71);
+  const std::size_t sz = 4000;
+  // Edges follow a random permutation, so the graph is acyclic.
+  std::vector<std::size_t> rank(sz);
+  for (std::size_t i = 0; i < sz; ++i) {
+    rank[i] = i;
+  }
+  std::shuffle(rank.begin(), rank.end(), rng);
+  std::vector<dragon::CSRGraph<int, int>::Edge> edges;
+  for (auto i = 0U; i < 5 * sz; ++i) {
+    std::size_t a = rng() % sz, b = rng() % sz;
+    if (a != b)
+      edges.push_back({rank[std::min(a, b)], rank[std::max(a, b)], 1});
+  }
+  dragon::CSRGraph<int, int> graph(sz, edges);
+
+  std::vector<std::size_t> order, levels;
+  REQUIRE(dragon::topological_sort(graph, order));
+  check_order(graph, order);
+  for (std::size_t threads : {1, 4}) {
+    dragon::ThreadPool pool(threads);
+    REQUIRE(dragon::topological_sort(graph, order, levels, pool));
+    check_order(graph, order);
+    // Every node of level `l + 1` has a predecessor on level `l`.
+    std::vector<std::size_t> level(sz);
+    for (std::size_t l = 0; l + 1 < levels.size(); ++l) {
+      for (auto i = levels[l]; i < levels[l + 1]; ++i) {
+        level[order[i]] = l;
+      }
+    }
+    std::vector<std::size_t> deepest(sz, 0);
+    std::vector<bool> has_in_edge(sz, false);
+    for (const auto& u : graph) {
+      for (auto edge : u.edges) {
+        has_in_edge[edge.first] = true;
+        deepest[edge.first] =
+            std::max(deepest[edge.first], level[u.index()] + 1);
+      }
+    }
+    for (std::size_t v_i = 0; v_i < sz; ++v_i) {
+      REQUIRE(level[v_i] == deepest[v_i]);
+    }
+  }
+
+  edges.push_back({order.back(), order.front(), 1});
+  dragon::CSRGraph<int, int> cyclic(sz, edges);
+  REQUIRE_FALSE(dragon::topological_sort(cyclic, order));
+  dragon::ThreadPool pool(2);
+  REQUIRE_FALSE(dragon::topological_sort(cyclic, order, levels, pool));
+}
@@ -0,0 +1,70 @@
+#include "dragon/sorting/radix-sort.hpp"
+#include "catch2/catch.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Catch::Matchers::Equals;
+
+TEST_CASE("radix-sort-basic", "[radix-sort][sorting]") {
+  std::vector<int> v{11, -45, 98, 1, 11, -7, 0,
+                     std::numeric_limits<int>::min(),
+                     std::numeric_limits<int>::max()};
+  dragon::radix_sort(v.begin(), v.end());
+  REQUIRE_THAT(v, Equals(std::vector<int>{std::numeric_limits<int>::min(),
+                                          -45, -7, 0, 1, 11, 11, 98,
+                                          std::numeric_limits<int>::max()}));
+
+  std::vector<double> d{2.5, -0.0, -1e300, 3.0, -2.5, 1e-300, 0.0};
+  dragon::radix_sort(d.begin(), d.end());
+  REQUIRE(std::is_sorted(d.begin(), d.end()));
+  REQUIRE(d.front() == -1e300);
+  REQUIRE(d.back() == 3.0);
+
+  std::vector<unsigned char> c{200, 3, 255, 0, 3};
+  dragon::radix_sort(c.begin(), c.end());
+  REQUIRE_THAT(c, Equals(std::vector<unsigned char>{0, 3, 3, 200, 255}));
+
+  std::vector<int> empty;
+  dragon::radix_sort(empty.begin(), empty.end());
+  REQUIRE(empty.empty());
+}
+
+TEST_CASE("radix-sort-stable", "[radix-sort][sorting]") {
+  std::vector<std::pair<std::string, long long>> v = {
+      {"a", 3}, {"b", -1}, {"c", 3}, {"d", 1LL << 40}, {"e", -1}, {"f", 0}};
+  dragon::radix_sort(
+      v.begin(), v.end(),
+      [](const std::pair<std::string, long long>& p) { return p.second; });
+  std::vector<std::string> names;
+  for (const auto& p : v) {
+    names.push_back(p.first);
+  }
+  REQUIRE_THAT(names,
+               Equals(std::vector<std::string>{"b", "e", "f", "a", "c", "d"}));
+}
+
+TEST_CASE("radix-sort-random", "[radix-sort][sorting]") {
+  std::mt19937_64 rng(7);
+  std::vector<std::int64_t> v(10000);
+  for (auto& x : v) {
+    x = static_cast<std::int64_t>(rng());
+  }
+  std::vector<float> f(10000);
+  std::uniform_real_distribution<float> real(-1e6f, 1e6f);
+  for (auto& x : f) {
+    x = real(rng);
+  }
+  auto sorted_v = v;
+  auto sorted_f = f;
+  std::sort(sorted_v.begin(), sorted_v.end());
+  std::sort(sorted_f.begin(), sorted_f.end());
+  dragon::radix_sort(v.begin(), v.end());
+  dragon::radix_sort(f.begin(), f.end());
+  REQUIRE(v == sorted_v);
+  REQUIRE(f == sorted_f);
+}